@@ -0,0 +1,301 @@
+#include "dynamic_bvh.h"
+
+#include <algorithm>
+#include <cassert>
+
+namespace LM
+{
+    DynamicBVH::AABB DynamicBVH::AABB::Union(const AABB& other) const
+    {
+        AABB rtn;
+        for (int i = 0; i != 3; ++i)
+        {
+            rtn.min[i] = std::min(min[i], other.min[i]);
+            rtn.max[i] = std::max(max[i], other.max[i]);
+        }
+        return rtn;
+    }
+
+    double DynamicBVH::AABB::SurfaceArea() const
+    {
+        double dx = max[0] - min[0];
+        double dy = max[1] - min[1];
+        double dz = max[2] - min[2];
+        return 2 * (dx * dy + dy * dz + dz * dx);
+    }
+
+    bool DynamicBVH::AABB::Overlaps(const AABB& other) const
+    {
+        for (int i = 0; i != 3; ++i)
+        {
+            if (max[i] < other.min[i] || other.max[i] < min[i])
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    bool DynamicBVH::AABB::IntersectRay(const odr::Vec3D& origin, const odr::Vec3D& dir, double tMax) const
+    {
+        double tEnter = 0, tExit = tMax;
+        for (int i = 0; i != 3; ++i)
+        {
+            if (dir[i] == 0)
+            {
+                if (origin[i] < min[i] || origin[i] > max[i])
+                {
+                    return false;
+                }
+                continue;
+            }
+            double t1 = (min[i] - origin[i]) / dir[i];
+            double t2 = (max[i] - origin[i]) / dir[i];
+            if (t1 > t2)
+            {
+                std::swap(t1, t2);
+            }
+            tEnter = std::max(tEnter, t1);
+            tExit = std::min(tExit, t2);
+            if (tEnter > tExit)
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    int DynamicBVH::Insert(const AABB& box, uint32_t payload)
+    {
+        int leaf = Allocate();
+        nodes[leaf].box = box;
+        nodes[leaf].payload = payload;
+        nodes[leaf].left = Null;
+        nodes[leaf].right = Null;
+        nodes[leaf].height = 0;
+        ++leafCount;
+
+        if (root == Null)
+        {
+            root = leaf;
+            nodes[leaf].parent = Null;
+            return leaf;
+        }
+
+        int sibling = PickSibling(box);
+        int oldParent = nodes[sibling].parent;
+        int newParent = Allocate();
+        nodes[newParent].parent = oldParent;
+        nodes[newParent].left = sibling;
+        nodes[newParent].right = leaf;
+        nodes[sibling].parent = newParent;
+        nodes[leaf].parent = newParent;
+        UpdateNode(newParent);
+
+        if (oldParent == Null)
+        {
+            root = newParent;
+        }
+        else if (nodes[oldParent].left == sibling)
+        {
+            nodes[oldParent].left = newParent;
+        }
+        else
+        {
+            nodes[oldParent].right = newParent;
+        }
+
+        Refit(oldParent);
+        return leaf;
+    }
+
+    void DynamicBVH::Remove(int leaf)
+    {
+        assert(nodes[leaf].IsLeaf());
+        --leafCount;
+        if (leaf == root)
+        {
+            root = Null;
+            Free(leaf);
+            return;
+        }
+
+        int parent = nodes[leaf].parent;
+        int grandParent = nodes[parent].parent;
+        int sibling = nodes[parent].left == leaf ? nodes[parent].right : nodes[parent].left;
+        if (grandParent == Null)
+        {
+            root = sibling;
+            nodes[sibling].parent = Null;
+        }
+        else
+        {
+            if (nodes[grandParent].left == parent)
+            {
+                nodes[grandParent].left = sibling;
+            }
+            else
+            {
+                nodes[grandParent].right = sibling;
+            }
+            nodes[sibling].parent = grandParent;
+        }
+        Free(parent);
+        Free(leaf);
+        Refit(grandParent);
+    }
+
+    void DynamicBVH::Clear()
+    {
+        nodes.clear();
+        root = Null;
+        freeList = Null;
+        leafCount = 0;
+    }
+
+    int DynamicBVH::Height() const
+    {
+        return root == Null ? 0 : nodes[root].height;
+    }
+
+    int DynamicBVH::Allocate()
+    {
+        if (freeList == Null)
+        {
+            nodes.emplace_back();
+            return nodes.size() - 1;
+        }
+        int rtn = freeList;
+        freeList = nodes[rtn].parent;
+        return rtn;
+    }
+
+    void DynamicBVH::Free(int index)
+    {
+        nodes[index].parent = freeList;
+        nodes[index].height = -1;
+        freeList = index;
+    }
+
+    int DynamicBVH::PickSibling(const AABB& box) const
+    {
+        // Branch and bound: cost of a sibling = its enlarged area + enlargement of all its ancestors
+        const double leafArea = box.SurfaceArea();
+        int best = root;
+        double bestCost = box.Union(nodes[root].box).SurfaceArea();
+
+        std::vector<std::pair<int, double>> stack{ { root, 0.0 } };
+        while (!stack.empty())
+        {
+            auto index = stack.back().first;
+            auto inherited = stack.back().second;
+            stack.pop_back();
+
+            double direct = box.Union(nodes[index].box).SurfaceArea();
+            double cost = direct + inherited;
+            if (cost < bestCost)
+            {
+                bestCost = cost;
+                best = index;
+            }
+            if (nodes[index].IsLeaf())
+            {
+                continue;
+            }
+
+            double childInherited = inherited + direct - nodes[index].box.SurfaceArea();
+            if (leafArea + childInherited < bestCost)
+            {
+                stack.emplace_back(nodes[index].left, childInherited);
+                stack.emplace_back(nodes[index].right, childInherited);
+            }
+        }
+        return best;
+    }
+
+    void DynamicBVH::UpdateNode(int index)
+    {
+        auto& node = nodes[index];
+        node.box = nodes[node.left].box.Union(nodes[node.right].box);
+        node.height = 1 + std::max(nodes[node.left].height, nodes[node.right].height);
+    }
+
+    void DynamicBVH::Refit(int index)
+    {
+        while (index != Null)
+        {
+            UpdateNode(index);
+            Rotate(index);
+            index = nodes[index].parent;
+        }
+    }
+
+    void DynamicBVH::Rotate(int a)
+    {
+        if (nodes[a].height < 2)
+        {
+            return;
+        }
+        int b = nodes[a].left;
+        int c = nodes[a].right;
+
+        // Area change of the child that receives the swapped-in subtree
+        int bestShallow = Null, bestDeep = Null;
+        double bestDiff = 0;
+        auto consider = [&](int shallow, int other, int deep, int kept)
+        {
+            double diff = nodes[shallow].box.Union(nodes[kept].box).SurfaceArea() - nodes[other].box.SurfaceArea();
+            if (diff < bestDiff)
+            {
+                bestDiff = diff;
+                bestShallow = shallow;
+                bestDeep = deep;
+            }
+        };
+
+        if (!nodes[c].IsLeaf())
+        {
+            consider(b, c, nodes[c].left, nodes[c].right);
+            consider(b, c, nodes[c].right, nodes[c].left);
+        }
+        if (!nodes[b].IsLeaf())
+        {
+            consider(c, b, nodes[b].left, nodes[b].right);
+            consider(c, b, nodes[b].right, nodes[b].left);
+        }
+
+        if (bestShallow != Null)
+        {
+            SwapSubtrees(bestShallow, bestDeep);
+        }
+    }
+
+    void DynamicBVH::SwapSubtrees(int shallow, int deep)
+    {
+        int a = nodes[shallow].parent;
+        int p = nodes[deep].parent;
+        assert(nodes[p].parent == a);
+
+        if (nodes[a].left == shallow)
+        {
+            nodes[a].left = deep;
+        }
+        else
+        {
+            nodes[a].right = deep;
+        }
+        if (nodes[p].left == deep)
+        {
+            nodes[p].left = shallow;
+        }
+        else
+        {
+            nodes[p].right = shallow;
+        }
+        nodes[deep].parent = a;
+        nodes[shallow].parent = p;
+
+        UpdateNode(p);
+        UpdateNode(a);
+    }
+}
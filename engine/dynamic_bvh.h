@@ -0,0 +1,169 @@
+#pragma once
+
+#include "Math.hpp"
+
+#include <cstdint>
+#include <vector>
+
+namespace LM
+{
+    /*Bounding volume hierarchy that is updated in place.
+    * Insert picks the sibling with least SAH cost, Insert / Remove refit the path to root
+    * and rotate nodes on the way, so each update costs O(log n) instead of a rebuild.
+    */
+    class DynamicBVH
+    {
+    public:
+        struct AABB
+        {
+            odr::Vec3D min, max;
+
+            AABB Union(const AABB& other) const;
+
+            double SurfaceArea() const;
+
+            bool Overlaps(const AABB& other) const;
+
+            // Does ray origin + t * dir enter the box for some t in [0, tMax]
+            bool IntersectRay(const odr::Vec3D& origin, const odr::Vec3D& dir, double tMax) const;
+        };
+
+        // Returns handle for Remove
+        int Insert(const AABB& box, uint32_t payload);
+
+        void Remove(int leaf);
+
+        void Clear();
+
+        int Size() const { return leafCount; }
+
+        int Height() const;
+
+        // Bytes reserved for nodes
+        std::size_t MemoryUsage() const { return nodes.capacity() * sizeof(Node); }
+
+        /*Calls hit(payload, tMax) on leaves whose box the ray enters before tMax.
+        * hit can lower tMax to skip farther subtrees (closest hit query).
+        */
+        template<typename F>
+        void RayQuery(const odr::Vec3D& origin, const odr::Vec3D& dir, double tMax, F&& hit) const
+        {
+            if (root == Null)
+            {
+                return;
+            }
+            std::vector<int> stack{ root };
+            while (!stack.empty())
+            {
+                const Node& node = nodes[stack.back()];
+                stack.pop_back();
+                if (!node.box.IntersectRay(origin, dir, tMax))
+                {
+                    continue;
+                }
+                if (node.IsLeaf())
+                {
+                    hit(node.payload, tMax);
+                }
+                else
+                {
+                    stack.push_back(node.left);
+                    stack.push_back(node.right);
+                }
+            }
+        }
+
+        /*Calls hit(payload, queryIndex) for every leaf overlapping one of the query boxes.
+        * All queries share one traversal: a subtree is visited once, carrying the queries still overlapping it.
+        */
+        template<typename F>
+        void MultiBoxQuery(const std::vector<AABB>& queries, F&& hit) const
+        {
+            if (root == Null || queries.empty())
+            {
+                return;
+            }
+            // Frame covers active[begin, end). Popping a frame truncates active to its end,
+            // everything after belongs to finished subtrees.
+            struct Frame
+            {
+                int node;
+                std::size_t begin, end;
+            };
+            std::vector<int> active(queries.size());
+            for (int i = 0; i != queries.size(); ++i)
+            {
+                active[i] = i;
+            }
+            std::vector<Frame> stack{ Frame{ root, 0, queries.size() } };
+            while (!stack.empty())
+            {
+                auto frame = stack.back();
+                stack.pop_back();
+                active.resize(frame.end);
+
+                const Node& node = nodes[frame.node];
+                const auto begin = active.size();
+                for (auto i = frame.begin; i != frame.end; ++i)
+                {
+                    if (node.box.Overlaps(queries[active[i]]))
+                    {
+                        active.push_back(active[i]);
+                    }
+                }
+                const auto end = active.size();
+                if (begin == end)
+                {
+                    continue;
+                }
+                if (node.IsLeaf())
+                {
+                    for (auto i = begin; i != end; ++i)
+                    {
+                        hit(node.payload, active[i]);
+                    }
+                }
+                else
+                {
+                    stack.push_back(Frame{ node.right, begin, end });
+                    stack.push_back(Frame{ node.left, begin, end });
+                }
+            }
+        }
+
+    private:
+        static const int Null = -1;
+
+        struct Node
+        {
+            AABB box;
+            int parent, left, right; // parent doubles as next in free list
+            int height;
+            uint32_t payload;
+
+            bool IsLeaf() const { return left == Null; }
+        };
+
+        int Allocate();
+
+        void Free(int index);
+
+        int PickSibling(const AABB& box) const;
+
+        // Recompute box and height from children
+        void UpdateNode(int index);
+
+        // Update boxes from index up to root, rotating where it lowers SAH cost
+        void Refit(int index);
+
+        void Rotate(int index);
+
+        // shallow is a child of A; deep is a grandchild of A under its other child
+        void SwapSubtrees(int shallow, int deep);
+
+        std::vector<Node> nodes;
+        int root = Null;
+        int freeList = Null;
+        int leafCount = 0;
+    };
+}
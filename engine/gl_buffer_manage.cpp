@@ -14,6 +14,8 @@ namespace LM
         shader.m_uniformNames.append("worldToView");
         shader.m_uniformNames.append("objectInfo");
         m_vertexBufferCount = 0;
+        m_batching = false;
+        m_batchBegin = 0;
     }
 
     void GLBufferManage::Initialize()
@@ -61,6 +63,50 @@ namespace LM
         m_objectInfo.reset();
     }
 
+    void GLBufferManage::BeginBatch()
+    {
+        if (!m_batching)
+        {
+            m_batching = true;
+            m_batchBegin = m_vertexBufferCount;
+        }
+    }
+
+    void GLBufferManage::EndBatch()
+    {
+        if (!m_batching)
+        {
+            return;
+        }
+        m_batching = false;
+        if (m_batchBegin < m_vertexBufferCount)
+        {
+            UploadVertices(m_batchBegin);
+        }
+    }
+
+    void GLBufferManage::UploadVertices(unsigned int vertexBufferChangeBegin)
+    {
+        if (m_batching)
+        {
+            return;
+        }
+
+        m_vao.bind();
+        m_vbo.bind();
+
+        auto ptr_v = m_vbo.mapRange(vertexBufferChangeBegin * sizeof(Vertex),
+            (m_vertexBufferCount - vertexBufferChangeBegin) * sizeof(Vertex),
+            QOpenGLBuffer::RangeInvalidate | QOpenGLBuffer::RangeWrite);
+        assert(ptr_v != nullptr);
+        memcpy(ptr_v, m_vertexBufferData.data() + vertexBufferChangeBegin,
+            (m_vertexBufferCount - vertexBufferChangeBegin) * sizeof(Vertex));
+        m_vbo.unmap();
+
+        m_vbo.release();
+        m_vao.release();
+    }
+
     bool GLBufferManage::AddQuads(unsigned int gid, unsigned int objectID, const odr::Line3D& lBorder, const odr::Line3D& rBorder, QColor color)
     {
         assert(lBorder.size() == rBorder.size());
@@ -72,9 +118,6 @@ namespace LM
             return false;
         }
 
-        m_vao.bind();
-        m_vbo.bind();
-
         std::set<GLuint> vids;
         const auto vertexBufferChangeBegin = m_vertexBufferCount;
         for (int i = 0; i < lBorder.size() - 1; ++i)
@@ -102,16 +145,7 @@ namespace LM
             m_vertexBufferData[v23] = Vertex(QVector3D(r1[0], r1[1], r1[2]), color, gid, objectID);
             vids.emplace(v23);
         }
-        auto ptr_v = m_vbo.mapRange(vertexBufferChangeBegin * sizeof(Vertex),
-            (m_vertexBufferCount - vertexBufferChangeBegin) * sizeof(Vertex),
-            QOpenGLBuffer::RangeInvalidate | QOpenGLBuffer::RangeWrite);
-        assert(ptr_v != nullptr);
-        memcpy(ptr_v, m_vertexBufferData.data() + vertexBufferChangeBegin,
-            (m_vertexBufferCount - vertexBufferChangeBegin) * sizeof(Vertex));
-        m_vbo.unmap();
-
-        m_vbo.release();
-        m_vao.release();
+        UploadVertices(vertexBufferChangeBegin);
 
         idToVids.emplace(gid, vids);
 
@@ -119,18 +153,15 @@ namespace LM
         return true;
     }
 
-    bool GLBufferManage::AddPoly(unsigned int gid, unsigned int objectID, const odr::Line3D& boundary, QColor color)
+    bool GLBufferManage::AddPoly(unsigned int gid, unsigned int objectID, const odr::Line3D& boundary,
+        const std::vector<std::tuple<int, int, int>>& newTriangles, QColor color)
     {
-        auto newTriangles = Triangulate_2_5d(boundary);
         auto nNewVertex = newTriangles.size() * 3;
         if (m_vertexBufferCount + nNewVertex > m_vertexBufferData.size())
         {
             return false;
         }
 
-        m_vao.bind();
-        m_vbo.bind();
-
         std::set<GLuint> vids;
         const auto vertexBufferChangeBegin = m_vertexBufferCount;
         for (auto tri : newTriangles)
@@ -151,15 +182,7 @@ namespace LM
             m_vertexBufferData[v3] = Vertex(QVector3D(p3[0], p3[1], p3[2]), color, gid, objectID);
         }
 
-        auto ptr_v = m_vbo.mapRange(vertexBufferChangeBegin * sizeof(Vertex),
-            (m_vertexBufferCount - vertexBufferChangeBegin) * sizeof(Vertex),
-            QOpenGLBuffer::RangeInvalidate | QOpenGLBuffer::RangeWrite);
-        memcpy(ptr_v, m_vertexBufferData.data() + vertexBufferChangeBegin,
-            (m_vertexBufferCount - vertexBufferChangeBegin) * sizeof(Vertex));
-        m_vbo.unmap();
-
-        m_vbo.release();
-        m_vao.release();
+        UploadVertices(vertexBufferChangeBegin);
 
         idToVids.emplace(gid, vids);
 
@@ -176,9 +199,6 @@ namespace LM
             return false;
         }
 
-        m_vao.bind();
-        m_vbo.bind();
-
         std::set<GLuint> vids;
         const auto vertexBufferChangeBegin = m_vertexBufferCount;
         // Top & bottom
@@ -245,15 +265,7 @@ namespace LM
             m_vertexBufferData[v3_1] = Vertex(QVector3D(p4[0], p4[1], p4[2]), color, gid, objectID);
         }
 
-        auto ptr_v = m_vbo.mapRange(vertexBufferChangeBegin * sizeof(Vertex),
-            (m_vertexBufferCount - vertexBufferChangeBegin) * sizeof(Vertex),
-            QOpenGLBuffer::RangeInvalidate | QOpenGLBuffer::RangeWrite);
-        memcpy(ptr_v, m_vertexBufferData.data() + vertexBufferChangeBegin,
-            (m_vertexBufferCount - vertexBufferChangeBegin) * sizeof(Vertex));
-        m_vbo.unmap();
-
-        m_vbo.release();
-        m_vao.release();
+        UploadVertices(vertexBufferChangeBegin);
 
         idToVids.emplace(gid, vids);
 
@@ -326,6 +338,10 @@ namespace LM
             m_vertexBufferCount--;
         }
         idToVids.erase(gid);
+        if (m_batching)
+        {
+            m_batchBegin = std::min(m_batchBegin, m_vertexBufferCount);
+        }
 
         if (!Road::ClearingMap)
         {
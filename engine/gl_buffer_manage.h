@@ -6,6 +6,7 @@
 #include <QOpenGLTexture>
 #include <vector>
 #include <set>
+#include <tuple>
 #include <memory>
 
 #include "Math.hpp"
@@ -37,7 +38,8 @@ namespace LM
         void CleanupResources();
 
         bool AddQuads(unsigned int graphicsID, unsigned int objectID, const odr::Line3D& lBorder, const odr::Line3D& rBorder, QColor color);
-        bool AddPoly(unsigned int graphicsID, unsigned int objectID, const odr::Line3D& boundary, QColor color);
+        bool AddPoly(unsigned int graphicsID, unsigned int objectID, const odr::Line3D& boundary,
+            const std::vector<std::tuple<int, int, int>>& triangles, QColor color);
         bool AddColumn(unsigned int graphicsID, unsigned int objectID, const odr::Line3D& boundary, double h, QColor color);
         void UpdateItem(unsigned int objectID, uint8_t);
         uint8_t GetItemFlag(unsigned int objectID);
@@ -49,9 +51,17 @@ namespace LM
 
         int Useage_pct() const;
 
+        // Vertices added in between are sent to GPU with one write at EndBatch
+        void BeginBatch();
+        void EndBatch();
+
     private:
+        void UploadVertices(unsigned int changeBegin);
+
         std::vector<Vertex>          m_vertexBufferData;
         unsigned int                 m_vertexBufferCount;
+        bool                         m_batching;
+        unsigned int                 m_batchBegin;
 
         /*! Wraps an OpenGL VertexArrayObject, that references the vertex coordinates and color buffers. */
         QOpenGLVertexArrayObject    m_vao;
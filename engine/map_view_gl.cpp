@@ -7,6 +7,7 @@
 #include "main_widget.h"
 #include "id_generator.h"
 #include "spatial_indexer.h"
+#include "spatial_indexer_dynamic.h"
 #include "triangulation.h"
 #include "action_manager.h"
 #include "constants.h"
@@ -123,6 +124,12 @@ namespace LM
     }
 
     unsigned int MapViewGL::AddPoly(const odr::Line3D& boundary, QColor color, unsigned int objID)
+    {
+        return AddPoly(boundary, Triangulate_2_5d(boundary), color, objID);
+    }
+
+    unsigned int MapViewGL::AddPoly(const odr::Line3D& boundary, const std::vector<std::tuple<int, int, int>>& triangles,
+        QColor color, unsigned int objID)
     {
         bool temporary = objID == -1;
         auto gid = std::stoi(IDGenerator::ForType(temporary ? IDType::Graphics_Temporary : IDType::Graphics)
@@ -130,11 +137,11 @@ namespace LM
         bool success = true;
         if (temporary)
         {
-            success = temporaryBuffer->AddPoly(gid, objID, boundary, color);
+            success = temporaryBuffer->AddPoly(gid, objID, boundary, triangles, color);
         }
         else
         {
-            success = permanentBuffer->AddPoly(gid, objID, boundary, color);
+            success = permanentBuffer->AddPoly(gid, objID, boundary, triangles, color);
         }
         if (!success)
         {
@@ -184,6 +191,16 @@ namespace LM
         permanentBuffer->UpdateObjectID(graphicsID, objectID);
     }
 
+    void MapViewGL::BeginBatch()
+    {
+        permanentBuffer->BeginBatch();
+    }
+
+    void MapViewGL::EndBatch()
+    {
+        permanentBuffer->EndBatch();
+    }
+
     void MapViewGL::RemoveItem(unsigned int id, bool temporary)
     {
         if (!temporary)
@@ -258,6 +275,19 @@ namespace LM
         // Mind: to not use 0.0 for near plane, otherwise depth buffering and depth testing won't work!
     }
 
+    bool MapViewGL::event(QEvent* event)
+    {
+        if (event->type() == QEvent::UpdateRequest && FlushPendingHover())
+        {
+            // Measured after the frame with new highlight is drawn
+            auto rtn = OpenGLWindow::event(event);
+            auto latency = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - pendingHoverSince);
+            hoverLatency.Record(latency.count());
+            return rtn;
+        }
+        return OpenGLWindow::event(event);
+    }
+
     void MapViewGL::paintGL()
     {
         if (quitEventReceived)
@@ -287,6 +317,7 @@ namespace LM
 
     void MapViewGL::mousePressEvent(QMouseEvent* event)
     {
+        FlushPendingHover();
         bool ctrlPressed = event->modifiers() & Qt::CTRL;
         if (event->button() == Qt::RightButton && !ctrlPressed)
         {
@@ -307,6 +338,7 @@ namespace LM
 
     void MapViewGL::mouseDoubleClickEvent(QMouseEvent* evt)
     {
+        FlushPendingHover();
         if (evt->button() == Qt::LeftButton)
         {
             LM::ActionManager::Instance()->Record(evt);
@@ -316,7 +348,15 @@ namespace LM
 
     void MapViewGL::mouseMoveEvent(QMouseEvent* event)
     {
-        UpdateRayHit(event->pos());
+        // Drag pan needs ground position now; ray cast waits for next frame
+        UpdatePointerOnGround(event->pos());
+        if (!pendingHover.has_value())
+        {
+            pendingHoverSince = std::chrono::steady_clock::now();
+        }
+        pendingHover.emplace(event);
+        pendingHoverIsAction = false;
+        renderLater();
         
         bool changeViewPoint = true;
         if (dragRotFixedRay.has_value())
@@ -403,15 +443,14 @@ namespace LM
         }
         else
         {
-            LM::ActionManager::Instance()->Record(event);
-            emit(MousePerformedAction(event));
+            pendingHoverIsAction = true;
         }
-        renderLater();
         lastMousePos = event->pos();
     }
 
     void MapViewGL::mouseReleaseEvent(QMouseEvent* event)
     {
+        FlushPendingHover();
         if (dragRotFixedRay.has_value() || dragPan)
         {
             dragRotFixedRay.reset();
@@ -426,6 +465,7 @@ namespace LM
 
     void MapViewGL::wheelEvent(QWheelEvent* event)
     {
+        FlushPendingHover();
         bool ctrlPressed = event->modifiers() & Qt::CTRL;
         auto dir = event->angleDelta().y() > 0 ? 1 : -1;
 
@@ -447,6 +487,7 @@ namespace LM
 
     void MapViewGL::keyPressEvent(QKeyEvent* event)
     {
+        FlushPendingHover();
         bool changeViewPoint = false;
         
         auto flatForward = m_camera.forward().toVector2D();
@@ -545,15 +586,38 @@ namespace LM
         renderLater();
     }
 
+    void MapViewGL::UpdatePointerOnGround(QPoint screen)
+    {
+        auto currGroundPos = PointerOnGround(screen);
+        g_PointerOnGround[0] = currGroundPos.x();
+        g_PointerOnGround[1] = currGroundPos.y();
+    }
+
+    bool MapViewGL::FlushPendingHover()
+    {
+        if (!pendingHover.has_value())
+        {
+            return false;
+        }
+        auto action = pendingHover.value();
+        pendingHover.reset();
+
+        UpdateRayHit(QPoint(action.screenX, action.screenY));
+        if (pendingHoverIsAction)
+        {
+            LM::ActionManager::Instance()->Record(action);
+            emit(MousePerformedAction(action));
+        }
+        return true;
+    }
+
     void MapViewGL::UpdateRayHit(QPoint screen, bool fromReplay)
     {
         if (fromReplay)
         {
             lastMousePos = screen; // restore Zoom()
         }
-        auto currGroundPos = PointerOnGround(screen);
-        g_PointerOnGround[0] = currGroundPos.x();
-        g_PointerOnGround[1] = currGroundPos.y();
+        UpdatePointerOnGround(screen);
 
         auto rayDir = PointerDirection(screen);
         auto pointerRayDir = odr::Vec3D{ rayDir.x(), rayDir.y(), rayDir.z() };
@@ -584,6 +648,10 @@ namespace LM
             g_PointerRoadS = hitInfo.s;
             g_PointerLane = hitInfo.lane;
             auto hitRoad = IDGenerator::ForType(IDType::Road)->GetByID<Road>(g_PointerRoadID);
+            // Face only interpolates s along its chord. Exact s from ref line around it.
+            const double ProjectWindow = 5;
+            g_PointerRoadS = hitRoad->ProjectToRefLine(odr::Vec2D{ hitInfo.hitPos[0], hitInfo.hitPos[1] },
+                hitInfo.s - ProjectWindow, hitInfo.s + ProjectWindow)[0];
             hitRoad->EnableHighlight(true);
             if (hitRoad->generated.junction != "-1")
             {
@@ -5,9 +5,11 @@
 #include "Camera.h"
 #include "gl_buffer_manage.h"
 #include "action_defs.h"
+#include "stats.h"
 
 #include <qvector2d.h>
 #include <QMatrix4x4>
+#include <chrono>
 #include <optional>
 
 namespace LM
@@ -35,6 +37,9 @@ namespace LM
 		void UpdateObjectID(unsigned int graphicsID, unsigned int objectID);
 		uint8_t GetObjectFlag(unsigned int objectID);
 		void RemoveObject(unsigned int objectID);
+		// Permanent items added in between are sent to GPU at once
+		void BeginBatch();
+		void EndBatch();
 
 		void SetViewFromReplay(Transform3D t);
 		void UpdateRayHit(QPoint screen, bool fromReplay=false);
@@ -46,6 +51,7 @@ namespace LM
 		void KeyPerformedAction(LM::KeyPressAction);
 
 	protected:
+		bool event(QEvent* event) override;
 		void initializeGL() override;
 		void resizeGL(int width, int height) override;
 		void paintGL() override;
@@ -54,6 +60,8 @@ namespace LM
 		unsigned int AddQuads(const odr::Line3D& lBorder, const odr::Line3D& rBorder, QColor color, unsigned int objID = -1);
 		unsigned int AddLine(const odr::Line3D& border, double width, QColor color, unsigned int objID = -1);
 		unsigned int AddPoly(const odr::Line3D& boundary, QColor color, unsigned int objID = -1);
+		unsigned int AddPoly(const odr::Line3D& boundary, const std::vector<std::tuple<int, int, int>>& triangles,
+			QColor color, unsigned int objID = -1);
 		unsigned int AddColumn(const odr::Line3D& boundary, double h, QColor color, unsigned int objID = -1);
 		void RemoveItem(unsigned int graphicsID, bool temporary = false);
 
@@ -84,6 +92,14 @@ namespace LM
 		std::optional<QVector3D> dragRotFixedRay;
 		bool dragPan = false;
 
+		// Mouse moves between two frames are picked once, right before the frame is drawn
+		void UpdatePointerOnGround(QPoint screen);
+		bool FlushPendingHover();
+		std::optional<MouseAction> pendingHover;
+		bool pendingHoverIsAction = false; // otherwise a view drag, not sent to sessions
+		std::chrono::steady_clock::time_point pendingHoverSince;
+		LatencyHistogram hoverLatency{ "Hover pick latency" };
+
 		QVector3D PointerDirection(QPoint cursor) const;
 
 		QPointF PixelLocation(QVector3D globalDir) const;
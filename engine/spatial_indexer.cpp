@@ -1,5 +1,9 @@
 #include "spatial_indexer.h"
 
+#include <algorithm>
+#include <cassert>
+#include <limits>
+
 namespace LM
 {
     SpatialIndexer* SpatialIndexer::_instance = nullptr;
@@ -15,7 +19,12 @@ namespace LM
         return _instance;
     }
 
-    FaceIndex_t SpatialIndexer::Index(odr::Road road, odr::Lane lane, double sBegin, double sEnd)
+    FaceIndex_t SpatialIndexer::Index(const odr::Road& road, const odr::Lane& lane, double sBegin, double sEnd)
+    {
+        return Index(Prepare(road, lane, sBegin, sEnd));
+    }
+
+    PreparedQuad SpatialIndexer::Prepare(const odr::Road& road, const odr::Lane& lane, double sBegin, double sEnd)
     {
         bool magnetic = sBegin < 0 || sEnd > road.length;
         double t1 = lane.inner_border.get(sBegin);
@@ -34,27 +43,6 @@ namespace LM
         odr::Vec2D p4{ p4_3[0], p4_3[1] };
         double h34 = p3_3[2];
 
-        auto s1t1 = mesh.add_vertex(Point(p1[0], p1[1], h12));
-        auto s1t2 = mesh.add_vertex(Point(p2[0], p2[1], h12));
-        auto s2t1 = mesh.add_vertex(Point(p3[0], p3[1], h34));
-        auto s2t2 = mesh.add_vertex(Point(p4[0], p4[1], h34));
-        uint32_t face1ID = InvalidFace;
-        if (p1 != p2 && p1 != p3 && p2 != p3)
-        {
-            face1ID = mesh.add_face(s1t1, s1t2, s2t1);
-        }
-
-        uint32_t face2ID = InvalidFace;
-        if (p2 != p3 && p2 != p4 && p3 != p4)
-        {
-            face2ID = mesh.add_face(s2t1, s1t2, s2t2);
-        }
-        if (face2ID == face1ID)
-        {
-            // duplicated face
-            face2ID = InvalidFace;
-        }
-
         bool biDirRoad = road.rr_profile.HasSide(-1) && road.rr_profile.HasSide(1);
         int laneIDWhenReversed = -lane.id;
         if (biDirRoad)
@@ -70,151 +58,334 @@ namespace LM
             }
         }
 
-        Quad face{ road.id, lane.id, laneIDWhenReversed, sBegin, sEnd, p1, p3, magnetic };
+        Quad face{ 0, lane.id, laneIDWhenReversed, sBegin, sEnd, p1, p3, magnetic };
+        return PreparedQuad{ p1, p2, p3, p4, h12, h34, road.id, face };
+    }
+
+    FaceIndex_t SpatialIndexer::Index(const PreparedQuad& quad)
+    {
+        const auto& p1 = quad.p1;
+        const auto& p2 = quad.p2;
+        const auto& p3 = quad.p3;
+        const auto& p4 = quad.p4;
+
+        odr::Vec3D s1t1{ p1[0], p1[1], quad.h12 };
+        odr::Vec3D s1t2{ p2[0], p2[1], quad.h12 };
+        odr::Vec3D s2t1{ p3[0], p3[1], quad.h34 };
+        odr::Vec3D s2t2{ p4[0], p4[1], quad.h34 };
+
+        Quad info = quad.info;
+        info.roadIndex = InternRoadID(quad.roadID);
 
-        if (face1ID != InvalidFace)
+        uint32_t face1ID = InvalidFace;
+        if (p1 != p2 && p1 != p3 && p2 != p3)
         {
-            assert(faceInfo.find(face1ID) == faceInfo.end());
-            faceInfo.emplace(face1ID, face);
+            face1ID = IndexFace(s1t1, s1t2, s2t1, info);
         }
-        if (face2ID != InvalidFace)
+
+        uint32_t face2ID = InvalidFace;
+        if (p2 != p3 && p2 != p4 && p3 != p4)
         {
-            assert(faceInfo.find(face2ID) == faceInfo.end());
-            faceInfo.emplace(face2ID, face);
+            face2ID = IndexFace(s2t1, s1t2, s2t2, info);
+        }
+
+        if (face1ID != InvalidFace && face2ID != InvalidFace)
+        {
+            facePartner[face1ID] = face2ID;
+            facePartner[face2ID] = face1ID;
         }
 
         return (static_cast<FaceIndex_t>(face1ID) << 32) | face2ID;
     }
 
-    RayCastResult SpatialIndexer::RayCast(RayCastQuery ray)
+    uint32_t SpatialIndexer::IndexFace(const odr::Vec3D& p1, const odr::Vec3D& p2, const odr::Vec3D& p3, const Quad& info)
     {
-        RayCastResult rtn;
-        if (ray.direction[2] > -0.1 || ray.origin[2] < 0.1)
+        uint32_t faceID;
+        if (freeFaces.empty())
         {
-            return rtn;
+            faceID = faceInfo.size();
+            for (auto arr : { &v0x, &v0y, &v0z, &e1x, &e1y, &e1z, &e2x, &e2y, &e2z })
+            {
+                arr->push_back(0);
+            }
+            faceInfo.push_back(info);
+            faceLeaf.push_back(-1);
+            facePartner.push_back(InvalidFace);
+        }
+        else
+        {
+            faceID = freeFaces.back();
+            freeFaces.pop_back();
+            faceInfo[faceID] = info;
+            facePartner[faceID] = InvalidFace;
         }
 
-        Ray ray_query(Point(ray.origin[0], ray.origin[1], ray.origin[2]),
-            Vector(ray.direction[0], ray.direction[1], ray.direction[2]));
+        v0x[faceID] = p1[0]; v0y[faceID] = p1[1]; v0z[faceID] = p1[2];
+        e1x[faceID] = p2[0] - p1[0]; e1y[faceID] = p2[1] - p1[1]; e1z[faceID] = p2[2] - p1[2];
+        e2x[faceID] = p3[0] - p1[0]; e2y[faceID] = p3[1] - p1[1]; e2z[faceID] = p3[2] - p1[2];
 
-        Ray_intersection intersection = tree.first_intersection(ray_query, ray.skip);
-        if (intersection.has_value())
+        // Margin keeps hits on face edges from being culled by round-off
+        const double Margin = 1e-3;
+        DynamicBVH::AABB box;
+        for (int i = 0; i != 3; ++i)
         {
-            auto faceID = intersection->second.id();
-            auto info = faceInfo.at(faceID);
-            if (boost::get<Point>(&(intersection->first))) {
-                const Point* p = boost::get<Point>(&(intersection->first));
-                odr::Vec2D p2d{ p->x(), p->y() };
-                odr::Vec3D p3d{ p->x(), p->y(), p->z() };
-                auto dir = odr::normalize(odr::sub(info.pointOnSEnd, info.pointOnSBegin));
-                auto projLength = odr::dot(dir, odr::sub(p2d, info.pointOnSBegin));
-                auto quadLength = odr::euclDistance(info.pointOnSBegin, info.pointOnSEnd);
-                auto hitS = (projLength * info.sEnd + (quadLength - projLength) * info.sBegin) / quadLength;
-                return RayCastResult{ true, p3d, info.roadID, info.GetLaneID(), hitS };
-            }
+            box.min[i] = std::min({ p1[i], p2[i], p3[i] }) - Margin;
+            box.max[i] = std::max({ p1[i], p2[i], p3[i] }) + Margin;
         }
+        faceLeaf[faceID] = bvh.Insert(box, faceID);
+        return faceID;
+    }
 
-        return rtn;
+    void SpatialIndexer::UnIndexFace(uint32_t faceID)
+    {
+        assert(faceID < faceLeaf.size() && faceLeaf[faceID] != -1);
+        bvh.Remove(faceLeaf[faceID]);
+        faceLeaf[faceID] = -1;
+        if (faceID == lastHitFace)
+        {
+            lastHitFace = InvalidFace;
+        }
+        freeFaces.push_back(faceID);
     }
 
-    std::vector<RayCastResult> SpatialIndexer::AllOverlaps(odr::Vec3D origin, double zRange)
+    double SpatialIndexer::IntersectFace(uint32_t faceID, const odr::Vec3D& origin, const odr::Vec3D& dir) const
+    {
+        const double ex1 = e1x[faceID], ey1 = e1y[faceID], ez1 = e1z[faceID];
+        const double ex2 = e2x[faceID], ey2 = e2y[faceID], ez2 = e2z[faceID];
+
+        // p = dir x e2
+        const double px = dir[1] * ez2 - dir[2] * ey2;
+        const double py = dir[2] * ex2 - dir[0] * ez2;
+        const double pz = dir[0] * ey2 - dir[1] * ex2;
+        const double det = ex1 * px + ey1 * py + ez1 * pz;
+        if (std::abs(det) < 1e-12)
+        {
+            // Ray parallel to face
+            return -1;
+        }
+        const double invDet = 1 / det;
+
+        const double tx = origin[0] - v0x[faceID];
+        const double ty = origin[1] - v0y[faceID];
+        const double tz = origin[2] - v0z[faceID];
+        const double u = (tx * px + ty * py + tz * pz) * invDet;
+        if (u < 0 || u > 1)
+        {
+            return -1;
+        }
+
+        // q = t x e1
+        const double qx = ty * ez1 - tz * ey1;
+        const double qy = tz * ex1 - tx * ez1;
+        const double qz = tx * ey1 - ty * ex1;
+        const double v = (dir[0] * qx + dir[1] * qy + dir[2] * qz) * invDet;
+        if (v < 0 || u + v > 1)
+        {
+            return -1;
+        }
+
+        const double t = (ex2 * qx + ey2 * qy + ez2 * qz) * invDet;
+        return t >= 0 ? t : -1;
+    }
+
+    uint32_t SpatialIndexer::InternRoadID(const std::string& roadID)
     {
-        std::vector<RayCastResult> rtn;
+        // Look up first: emplace would build a node and copy the string for every face of a known road
+        auto existing = roadIDToIndex.find(roadID);
+        if (existing != roadIDToIndex.end())
+        {
+            return existing->second;
+        }
+        roadIDToIndex.emplace(roadID, roadIDs.size());
+        roadIDs.push_back(roadID);
+        return roadIDs.size() - 1;
+    }
 
-        Ray ray_query(Point(origin[0], origin[1], origin[2] + zRange), Vector(0, 0, -1));
-        std::list<Ray_intersection> intersections;
-        try
+    RayCastResult SpatialIndexer::HitResult(uint32_t faceID, const odr::Vec3D& p3d, bool clampS) const
+    {
+        const auto& info = faceInfo[faceID];
+        odr::Vec2D p2d{ p3d[0], p3d[1] };
+        auto dir = odr::normalize(odr::sub(info.pointOnSEnd, info.pointOnSBegin));
+        auto projLength = odr::dot(dir, odr::sub(p2d, info.pointOnSBegin));
+        auto quadLength = odr::euclDistance(info.pointOnSBegin, info.pointOnSEnd);
+        auto hitS = (projLength * info.sEnd + (quadLength - projLength) * info.sBegin) / quadLength;
+        if (clampS)
         {
-            tree.all_intersections(ray_query, std::back_inserter(intersections));
+            hitS = std::max(std::min(info.sBegin, info.sEnd), hitS);
+            hitS = std::min(std::max(info.sBegin, info.sEnd), hitS);
         }
-        catch (CGAL::Failure_exception)
+        return RayCastResult{ true, p3d, RoadID(info), info.GetLaneID(), hitS };
+    }
+
+    RayCastResult SpatialIndexer::RayCast(RayCastQuery ray)
+    {
+        RayCastResult rtn;
+        if (ray.direction[2] > -0.1 || ray.origin[2] < 0.1)
         {
             return rtn;
         }
-        for (auto intersection : intersections)
+
+        uint32_t closestFace = InvalidFace;
+        double closestT = std::numeric_limits<double>::infinity();
+
+        // Pointer moves little between queries, so it likely stays on the last hit quad.
+        // A hit there bounds the traversal below.
+        if (lastHitFace != InvalidFace)
         {
-            if (boost::get<Point>(&(intersection->first)))
+            for (auto faceID : { lastHitFace, facePartner[lastHitFace] })
             {
-                const Point* p = boost::get<Point>(&(intersection->first));
-                odr::Vec3D p3d{ p->x(), p->y(), p->z() };
-                if (odr::euclDistance(origin, p3d) > zRange)
+                if (faceID == InvalidFace || ray.skip(faceID))
                 {
                     continue;
                 }
-
-                auto faceID = intersection->second.id();
-                auto info = faceInfo.at(faceID);
-                if (info.magneticArea)
+                double t = IntersectFace(faceID, ray.origin, ray.direction);
+                if (t >= 0 && t < closestT)
                 {
-                    continue;
+                    closestT = t;
+                    closestFace = faceID;
                 }
-                odr::Vec2D p2d{ p->x(), p->y() };
-                auto dir = odr::normalize(odr::sub(info.pointOnSEnd, info.pointOnSBegin));
-                auto projLength = odr::dot(dir, odr::sub(p2d, info.pointOnSBegin));
-                auto quadLength = odr::euclDistance(info.pointOnSBegin, info.pointOnSEnd);
-                auto hitS = (projLength * info.sEnd + (quadLength - projLength) * info.sBegin) / quadLength;
-                hitS = std::max(std::min(info.sBegin, info.sEnd), hitS);
-                hitS = std::min(std::max(info.sBegin, info.sEnd), hitS);
-                RayCastResult result{ true, p3d, info.roadID, info.GetLaneID(), hitS };
-                rtn.emplace_back(result);
             }
         }
+
+        bvh.RayQuery(ray.origin, ray.direction, closestT,
+            [&](uint32_t faceID, double& tMax)
+            {
+                if (ray.skip(faceID))
+                {
+                    return;
+                }
+                double t = IntersectFace(faceID, ray.origin, ray.direction);
+                if (t >= 0 && t < tMax)
+                {
+                    tMax = t;
+                    closestT = t;
+                    closestFace = faceID;
+                }
+            });
+
+        lastHitFace = closestFace;
+        if (closestFace != InvalidFace)
+        {
+            return HitResult(closestFace, odr::add(ray.origin, odr::mut(closestT, ray.direction)), false);
+        }
         return rtn;
     }
 
-    void SpatialIndexer::UnIndex(FaceIndex_t index)
+    std::vector<RayCastResult> SpatialIndexer::AllOverlaps(odr::Vec3D origin, double zRange)
     {
-        uint32_t face1ID = index >> 32;
-        uint32_t face2ID = index & 0xffffffff;
-        
-        std::set<CGAL::SM_Vertex_index> vertex;
+        return AllOverlaps(std::vector<odr::Vec3D>{ origin }, zRange).front();
+    }
+
+    std::vector<std::vector<RayCastResult>> SpatialIndexer::AllOverlaps(const std::vector<odr::Vec3D>& origins, double zRange)
+    {
+        std::vector<std::vector<RayCastResult>> rtn(origins.size());
 
-        if (face1ID != InvalidFace)
+        // Group consecutive points, so that each group box stays tight along a curved road
+        const std::size_t GroupSize = 8;
+        std::vector<DynamicBVH::AABB> groups;
+        for (std::size_t begin = 0; begin < origins.size(); begin += GroupSize)
         {
-            face_descriptor f1(face1ID);
-            CGAL::Vertex_around_face_iterator<Mesh> vbegin, vend;
-            for (boost::tie(vbegin, vend) = vertices_around_face(mesh.halfedge(f1), mesh);
-                vbegin != vend; ++vbegin) 
+            DynamicBVH::AABB box{ origins[begin], origins[begin] };
+            for (auto i = begin + 1; i < std::min(begin + GroupSize, origins.size()); ++i)
             {
-                vertex.emplace(*vbegin);
+                for (int k = 0; k != 3; ++k)
+                {
+                    box.min[k] = std::min(box.min[k], origins[i][k]);
+                    box.max[k] = std::max(box.max[k], origins[i][k]);
+                }
             }
-
-            auto nRemoved1 = faceInfo.erase(face1ID);
-            assert(nRemoved1 == 1);
-            mesh.remove_face(static_cast<face_descriptor>(face1ID));
+            box.min[2] -= zRange;
+            box.max[2] += zRange;
+            groups.push_back(box);
         }
 
-        if (face2ID != InvalidFace)
-        {
-            face_descriptor f2(face2ID);
-            CGAL::Vertex_around_face_iterator<Mesh> vbegin, vend;
-            for (boost::tie(vbegin, vend) = vertices_around_face(mesh.halfedge(f2), mesh);
-                vbegin != vend; ++vbegin)
+        bvh.MultiBoxQuery(groups, [&](uint32_t faceID, int group)
             {
-                vertex.emplace(*vbegin);
-            }
+                if (faceInfo[faceID].magneticArea)
+                {
+                    return;
+                }
+                const auto end = std::min(group * GroupSize + GroupSize, origins.size());
+                for (auto i = group * GroupSize; i < end; ++i)
+                {
+                    odr::Vec3D hitPos;
+                    if (VerticalHit(faceID, origins[i], zRange, hitPos))
+                    {
+                        rtn[i].emplace_back(HitResult(faceID, hitPos, true));
+                    }
+                }
+            });
+        return rtn;
+    }
 
-            auto nRemoved2 = faceInfo.erase(face2ID);
-            assert(nRemoved2 == 1);
-            mesh.remove_face(static_cast<face_descriptor>(face2ID));
+    bool SpatialIndexer::VerticalHit(uint32_t faceID, const odr::Vec3D& origin, double zRange, odr::Vec3D& hitPos) const
+    {
+        const odr::Vec3D rayOrigin{ origin[0], origin[1], origin[2] + zRange };
+        double t = IntersectFace(faceID, rayOrigin, odr::Vec3D{ 0, 0, -1 });
+        if (t < 0)
+        {
+            return false;
         }
-        
-        for (auto vID : vertex)
+        hitPos = odr::Vec3D{ rayOrigin[0], rayOrigin[1], rayOrigin[2] - t };
+        return odr::euclDistance(origin, hitPos) <= zRange;
+    }
+
+    void SpatialIndexer::UnIndex(FaceIndex_t index)
+    {
+        uint32_t face1ID = index >> 32;
+        uint32_t face2ID = index & 0xffffffff;
+        for (auto faceID : { face1ID, face2ID })
         {
-            mesh.remove_vertex(vID);
+            if (faceID != InvalidFace)
+            {
+                UnIndexFace(faceID);
+            }
         }
     }
 
-    void SpatialIndexer::RebuildTree()
+    void SpatialIndexer::UpdateFaces(FaceIndex_t index, const std::string& newRoadID, int mult, double shift)
     {
-        tree.clear();
-        tree.insert(faces(mesh).begin(), faces(mesh).end(), mesh);
+        uint32_t face1ID = index >> 32;
+        uint32_t face2ID = index & 0xffffffff;
+        auto roadIndex = InternRoadID(newRoadID);
+        for (auto faceID : { face1ID, face2ID })
+        {
+            if (faceID == InvalidFace) continue;
+            Quad& face = faceInfo[faceID];
+            face.roadIndex = roadIndex;
+            face.sBegin = face.sBegin * mult + shift;
+            face.sEnd = face.sEnd * mult + shift;
+        }
     }
 
     void SpatialIndexer::Clear()
     {
-        mesh.clear();
-        tree.clear();
+        for (auto arr : { &v0x, &v0y, &v0z, &e1x, &e1y, &e1z, &e2x, &e2y, &e2z })
+        {
+            arr->clear();
+        }
         faceInfo.clear();
+        faceLeaf.clear();
+        facePartner.clear();
+        freeFaces.clear();
+        roadIDs.clear();
+        roadIDToIndex.clear();
+        bvh.Clear();
+        lastHitFace = InvalidFace;
+    }
+
+    std::size_t SpatialIndexer::MemoryUsage() const
+    {
+        std::size_t rtn = bvh.MemoryUsage();
+        for (auto arr : { &v0x, &v0y, &v0z, &e1x, &e1y, &e1z, &e2x, &e2y, &e2z })
+        {
+            rtn += arr->capacity() * sizeof(double);
+        }
+        rtn += faceInfo.capacity() * sizeof(Quad);
+        rtn += faceLeaf.capacity() * sizeof(int);
+        rtn += facePartner.capacity() * sizeof(uint32_t);
+        rtn += freeFaces.capacity() * sizeof(uint32_t);
+        rtn += roadIDs.capacity() * sizeof(std::string);
+        return rtn;
     }
-}
\ No newline at end of file
+}
@@ -2,45 +2,25 @@
 
 #include "Road.h"
 #include "id_generator.h"
+#include "dynamic_bvh.h"
 
-#include <QMatrix4x4>
-#include <CGAL/Simple_cartesian.h>
-#include <CGAL/Surface_mesh.h>
-
-#include <CGAL/AABB_tree.h>
-#include <CGAL/AABB_traits.h>
-#include <CGAL/AABB_face_graph_triangle_primitive.h>
-#include <CGAL/Polygon_mesh_processing/compute_normal.h>
-#include <CGAL/Polygon_mesh_processing/orientation.h>
+#include <algorithm>
+#include <set>
+#include <string>
+#include <unordered_map>
+#include <vector>
 
 namespace
 {
-    typedef CGAL::Simple_cartesian<double> K;
-    typedef K::FT FT;
-    typedef K::Point_3 Point;
-    typedef K::Vector_3 Vector;
-    typedef K::Ray_3 Ray;
-    typedef K::Triangle_3 Triangle;
-
-    typedef CGAL::Surface_mesh<Point> Mesh;
-    typedef boost::graph_traits<Mesh>::face_descriptor face_descriptor;
-    typedef boost::graph_traits<Mesh>::halfedge_descriptor halfedge_descriptor;
-
-    typedef std::list<Triangle>::iterator Iterator;
-    typedef CGAL::AABB_face_graph_triangle_primitive<Mesh> Primitive;
-    typedef CGAL::AABB_traits<K, Primitive> Traits;
-    typedef CGAL::AABB_tree<Traits> Tree;
-    typedef boost::optional<Tree::Intersection_and_primitive_id<Ray>::Type> Ray_intersection;
-
     struct Quad
     {
-        std::string roadID;
-        const int laneIDNormal, laneIDReversed;
+        uint32_t roadIndex; // see SpatialIndexer::RoadID
+        int laneIDNormal, laneIDReversed;
         double sBegin, sEnd;
         odr::Vec2D pointOnSBegin, pointOnSEnd; // must be parallel to long side
         bool magneticArea;
 
-        int GetLaneID()
+        int GetLaneID() const
         {
             return sBegin < sEnd ? laneIDNormal : laneIDReversed;
         }
@@ -51,9 +31,18 @@ namespace LM
 {
     typedef uint64_t FaceIndex_t;
 
+    // Corners and info of one lane segment, computed before touching the index
+    struct PreparedQuad
+    {
+        odr::Vec2D p1, p2, p3, p4;
+        double h12, h34;
+        std::string roadID;
+        Quad info;
+    };
+
     struct RayCastSkip
     {
-        std::set<face_descriptor> fd;
+        std::vector<uint32_t> faces; // sorted
 
         RayCastSkip() = default;
 
@@ -63,14 +52,15 @@ namespace LM
             {
                 uint32_t face1ID = index >> 32;
                 uint32_t face2ID = index & 0xffffffff;
-                fd.emplace(face1ID);
-                fd.emplace(face2ID);
+                faces.push_back(face1ID);
+                faces.push_back(face2ID);
             }
+            std::sort(faces.begin(), faces.end());
         }
 
-        bool operator()(const face_descriptor& t) const
+        bool operator()(uint32_t faceID) const
         {
-            return fd.find(t) != fd.end();
+            return !faces.empty() && std::binary_search(faces.begin(), faces.end(), faceID);
         }
 
     };
@@ -97,47 +87,65 @@ namespace LM
     public:
         static SpatialIndexer* Instance();
 
-        FaceIndex_t Index(odr::Road road, odr::Lane lane, double sBegin, double sEnd);
+        FaceIndex_t Index(const odr::Road& road, const odr::Lane& lane, double sBegin, double sEnd);
+
+        // Thread-safe half of Index: only reads road
+        static PreparedQuad Prepare(const odr::Road& road, const odr::Lane& lane, double sBegin, double sEnd);
+
+        FaceIndex_t Index(const PreparedQuad& quad);
 
         RayCastResult RayCast(RayCastQuery ray);
 
         std::vector<RayCastResult> AllOverlaps(odr::Vec3D origin, double zRange = 0.01);
 
-        void UnIndex(FaceIndex_t index);
+        // AllOverlaps of many points in one index traversal. Result i belongs to origins[i].
+        std::vector<std::vector<RayCastResult>> AllOverlaps(const std::vector<odr::Vec3D>& origins, double zRange = 0.01);
 
-        void RebuildTree();
+        void UnIndex(FaceIndex_t index);
 
-        std::map<uint32_t, Quad> faceInfo;
+        // Faces move to another road, s mapped by s * mult + shift
+        void UpdateFaces(FaceIndex_t index, const std::string& newRoadID, int mult, double shift);
 
         static uint32_t InvalidFace;
 
         void Clear();
 
+        // Bytes reserved for faces and the BVH, road ID strings excluded
+        std::size_t MemoryUsage() const;
+
     private:
         static SpatialIndexer* _instance;
 
-        Mesh mesh;
+        uint32_t IndexFace(const odr::Vec3D& p1, const odr::Vec3D& p2, const odr::Vec3D& p3, const Quad& info);
 
-        Tree tree;
-    };
+        void UnIndexFace(uint32_t faceID);
 
-    class SpatialIndexerDynamic
-    {
-    public:
-        static SpatialIndexerDynamic* Instance();
+        // Möller-Trumbore, returns ray parameter or -1 if missed
+        double IntersectFace(uint32_t faceID, const odr::Vec3D& origin, const odr::Vec3D& dir) const;
 
-        // New or update
-        void Index(unsigned int id, QMatrix4x4 transform, QVector3D lwh);
+        uint32_t InternRoadID(const std::string& roadID);
 
-        // returns -1 if no intersection
-        unsigned int RayCast(odr::Vec3D origin, odr::Vec3D direction);
+        const std::string& RoadID(const Quad& info) const { return roadIDs[info.roadIndex]; }
 
-        void UnIndex(unsigned int id);
-    private:
-        static SpatialIndexerDynamic* _instance;
+        RayCastResult HitResult(uint32_t faceID, const odr::Vec3D& hitPos, bool clampS) const;
+
+        // Where a vertical ray through origin hits face, within zRange of origin
+        bool VerticalHit(uint32_t faceID, const odr::Vec3D& origin, double zRange, odr::Vec3D& hitPos) const;
+
+        // Flat per-face arrays, indexed by face ID. Triangles in SoA layout: v0 and two edges
+        std::vector<double> v0x, v0y, v0z, e1x, e1y, e1z, e2x, e2y, e2z;
+        std::vector<Quad> faceInfo;
+        std::vector<int> faceLeaf; // -1 if face ID is free
+        std::vector<uint32_t> facePartner; // other triangle of the same quad, or InvalidFace
+        std::vector<uint32_t> freeFaces;
 
-        std::map<unsigned int, std::vector<Triangle>> idToFaces;
+        std::vector<std::string> roadIDs;
+        std::unordered_map<std::string, uint32_t> roadIDToIndex;
 
-        static Point ToPoint_3(QVector3D v);
+        // No rebuild needed after edits
+        DynamicBVH bvh;
+
+        // Closest face of the previous RayCast. It and its partner are tested first by the next one.
+        uint32_t lastHitFace = InvalidFace;
     };
-}
\ No newline at end of file
+}
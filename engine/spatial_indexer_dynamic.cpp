@@ -1,4 +1,4 @@
-#include "spatial_indexer.h"
+#include "spatial_indexer_dynamic.h"
 
 namespace LM
 {
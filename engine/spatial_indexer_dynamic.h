@@ -0,0 +1,42 @@
+#pragma once
+
+#include "Math.hpp"
+
+#include <QMatrix4x4>
+#include <CGAL/Simple_cartesian.h>
+#include <CGAL/intersections.h>
+
+#include <map>
+#include <vector>
+
+namespace
+{
+    typedef CGAL::Simple_cartesian<double> K;
+    typedef K::Point_3 Point;
+    typedef K::Vector_3 Vector;
+    typedef K::Ray_3 Ray;
+    typedef K::Triangle_3 Triangle;
+}
+
+namespace LM
+{
+    class SpatialIndexerDynamic
+    {
+    public:
+        static SpatialIndexerDynamic* Instance();
+
+        // New or update
+        void Index(unsigned int id, QMatrix4x4 transform, QVector3D lwh);
+
+        // returns -1 if no intersection
+        unsigned int RayCast(odr::Vec3D origin, odr::Vec3D direction);
+
+        void UnIndex(unsigned int id);
+    private:
+        static SpatialIndexerDynamic* _instance;
+
+        std::map<unsigned int, std::vector<Triangle>> idToFaces;
+
+        static Point ToPoint_3(QVector3D v);
+    };
+}
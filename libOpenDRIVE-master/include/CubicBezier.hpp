@@ -2,11 +2,12 @@
 #include "Math.hpp"
 #include "Utils.hpp"
 
+#include <algorithm>
 #include <array>
 #include <cmath>
-#include <map>
 #include <set>
 #include <sstream>
+#include <vector>
 
 namespace odr
 {
@@ -69,32 +70,73 @@ struct CubicBezier
         return coefficients;
     }
 
-    T valid_length;
+    T valid_length; // get_t maps [0, valid_length] onto the whole curve
 
     std::array<Vec<T, Dim>, 4> control_points;
-    std::map<T, T>             arclen_t;
+    /* arc length, dt/ds and d2t/ds2 at t = i / (size - 1) */
+    std::vector<T>             arclen_table;
+    std::vector<T>             dt_ds_table;
+    std::vector<T>             d2t_ds2_table;
+    /* per segment: quintic Hermite misses the arc length by more than HermiteTolerance, polish with Newton */
+    std::vector<bool>          newton_table;
     static const double        LengthTolerance;
+    static const double        HermiteTolerance;
+
+private:
+    T get_speed(const T t) const;
+    T get_arclen_between(const T t_start, const T t_end) const;
+    T get_hermite_t(const std::size_t idx, const T u) const;
 };
 
 template<typename T, std::size_t Dim>
 CubicBezier<T, Dim>::CubicBezier(std::array<Vec<T, Dim>, 4> control_points) : control_points(control_points)
 {
-    const std::set<T> t_vals = this->approximate_linear(this->LengthTolerance);
-    if (t_vals.size() < 2)
-        throw std::runtime_error("expected at least two t values");
+    /* control polygon is no shorter than the curve; about one node every 2m */
+    T polygon_length(0);
+    for (std::size_t i = 1; i < 4; i++)
+        polygon_length += euclDistance(control_points[i], control_points[i - 1]);
+    const std::size_t n_segments = std::min<std::size_t>(std::max<std::size_t>(std::ceil(polygon_length / 2), 8), 1024);
+
+    this->arclen_table.resize(n_segments + 1);
+    this->dt_ds_table.resize(n_segments + 1);
+    this->d2t_ds2_table.resize(n_segments + 1);
+    this->arclen_table[0] = T(0);
+    for (std::size_t i = 0; i <= n_segments; i++)
+    {
+        const T t = T(i) / n_segments;
+        if (i != 0)
+            this->arclen_table[i] = this->arclen_table[i - 1] + this->get_arclen_between(T(i - 1) / n_segments, t);
 
-    arclen_t[T(0)] = T(0);
+        /* t'(s) = 1 / |B'|, t''(s) = -(B' . B'') / |B'|^4 */
+        T speed_sq(0), dot(0);
+        for (std::size_t dim = 0; dim < Dim; dim++)
+        {
+            const T d1 = 3 * (1 - t) * (1 - t) * (control_points[1][dim] - control_points[0][dim]) +
+                         6 * (1 - t) * t * (control_points[2][dim] - control_points[1][dim]) + 3 * t * t * (control_points[3][dim] - control_points[2][dim]);
+            const T d2 = 6 * (1 - t) * (control_points[2][dim] - 2 * control_points[1][dim] + control_points[0][dim]) +
+                         6 * t * (control_points[3][dim] - 2 * control_points[2][dim] + control_points[1][dim]);
+            speed_sq += d1 * d1;
+            dot += d1 * d2;
+        }
+        this->dt_ds_table[i] = speed_sq > 0 ? 1 / std::sqrt(speed_sq) : T(0);
+        this->d2t_ds2_table[i] = speed_sq > 0 ? -dot / (speed_sq * speed_sq) : T(0);
+    }
 
-    T arclen(0);
-    for (auto t_val_iter = std::next(t_vals.begin()); t_val_iter != t_vals.end(); t_val_iter++)
+    /* check the interpolant at each segment's midpoint, where the quintic Hermite error peaks; stopped nodes always need Newton */
+    this->newton_table.resize(n_segments);
+    for (std::size_t idx = 0; idx < n_segments; idx++)
     {
-        const Vec<T, Dim> pt_prev = this->get(*std::prev(t_val_iter));
-        const Vec<T, Dim> pt = this->get(*t_val_iter);
-        arclen += euclDistance(pt, pt_prev);
-        this->arclen_t[arclen] = *t_val_iter;
+        if (this->dt_ds_table[idx] == 0 || this->dt_ds_table[idx + 1] == 0)
+        {
+            this->newton_table[idx] = true;
+            continue;
+        }
+        const T seg_arc_len = this->arclen_table[idx + 1] - this->arclen_table[idx];
+        const T t_mid = this->get_hermite_t(idx, T(0.5));
+        this->newton_table[idx] = std::abs(this->get_arclen_between(T(idx) / n_segments, t_mid) - seg_arc_len / 2) > HermiteTolerance;
     }
 
-    this->valid_length = std::prev(this->arclen_t.end())->first;
+    this->valid_length = this->arclen_table.back();
 }
 
 template<typename T, std::size_t Dim>
@@ -115,29 +157,89 @@ T CubicBezier<T, Dim>::get_t(const T arclen) const
         throw std::runtime_error(string_format("arc length %.3f out of range; valid length: %.3f", arclen, this->valid_length));
     }
 
-    const T arclen_adj = std::min<T>(arclen, this->valid_length);
-
-    auto arclen_t_iter = this->arclen_t.upper_bound(arclen_adj);
-    if (arclen_t_iter != this->arclen_t.begin())
-        arclen_t_iter--;
+    const T length = this->arclen_table.back();
+    if (arclen >= this->valid_length || this->valid_length <= 0)
+        return arclen > 0 ? T(1) : T(0);
+    const T arclen_adj = arclen * (length / this->valid_length);
+
+    const std::size_t n_segments = this->arclen_table.size() - 1;
+    const std::size_t idx =
+        std::min<std::size_t>(std::upper_bound(this->arclen_table.begin(), this->arclen_table.end(), arclen_adj) - this->arclen_table.begin(),
+                              n_segments) -
+        1;
+    const T s0 = this->arclen_table[idx];
+    const T seg_arc_len = this->arclen_table[idx + 1] - s0;
+    const T t0 = T(idx) / n_segments;
+    const T t1 = T(idx + 1) / n_segments;
+    if (seg_arc_len <= 0)
+        return t0;
+
+    const T u = (arclen_adj - s0) / seg_arc_len;
+    T       t = std::min(std::max(this->get_hermite_t(idx, u), t0), t1);
+    if (!this->newton_table[idx])
+        return t;
+
+    /* one Newton step on s(t) - arclen_adj */
+    const T speed = this->get_speed(t);
+    if (speed > 0)
+        t = std::min(std::max(t - (s0 + this->get_arclen_between(t0, t) - arclen_adj) / speed, t0), t1);
+    return t;
+}
 
-    const T arcl_lower_bound = arclen_t_iter->first;
-    const T t_lower_bound = arclen_t_iter->second;
-    if (arclen_adj == arcl_lower_bound)
-        return t_lower_bound;
+template<typename T, std::size_t Dim>
+T CubicBezier<T, Dim>::get_hermite_t(const std::size_t idx, const T u) const
+{
+    /* quintic Hermite on (s, t) using dt/ds and d2t/ds2 at both nodes; secant slope where the curve stops */
+    const std::size_t n_segments = this->arclen_table.size() - 1;
+    const T           h = this->arclen_table[idx + 1] - this->arclen_table[idx];
+    const T           t0 = T(idx) / n_segments;
+    const T           seg_t_len = T(1) / n_segments;
+    const T           secant = seg_t_len / h;
+    const T           m0 = (this->dt_ds_table[idx] > 0 ? this->dt_ds_table[idx] : secant) * h;
+    const T           m1 = (this->dt_ds_table[idx + 1] > 0 ? this->dt_ds_table[idx + 1] : secant) * h;
+    const T           a0 = this->d2t_ds2_table[idx] * h * h;
+    const T           a1 = this->d2t_ds2_table[idx + 1] * h * h;
+
+    const T u2 = u * u;
+    const T u3 = u2 * u;
+    const T u4 = u3 * u;
+    const T u5 = u4 * u;
+    return t0 + (10 * u3 - 15 * u4 + 6 * u5) * seg_t_len + (u - 6 * u3 + 8 * u4 - 3 * u5) * m0 + (-4 * u3 + 7 * u4 - 3 * u5) * m1 +
+           (u2 - 3 * u3 + 3 * u4 - u5) / 2 * a0 + (u3 - 2 * u4 + u5) / 2 * a1;
+}
 
-    const T arcl_upper_bound = std::next(arclen_t_iter)->first;
-    const T t_upper_bound = std::next(arclen_t_iter)->second;
-    const T seg_arc_len = arcl_upper_bound - arcl_lower_bound;
-    const T seg_t_len = t_upper_bound - t_lower_bound;
+template<typename T, std::size_t Dim>
+T CubicBezier<T, Dim>::get_length() const
+{
+    return arclen_table.back();
+}
 
-    return t_lower_bound + ((arclen_adj - arcl_lower_bound) / seg_arc_len) * seg_t_len;
+template<typename T, std::size_t Dim>
+T CubicBezier<T, Dim>::get_speed(const T t) const
+{
+    T speed_sq(0);
+    for (std::size_t dim = 0; dim < Dim; dim++)
+    {
+        const T d = 3 * (1 - t) * (1 - t) * (control_points[1][dim] - control_points[0][dim]) +
+                    6 * (1 - t) * t * (control_points[2][dim] - control_points[1][dim]) + 3 * t * t * (control_points[3][dim] - control_points[2][dim]);
+        speed_sq += d * d;
+    }
+    return std::sqrt(speed_sq);
 }
 
 template<typename T, std::size_t Dim>
-T CubicBezier<T, Dim>::get_length() const
+T CubicBezier<T, Dim>::get_arclen_between(const T t_start, const T t_end) const
 {
-    return std::prev(arclen_t.end())->first;
+    /* 5-point Gauss-Legendre */
+    static const T nodes[5] = {T(0), T(-0.5384693101056831), T(0.5384693101056831), T(-0.9061798459386640), T(0.9061798459386640)};
+    static const T weights[5] = {T(0.5688888888888889), T(0.4786286704993665), T(0.4786286704993665), T(0.2369268850561891), T(0.2369268850561891)};
+
+    const T half = (t_end - t_start) / 2;
+    const T mid = (t_end + t_start) / 2;
+    T       arclen(0);
+    for (int i = 0; i < 5; i++)
+        arclen += weights[i] * this->get_speed(mid + half * nodes[i]);
+    return arclen * half;
 }
 
 template<typename T, std::size_t Dim>
@@ -230,6 +332,9 @@ std::set<T> CubicBezier<T, Dim>::approximate_linear(const T eps) const
 template<typename T, std::size_t Dim>
 const double CubicBezier<T, Dim>::LengthTolerance = 1e-2;
 
+template<typename T, std::size_t Dim>
+const double CubicBezier<T, Dim>::HermiteTolerance = 1e-6;
+
 typedef CubicBezier<double, 2> CubicBezier2D;
 typedef CubicBezier<double, 1> CubicBezier1D;
 
@@ -39,6 +39,8 @@ struct CubicSpline
 
     double get(double s, double default_val = 0.0, bool extend_start = true) const;
     double get_grad(double s, double default_val = 0.0, bool extend_start = true) const;
+    /* get and get_grad of n ascending values, walking the polys once; out or out_grad may be null */
+    void   get(const double* s, std::size_t n, double* out, double* out_grad) const;
     double get_max(double s_start, double s_end) const;
     double get_min(double s_start, double s_end) const;
     Poly3  get_poly(double s, bool extend_start = true) const;
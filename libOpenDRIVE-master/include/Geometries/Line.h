@@ -18,6 +18,7 @@ struct Line : public RoadGeometry
 
     Vec2D get_xy(double s) const override;
     Vec2D get_grad(double s) const override;
+    void  get_xy_grad(const double* s, std::size_t n, Vec2D* out_xy, Vec2D* out_grad) const override;
 
     std::set<double> approximate_linear(double eps) const override;
 };
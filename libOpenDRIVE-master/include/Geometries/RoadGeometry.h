@@ -2,6 +2,7 @@
 #include "Math.hpp"
 #include "XmlNode.h"
 
+#include <cstddef>
 #include <memory>
 #include <set>
 
@@ -25,6 +26,8 @@ struct RoadGeometry : public XmlNode
 
     virtual Vec2D get_xy(double s) const = 0;
     virtual Vec2D get_grad(double s) const = 0;
+    /* get_xy and get_grad of n values at once, sharing per-geometry work; out_xy or out_grad may be null */
+    virtual void get_xy_grad(const double* s, std::size_t n, Vec2D* out_xy, Vec2D* out_grad) const;
 
     virtual std::set<double> approximate_linear(double eps) const = 0;
 
@@ -32,4 +32,18 @@
  * @param t      tangent direction at s [rad]
  */
 
+#include <stddef.h>
+
 extern void odrSpiral(double s, double cDot, double* x, double* y, double* t);
+
+/**
+ * odrSpiral for n run-lengths at once
+ */
+extern void odrSpiral(const double* s, size_t n, double cDot, double* x, double* y, double* t);
+
+/**
+ * Fresnel integrals S(x) = int_0^x sin(pi/2 t^2), C(x) = int_0^x cos(pi/2 t^2)
+ * odrFresnel is table-driven for |x| < 8, within 1e-12 of the CEPHES evaluation odrFresnelCephes
+ */
+extern void odrFresnel(double x, double* s, double* c);
+extern void odrFresnelCephes(double x, double* s, double* c);
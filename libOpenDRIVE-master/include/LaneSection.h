@@ -19,8 +19,11 @@ struct LaneSection : public XmlNode
 
     std::vector<Lane> get_sorted_driving_lanes(int8_t side) const; // center to rim
 
-    int  get_lane_id(const double s, const double t) const;
-    Lane get_lane(const double s, const double t) const;
+    /* innermost / outermost lane of get_sorted_driving_lanes(side) without copying, nullptr if none */
+    const Lane* get_driving_lane(int8_t side, bool outermost) const;
+
+    int         get_lane_id(const double s, const double t) const;
+    const Lane& get_lane(const double s, const double t) const;
 
     std::string         road_id = "";
     double              s0 = 0;
@@ -7,13 +7,28 @@
 
 #include <pugixml/pugixml.hpp>
 
+#include <cstdint>
 #include <map>
+#include <set>
 #include <string>
 #include <vector>
 
 namespace odr
 {
 
+/* Serialized <road> and <junction> elements kept between exports. Ids marked dirty are re-encoded by the next export. */
+struct XodrFragmentCache
+{
+    std::map<std::string, std::string> road_fragments;
+    std::map<std::string, std::string> junction_fragments;
+    std::set<std::string>              dirty_roads;
+    std::set<std::string>              dirty_junctions;
+
+    void clear();
+    /* FNV-1a of the file export_file() last wrote from this cache, without reading it back */
+    uint64_t content_hash() const;
+};
+
 class OpenDriveMap
 {
 public:
@@ -28,6 +43,7 @@ public:
                  const bool         fix_spiral_edge_cases = true,
                  const bool         with_road_signals = true);
 
+    /* roads are parsed on num_threads workers; 0 uses hardware concurrency */
     bool LoadString(const std::string& xodr_file,
                     const bool         center_map = false,
                     const bool         with_road_objects = true,
@@ -35,7 +51,8 @@ public:
                     const bool         with_lane_height = true,
                     const bool         abs_z_for_for_local_road_obj_outline = false,
                     const bool         fix_spiral_edge_cases = true,
-                    const bool         with_road_signals = true);
+                    const bool         with_road_signals = true,
+                    const unsigned     num_threads = 0);
 
     bool Load(const std::string& xodr_file,
               const bool         center_map = false,
@@ -44,7 +61,8 @@ public:
               const bool         with_lane_height = true,
               const bool         abs_z_for_for_local_road_obj_outline = false,
               const bool         fix_spiral_edge_cases = true,
-              const bool         with_road_signals = true);
+              const bool         with_road_signals = true,
+              const unsigned     num_threads = 0);
 
     std::vector<Road>     get_roads() const;
     std::vector<Junction> get_junctions() const;
@@ -55,7 +73,10 @@ public:
     std::map<LaneKey, std::vector<std::pair<LaneKey, double>>> get_overlap_zones() const;
     double get_lanekey_length(LaneKey) const;
 
-    void export_file(const std::string& fpath) const; 
+    /* roads are serialized on num_threads workers; 0 uses hardware concurrency. false if the file could not be written */
+    bool export_file(const std::string& fpath, const unsigned num_threads = 0) const;
+    /* only re-encodes roads and junctions that are dirty or missing in cache */
+    bool export_file(const std::string& fpath, XodrFragmentCache& cache, const unsigned num_threads = 0) const;
 
     std::string        proj4 = "";
     double             x_offs = 0;
@@ -66,7 +87,18 @@ public:
     std::map<std::string, Junction> id_to_junction;
 
 private:
-    void roadNodeToXML(const odr::RoadLink& roadLink, pugi::xml_node& out) const;
+    Road parse_road(const pugi::xml_node& road_node,
+                    const std::string&     road_id,
+                    const bool             with_road_objects,
+                    const bool             with_lateral_profile,
+                    const bool             with_lane_height,
+                    const bool             abs_z_for_for_local_road_obj_outline,
+                    const bool             fix_spiral_edge_cases,
+                    const bool             with_road_signals,
+                    bool&                  supported) const;
+
+    std::string road_to_xml(const std::string& road_id, const Road& road) const;
+    std::string junction_to_xml(const Junction& junction) const;
 
 };
 
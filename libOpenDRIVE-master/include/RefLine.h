@@ -3,10 +3,13 @@
 #include "Geometries/RoadGeometry.h"
 #include "Math.hpp"
 
+#include <cstdint>
+#include <limits>
 #include <map>
 #include <memory>
 #include <set>
 #include <string>
+#include <vector>
 
 namespace odr
 {
@@ -33,11 +36,16 @@ struct RefLine
     RoadGeometry*       get_geometry(const double s);
 
     Vec3D            get_xyz(const double s, const double t=0) const;
+    /* get_xyz and get_grad of ascending s values with one walk over geometries and elevation */
+    void             get_xyz(const std::vector<double>& s_vals, Line3D& xyz_out, std::vector<Vec3D>* grad_out = nullptr) const;
     Vec2D            get_grad_xy(const double s) const;
     Vec3D            get_grad(const double s) const;
     double           get_hdg(const double s) const;
     Line3D           get_line(const double s_start, const double s_end, const double eps) const;
+    /* s of the nearest point; scans the line at 1m, cheaper than a RefLineIndex for a single point */
     double           match(const double x, const double y) const;
+    /* {s, t} of each point; builds one RefLineIndex for all */
+    std::vector<Vec2D> match(const std::vector<Vec2D>& xy) const;
     std::set<double> approximate_linear(const double eps, const double s_start, const double s_end) const;
 
     std::string road_id = "";
@@ -47,4 +55,34 @@ struct RefLine
     std::map<double, std::unique_ptr<RoadGeometry>> s0_to_geometry;
 };
 
+/* Nearest point on a ref line. Polyline segments in a box tree give the coarse nearest,
+   Newton on the exact geometry refines it. Refers to ref_line, rebuild once it changes. */
+struct RefLineIndex
+{
+    RefLineIndex(const RefLine& ref_line, const double eps = 0.1);
+
+    /* {s, t} of the nearest point with s in [s_min, s_max]; t positive to the left.
+       A window missing the ref line gives s_min clamped to [0, length]. */
+    Vec2D              project(const Vec2D& xy,
+                               const double s_min = -std::numeric_limits<double>::infinity(),
+                               const double s_max = std::numeric_limits<double>::infinity()) const;
+    std::vector<Vec2D> project(const std::vector<Vec2D>& xy) const;
+
+private:
+    struct Node
+    {
+        Vec2D         min, max;
+        std::uint32_t begin, end; // segments [begin, end)
+        std::int32_t  left, right;
+    };
+
+    std::int32_t build(const std::uint32_t begin, const std::uint32_t end);
+
+    const RefLine*     ref_line;
+    double             eps;
+    std::vector<double> s_vals;
+    std::vector<Vec2D>  pts;
+    std::vector<Node>   nodes;
+};
+
 } // namespace odr
\ No newline at end of file
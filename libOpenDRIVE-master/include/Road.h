@@ -87,7 +87,7 @@ public:
     std::vector<RoadSignal>  get_road_signals() const;
 
     double      get_lanesection_s0(const double s) const;
-    LaneSection get_lanesection(const double s) const;
+    const LaneSection& get_lanesection(const double s) const;
 
     double get_lanesection_end(const LaneSection& lanesection) const;
     double get_lanesection_end(const double lanesection_s0) const;
@@ -96,9 +96,13 @@ public:
 
     Vec2D get_xy(const double s, const double t = 0) const;
     Vec3D get_xyz(double s, const double t, const double h, Vec3D* e_s = nullptr, Vec3D* e_t = nullptr, Vec3D* e_h = nullptr) const;
+    /*ref_pt & ref_grad: ref_line.get_xyz(s) & ref_line.get_grad(s), e.g. from batched RefLine::get_xyz. s within [0, length]*/
+    Vec3D get_xyz(double s, const double t, const double h, const Vec3D& ref_pt, const Vec3D& ref_grad,
+        Vec3D* e_s = nullptr, Vec3D* e_t = nullptr, Vec3D* e_h = nullptr) const;
     Vec2D get_boundary_xy(int side, double s) const;
     Vec3D get_boundary_xyz(int side, double s) const;
     Vec3D get_surface_pt(double s, const double t, Vec3D* vn = nullptr) const;
+    Vec3D get_surface_pt(double s, const double t, const Vec3D& ref_pt, const Vec3D& ref_grad, Vec3D* vn = nullptr) const;
     /*Uniformly sample of (s,t) pairs with max interval (min density)*/
     std::vector<std::pair<double, double>> sample_st(double sBegin, double sEnd, double interval) const;
 
@@ -3,13 +3,16 @@
 
 #include <algorithm>
 #include <array>
+#include <atomic>
 #include <cmath>
+#include <exception>
 #include <functional>
 #include <map>
 #include <memory>
 #include <set>
 #include <stdexcept>
 #include <string>
+#include <thread>
 #include <type_traits>
 #include <vector>
 
@@ -363,4 +366,54 @@ bool snapToExistingKey(const std::set<K>& existingKeys, K& key, K limit)
     return false;
 }
 
+/* num_threads == 0 picks hardware concurrency; never more workers than jobs */
+inline std::size_t get_worker_count(const std::size_t num_jobs, const std::size_t num_threads)
+{
+    const std::size_t n = num_threads != 0 ? num_threads : std::max(1u, std::thread::hardware_concurrency());
+    return std::max<std::size_t>(1, std::min(n, num_jobs));
+}
+
+/* Calls fn(job, worker_id) for every job in [0, num_jobs), handed out dynamically to num_workers threads.
+   The first exception thrown by a job is rethrown once all workers stopped. */
+template<typename F>
+void parallel_for(const std::size_t num_jobs, std::size_t num_workers, F fn)
+{
+    num_workers = std::max<std::size_t>(1, num_workers);
+    std::atomic<std::size_t>        next_job(0);
+    std::vector<std::exception_ptr> worker_errors(num_workers);
+
+    auto worker = [&](const std::size_t worker_id)
+    {
+        try
+        {
+            for (std::size_t job = next_job++; job < num_jobs; job = next_job++)
+                fn(job, worker_id);
+        }
+        catch (...)
+        {
+            worker_errors[worker_id] = std::current_exception();
+            next_job = num_jobs;
+        }
+    };
+
+    if (num_workers == 1)
+    {
+        worker(0);
+    }
+    else
+    {
+        std::vector<std::thread> threads;
+        for (std::size_t worker_id = 0; worker_id < num_workers; worker_id++)
+            threads.emplace_back(worker, worker_id);
+        for (auto& thread : threads)
+            thread.join();
+    }
+
+    for (const auto& error : worker_errors)
+    {
+        if (error)
+            std::rethrow_exception(error);
+    }
+}
+
 } // namespace odr
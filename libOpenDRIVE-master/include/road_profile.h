@@ -52,6 +52,7 @@ namespace LM
     class LaneProfile
     {
         friend class odr::OpenDriveMap;
+        friend class MapSnapshot;
         friend class LTest::Validation;
     public:
         LaneProfile() = default;
@@ -30,6 +30,24 @@ Vec2D Arc::get_grad(double s) const
     return {{dx, dy}};
 }
 
+void Arc::get_xy_grad(const double* s, std::size_t n, Vec2D* out_xy, Vec2D* out_grad) const
+{
+    // Same as get_xy / get_grad, sharing one cos / sin of the heading at s
+    const double r = 1 / curvature;
+    const double cx = x0 - r * std::sin(hdg0);
+    const double cy = y0 + r * std::cos(hdg0);
+    for (std::size_t i = 0; i < n; i++)
+    {
+        const double hdg = hdg0 + (s[i] - s0) * curvature;
+        const double cos_hdg = std::cos(hdg);
+        const double sin_hdg = std::sin(hdg);
+        if (out_xy)
+            out_xy[i] = Vec2D{cx + r * sin_hdg, cy - r * cos_hdg};
+        if (out_grad)
+            out_grad[i] = Vec2D{cos_hdg, sin_hdg};
+    }
+}
+
 std::set<double> Arc::approximate_linear(double eps) const
 {
     // TODO: properly implement
@@ -138,6 +138,38 @@ double CubicSpline::get_grad(double s, double default_val, bool extend_start) co
     return poly.get_grad(s);
 }
 
+void CubicSpline::get(const double* s, std::size_t n, double* out, double* out_grad) const
+{
+    auto poly_iter = this->s0_to_poly.begin();
+    for (std::size_t i = 0; i < n; i++)
+    {
+        if (poly_iter == this->s0_to_poly.end())
+        {
+            if (out)
+                out[i] = 0;
+            if (out_grad)
+                out_grad[i] = 0;
+            continue;
+        }
+        if (s[i] < poly_iter->first && poly_iter != this->s0_to_poly.begin())
+        {
+            // not ascending, look up again
+            poly_iter = this->s0_to_poly.upper_bound(s[i]);
+            if (poly_iter != this->s0_to_poly.begin())
+                poly_iter--;
+        }
+        while (std::next(poly_iter) != this->s0_to_poly.end() && std::next(poly_iter)->first <= s[i])
+            poly_iter++;
+
+        const Poly3& poly = poly_iter->second;
+        const bool   valid = !poly.isnan();
+        if (out)
+            out[i] = valid ? poly.get(s[i]) : 0;
+        if (out_grad)
+            out_grad[i] = valid ? poly.get_grad(s[i]) : 0;
+    }
+}
+
 CubicSpline CubicSpline::negate() const
 {
     CubicSpline negated = *this;
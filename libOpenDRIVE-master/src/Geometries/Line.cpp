@@ -27,6 +27,19 @@ Vec2D Line::get_xy(double s) const
 
 Vec2D Line::get_grad(double s) const { return {{std::cos(hdg0), std::sin(hdg0)}}; }
 
+void Line::get_xy_grad(const double* s, std::size_t n, Vec2D* out_xy, Vec2D* out_grad) const
+{
+    const double cos_hdg = std::cos(hdg0);
+    const double sin_hdg = std::sin(hdg0);
+    for (std::size_t i = 0; i < n; i++)
+    {
+        if (out_xy)
+            out_xy[i] = Vec2D{cos_hdg * (s[i] - s0) + x0, sin_hdg * (s[i] - s0) + y0};
+        if (out_grad)
+            out_grad[i] = Vec2D{cos_hdg, sin_hdg};
+    }
+}
+
 std::set<double> Line::approximate_linear(double eps) const { return {s0, s0 + length}; }
 
 } // namespace odr
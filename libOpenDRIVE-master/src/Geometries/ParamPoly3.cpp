@@ -39,7 +39,6 @@ ParamPoly3::ParamPoly3(double s0,
     const std::array<Vec2D, 4> coefficients = {{{this->aU, this->aV}, {this->bU, this->bV}, {this->cU, this->cV}, {this->dU, this->dV}}};
     this->cubic_bezier = CubicBezier2D(CubicBezier2D::get_control_points(coefficients));
 
-    this->cubic_bezier.arclen_t[length] = 1.0;
     this->cubic_bezier.valid_length = length;
 }
 
@@ -55,7 +54,6 @@ ParamPoly3::ParamPoly3(double s0, odr::Vec2D p0, odr::Vec2D c1, odr::Vec2D c2, o
     auto       odr_p1 = odr::toLocal(p1, p0, startHdg);
     this->cubic_bezier = CubicBezier2D({odr_p0, odr_c1, odr_c2, odr_p1});
     length = cubic_bezier.get_length();
-    this->cubic_bezier.arclen_t[length] = 1.0;
     this->cubic_bezier.valid_length = length;
 
     auto coefficients = odr::CubicBezier2D::get_coefficients(cubic_bezier.control_points);
@@ -95,6 +93,27 @@ Vec2D ParamPoly3::get_grad(double s) const
     return {{dx, dy}};
 }
 
+void ParamPoly3::get_xy_grad(const double* s, std::size_t n, Vec2D* out_xy, Vec2D* out_grad) const
+{
+    // One arc length to parameter lookup per s serves both position and gradient
+    const double h1 = std::cos(hdg0);
+    const double h2 = std::sin(hdg0);
+    for (std::size_t i = 0; i < n; i++)
+    {
+        const double p = this->cubic_bezier.get_t(s[i] - s0);
+        if (out_xy)
+        {
+            const Vec2D pt = this->cubic_bezier.get(p);
+            out_xy[i] = Vec2D{h1 * pt[0] - h2 * pt[1] + x0, h2 * pt[0] + h1 * pt[1] + y0};
+        }
+        if (out_grad)
+        {
+            const Vec2D dxy = this->cubic_bezier.get_grad(p);
+            out_grad[i] = Vec2D{h1 * dxy[0] - h2 * dxy[1], h2 * dxy[0] + h1 * dxy[1]};
+        }
+    }
+}
+
 std::set<double> ParamPoly3::approximate_linear(double eps) const
 {
     std::set<double> p_vals = this->cubic_bezier.approximate_linear(eps);
@@ -133,7 +152,6 @@ void ParamPoly3::reverse()
     dV = coefficients[3][1];
 
     this->cubic_bezier = CubicBezier2D(revCtrlPoints);
-    this->cubic_bezier.arclen_t[length] = 1.0;
     this->cubic_bezier.valid_length = length;
 }
 
@@ -165,7 +183,6 @@ void ParamPoly3::trim(double l)
     dV = coefficients[3][1];
 
     this->cubic_bezier = CubicBezier2D(newCtrlPoints);
-    this->cubic_bezier.arclen_t[length] = 1.0;
     this->cubic_bezier.valid_length = length;
 }
 
@@ -206,7 +223,6 @@ void ParamPoly3::rebase(double s)
     dV = coefficients[3][1];
 
     this->cubic_bezier = CubicBezier2D(newCtrlPoints);
-    this->cubic_bezier.arclen_t[length] = 1.0;
     this->cubic_bezier.valid_length = length;
 }
 
@@ -9,6 +9,17 @@ RoadGeometry::RoadGeometry(double s0, double x0, double y0, double hdg0, double
 {
 }
 
+void RoadGeometry::get_xy_grad(const double* s, std::size_t n, Vec2D* out_xy, Vec2D* out_grad) const
+{
+    for (std::size_t i = 0; i < n; i++)
+    {
+        if (out_xy)
+            out_xy[i] = this->get_xy(s[i]);
+        if (out_grad)
+            out_grad[i] = this->get_grad(s[i]);
+    }
+}
+
 void RoadGeometry::reverse() 
 {
     const auto pos_end = get_xy(s0 + length);
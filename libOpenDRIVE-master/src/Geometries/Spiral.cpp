@@ -3,7 +3,9 @@
 #include "Geometries/Spiral/odrSpiral.h"
 #include "Math.hpp"
 
+#include <algorithm>
 #include <cmath>
+#include <limits>
 
 namespace odr
 {
@@ -41,13 +43,54 @@ Vec2D Spiral::get_grad(double s) const
     return {{dx, dy}};
 }
 
+void Spiral::get_xy_grad(const double* s, std::size_t n, Vec2D* out_xy, Vec2D* out_grad) const
+{
+    // One Fresnel evaluation per s serves both position and heading. Chunked through stack buffers to stay allocation free.
+    constexpr std::size_t chunk = 64;
+    double                s_spiral[chunk], xs_spiral[chunk], ys_spiral[chunk], as_spiral[chunk];
+
+    const double hdg = hdg0 - a0_spiral;
+    const double cos_hdg = std::cos(hdg);
+    const double sin_hdg = std::sin(hdg);
+    for (std::size_t begin = 0; begin < n; begin += chunk)
+    {
+        const std::size_t count = std::min(chunk, n - begin);
+        for (std::size_t i = 0; i < count; i++)
+            s_spiral[i] = s[begin + i] - s0 + s0_spiral;
+        odrSpiral(s_spiral, count, c_dot, xs_spiral, ys_spiral, as_spiral);
+
+        for (std::size_t i = 0; i < count; i++)
+        {
+            if (out_xy)
+            {
+                const double dx = xs_spiral[i] - x0_spiral;
+                const double dy = ys_spiral[i] - y0_spiral;
+                out_xy[begin + i] = Vec2D{cos_hdg * dx - sin_hdg * dy + x0, sin_hdg * dx + cos_hdg * dy + y0};
+            }
+            if (out_grad)
+                out_grad[begin + i] = Vec2D{std::cos(as_spiral[i] + hdg), std::sin(as_spiral[i] + hdg)};
+        }
+    }
+}
+
 std::set<double> Spiral::approximate_linear(double eps) const
 {
-    // TODO: properly implement
-    std::set<double> s_vals;
-    for (double s = s0; s < (s0 + length); s += (10 * eps))
+    // A chord of length l deviates from a curve with |curvature| <= k by at most k * l^2 / 8.
+    // Curvature is linear in s, so its maximum over a step is at one of the ends.
+    auto max_abs_curv = [this](double s1, double s2)
+    { return std::max(std::abs(curv_start + c_dot * (s1 - s0)), std::abs(curv_start + c_dot * (s2 - s0))); };
+    auto max_step = [eps](double k) { return k == 0 ? std::numeric_limits<double>::infinity() : std::sqrt(8 * eps / k); };
+
+    const double     s_end_geom = s0 + length;
+    std::set<double> s_vals{s0};
+    for (double s = s0; s < s_end_geom;)
+    {
+        // Guess from curvature at s, then bound by curvature over the guessed step. A shorter step can only see less curvature.
+        double step = std::min(s_end_geom - s, max_step(std::abs(curv_start + c_dot * (s - s0))));
+        step = std::min(step, max_step(max_abs_curv(s, s + step)));
+        s = s_end_geom - s - step < 1e-9 ? s_end_geom : s + step;
         s_vals.insert(s);
-    s_vals.insert(s0 + length);
+    }
 
     return s_vals;
 }
@@ -38,6 +38,7 @@
 #include <stdio.h>
 #define _USE_MATH_DEFINES
 #include <math.h>
+#include <stddef.h>
 
 /* ====== LOCAL VARIABLES ====== */
 
@@ -215,6 +216,107 @@ static void fresnel(double xxa, double* ssa, double* cca)
     *ssa = ss;
 }
 
+/* ====== TABLE-DRIVEN FRESNEL INTEGRALS ====== */
+
+/* Below FresnelTableMax, S(x) and C(x) are looked up from per-segment polynomials
+ * fitted to the CEPHES evaluation at Chebyshev nodes. Max deviation from CEPHES ~1e-13.
+ * Beyond, the asymptotic CEPHES branch is used as is. */
+static const int    FresnelTableDegree = 8;
+static const int    FresnelSegmentsPerUnit = 32;
+static const double FresnelTableMax = 8;
+static const int    FresnelSegments = (int)FresnelTableMax * FresnelSegmentsPerUnit;
+
+struct FresnelTable
+{
+    /* power basis in t in [-1, 1] over each segment */
+    double c[FresnelSegments][FresnelTableDegree + 1];
+    double s[FresnelSegments][FresnelTableDegree + 1];
+
+    FresnelTable()
+    {
+        const int N = FresnelTableDegree + 1;
+
+        /* Chebyshev polynomials T_i in power basis */
+        double T[N][N] = {};
+        T[0][0] = 1;
+        T[1][1] = 1;
+        for (int i = 2; i < N; i++)
+            for (int p = 0; p < N; p++)
+                T[i][p] = (p > 0 ? 2 * T[i - 1][p - 1] : 0) - T[i - 2][p];
+
+        for (int k = 0; k < FresnelSegments; k++)
+        {
+            const double mid = (k + 0.5) / FresnelSegmentsPerUnit;
+            const double half = 0.5 / FresnelSegmentsPerUnit;
+
+            double node_c[N], node_s[N];
+            for (int j = 0; j < N; j++)
+                fresnel(mid + half * cos(M_PI * (j + 0.5) / N), &node_s[j], &node_c[j]);
+
+            double cheb_c[N], cheb_s[N];
+            for (int i = 0; i < N; i++)
+            {
+                cheb_c[i] = 0;
+                cheb_s[i] = 0;
+                for (int j = 0; j < N; j++)
+                {
+                    const double w = cos(M_PI * i * (j + 0.5) / N) * (i == 0 ? 1.0 : 2.0) / N;
+                    cheb_c[i] += node_c[j] * w;
+                    cheb_s[i] += node_s[j] * w;
+                }
+            }
+
+            for (int p = 0; p < N; p++)
+            {
+                c[k][p] = 0;
+                s[k][p] = 0;
+                for (int i = 0; i < N; i++)
+                {
+                    c[k][p] += cheb_c[i] * T[i][p];
+                    s[k][p] += cheb_s[i] * T[i][p];
+                }
+            }
+        }
+    }
+};
+
+void odrFresnelCephes(double x, double* s, double* c) { fresnel(x, s, c); }
+
+void odrFresnel(double x, double* s, double* c)
+{
+    static const FresnelTable table;
+
+    const double ax = fabs(x);
+    if (!(ax < FresnelTableMax))
+    {
+        fresnel(x, s, c);
+        return;
+    }
+
+    const double y = ax * FresnelSegmentsPerUnit;
+    const int    k = (int)y;
+    const double t = 2 * (y - k) - 1;
+
+    const double* pc = table.c[k];
+    const double* ps = table.s[k];
+    double        cc = pc[FresnelTableDegree];
+    double        ss = ps[FresnelTableDegree];
+    for (int p = FresnelTableDegree - 1; p >= 0; p--)
+    {
+        cc = cc * t + pc[p];
+        ss = ss * t + ps[p];
+    }
+
+    if (x < 0.0)
+    {
+        cc = -cc;
+        ss = -ss;
+    }
+
+    *c = cc;
+    *s = ss;
+}
+
 /**
  * compute the actual "standard" spiral, starting with curvature 0
  * @param s      run-length along spiral
@@ -231,7 +333,7 @@ void odrSpiral(double s, double cDot, double* x, double* y, double* t)
     a = 1.0 / sqrt(fabs(cDot));
     a *= sqrt(M_PI);
 
-    fresnel(s / a, y, x);
+    odrFresnel(s / a, y, x);
 
     *x *= a;
     *y *= a;
@@ -241,3 +343,17 @@ void odrSpiral(double s, double cDot, double* x, double* y, double* t)
 
     *t = s * s * cDot * 0.5;
 }
+
+void odrSpiral(const double* s, size_t n, double cDot, double* x, double* y, double* t)
+{
+    const double a = sqrt(M_PI) / sqrt(fabs(cDot));
+    const double y_sign = cDot < 0.0 ? -1.0 : 1.0;
+
+    for (size_t i = 0; i < n; i++)
+    {
+        odrFresnel(s[i] / a, &y[i], &x[i]);
+        x[i] *= a;
+        y[i] *= a * y_sign;
+        t[i] = s[i] * s[i] * cDot * 0.5;
+    }
+}
@@ -12,14 +12,29 @@ std::vector<Lane> LaneSection::get_lanes() const { return get_map_values(this->i
 
 std::vector<Lane> LaneSection::get_sorted_driving_lanes(int8_t side) const
 {
-    int extremeID = side > 0 ? get_lanes().rbegin()->id : get_lanes().begin()->id;
+    int extremeID = side > 0 ? id_to_lane.rbegin()->first : id_to_lane.begin()->first;
 
     std::vector<Lane> rtn;
     for (int absolutedID = 1; absolutedID <= std::abs(extremeID); ++absolutedID) 
     {
-        odr::Lane l = id_to_lane.at(absolutedID * side);
+        const odr::Lane& l = id_to_lane.at(absolutedID * side);
         if (l.type != "driving") continue;
-        rtn.push_back(id_to_lane.at(absolutedID * side));
+        rtn.push_back(l);
+    }
+    return rtn;
+}
+
+const Lane* LaneSection::get_driving_lane(int8_t side, bool outermost) const
+{
+    int extremeID = side > 0 ? id_to_lane.rbegin()->first : id_to_lane.begin()->first;
+
+    const Lane* rtn = nullptr;
+    for (int absolutedID = 1; absolutedID <= std::abs(extremeID); ++absolutedID)
+    {
+        const odr::Lane& l = id_to_lane.at(absolutedID * side);
+        if (l.type != "driving") continue;
+        rtn = &l;
+        if (!outermost) break;
     }
     return rtn;
 }
@@ -29,23 +44,47 @@ int LaneSection::get_lane_id(const double s, const double t) const
     if (this->id_to_lane.at(0).outer_border.get(s) == t) // exactly on lane #0
         return 0;
 
-    std::map<double, int> outer_border_to_lane_id;
+    /* Lane whose outer border is the first at or above t (the topmost one if none);
+       for lanes at or right of center, the one below it unless t is exactly on the border.
+       Among equal borders, the lower lane id wins. Scans instead of building a sorted map, so it does not allocate. */
+    struct BorderLane
+    {
+        double t;
+        int    id;
+        bool   valid = false;
+    };
+    BorderLane at_or_above, below; // min border >= t; max border < t
     for (const auto& id_lane : id_to_lane)
     {
         const double outer_brdr_t = id_lane.second.outer_border.get(s);
-        outer_border_to_lane_id.insert({outer_brdr_t, id_lane.first});
+        if (outer_brdr_t >= t)
+        {
+            if (!at_or_above.valid || outer_brdr_t < at_or_above.t)
+                at_or_above = {outer_brdr_t, id_lane.first, true};
+        }
+        else if (!below.valid || outer_brdr_t > below.t)
+            below = {outer_brdr_t, id_lane.first, true};
     }
 
-    auto target_iter = outer_border_to_lane_id.lower_bound(t);
-    if (target_iter == outer_border_to_lane_id.end()) // past upper boundary
-        target_iter--;
+    BorderLane target = at_or_above, prev = below;
+    if (!target.valid) // past upper boundary
+    {
+        target = below;
+        prev = BorderLane{};
+        for (const auto& id_lane : id_to_lane)
+        {
+            const double outer_brdr_t = id_lane.second.outer_border.get(s);
+            if (outer_brdr_t < target.t && (!prev.valid || outer_brdr_t > prev.t))
+                prev = {outer_brdr_t, id_lane.first, true};
+        }
+    }
 
-    if (target_iter->second <= 0 && target_iter != outer_border_to_lane_id.begin() && t != target_iter->first)
-        target_iter--;
+    if (target.id <= 0 && prev.valid && t != target.t)
+        return prev.id;
 
-    return target_iter->second;
+    return target.id;
 }
 
-Lane LaneSection::get_lane(const double s, const double t) const { return this->id_to_lane.at(this->get_lane_id(s, t)); }
+const Lane& LaneSection::get_lane(const double s, const double t) const { return this->id_to_lane.at(this->get_lane_id(s, t)); }
 
-} // namespace odr
\ No newline at end of file
+} // namespace odr
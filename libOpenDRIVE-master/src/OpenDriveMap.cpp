@@ -86,7 +86,8 @@ bool OpenDriveMap::LoadString(const std::string& xodr_str,
           const bool         with_lane_height,
           const bool         abs_z_for_for_local_road_obj_outline,
           const bool         fix_spiral_edge_cases,
-          const bool         with_road_signals)
+          const bool         with_road_signals,
+          const unsigned     num_threads)
 {
     id_to_road.clear();
     id_to_junction.clear();
@@ -211,586 +212,640 @@ bool OpenDriveMap::LoadString(const std::string& xodr_str,
         }
     }
 
+    /* phase one: index road nodes, resolving duplicate ids in document order */
+    std::vector<std::pair<std::string, pugi::xml_node>> road_nodes;
+    std::set<std::string>                               road_ids;
     for (pugi::xml_node road_node : odr_node.children("road"))
     {
-        /* make road */
         std::string road_id = road_node.attribute("id").as_string("");
-        CHECK_AND_REPAIR(this->id_to_road.find(road_id) == this->id_to_road.end(),
+        CHECK_AND_REPAIR(road_ids.find(road_id) == road_ids.end(),
                          (std::string("road::id already exists - ") + road_id).c_str(),
                          road_id = road_id + std::string("_dup"));
+        road_ids.insert(road_id);
+        road_nodes.emplace_back(road_id, road_node);
+    }
 
-        std::string rule_str = std::string(road_node.attribute("rule").as_string("RHT"));
-        std::transform(rule_str.begin(), rule_str.end(), rule_str.begin(), [](unsigned char c) { return std::tolower(c); });
-        const bool is_left_hand_traffic = (rule_str == "lht");
+    /* phase two: roads only read their own node, so build them on workers into per-thread buffers */
+    struct ParsedRoad
+    {
+        std::size_t index;
+        Road        road;
+        bool        supported;
+    };
+    const std::size_t                    n_workers = get_worker_count(road_nodes.size(), num_threads);
+    std::vector<std::vector<ParsedRoad>> worker_buffers(n_workers);
+
+    parallel_for(road_nodes.size(),
+                 n_workers,
+                 [&](const std::size_t i, const std::size_t worker_id)
+                 {
+                     bool road_supported = true;
+                     Road road = parse_road(road_nodes[i].second,
+                                            road_nodes[i].first,
+                                            with_road_objects,
+                                            with_lateral_profile,
+                                            with_lane_height,
+                                            abs_z_for_for_local_road_obj_outline,
+                                            fix_spiral_edge_cases,
+                                            with_road_signals,
+                                            road_supported);
+                     worker_buffers[worker_id].push_back(ParsedRoad{i, std::move(road), road_supported});
+                 });
+
+    /* merge in document order so the result does not depend on scheduling */
+    std::vector<ParsedRoad*> parsed_roads(road_nodes.size(), nullptr);
+    for (auto& buffer : worker_buffers)
+    {
+        for (auto& parsed : buffer)
+            parsed_roads[parsed.index] = &parsed;
+    }
+    for (ParsedRoad* parsed : parsed_roads)
+    {
+        supported = supported && parsed->supported;
+        this->id_to_road.emplace(parsed->road.id, std::move(parsed->road));
+    }
 
-        Road& road = this->id_to_road
-                         .insert({road_id,
-                                  Road(road_id,
-                                       road_node.attribute("length").as_double(0.0),
-                                       road_node.attribute("junction").as_string(""),
-                                       road_node.attribute("name").as_string(""),
-                                       is_left_hand_traffic)})
-                         .first->second;
-        road.xml_node = road_node;
+    return supported;
+}
 
-        CHECK_AND_REPAIR(road.length >= 0, "road::length < 0", road.length = 0);
+Road OpenDriveMap::parse_road(const pugi::xml_node& road_node,
+                              const std::string&     road_id,
+                              const bool             with_road_objects,
+                              const bool             with_lateral_profile,
+                              const bool             with_lane_height,
+                              const bool             abs_z_for_for_local_road_obj_outline,
+                              const bool             fix_spiral_edge_cases,
+                              const bool             with_road_signals,
+                              bool&                  supported) const
+{
+    std::string rule_str = std::string(road_node.attribute("rule").as_string("RHT"));
+    std::transform(rule_str.begin(), rule_str.end(), rule_str.begin(), [](unsigned char c) { return std::tolower(c); });
+    const bool is_left_hand_traffic = (rule_str == "lht");
 
-        /* parse road links */
-        for (bool is_predecessor : {true, false})
-        {
-            pugi::xml_node road_link_node =
-                is_predecessor ? road_node.child("link").child("predecessor") : road_node.child("link").child("successor");
-            if (road_link_node)
-            {
-                RoadLink& link = is_predecessor ? road.predecessor : road.successor;
-                link.id = road_link_node.attribute("elementId").as_string("");
+    Road road(road_id,
+              road_node.attribute("length").as_double(0.0),
+              road_node.attribute("junction").as_string(""),
+              road_node.attribute("name").as_string(""),
+              is_left_hand_traffic);
+    road.xml_node = road_node;
 
-                std::string type_str = road_link_node.attribute("elementType").as_string("");
-                CHECK_AND_REPAIR(type_str == "road" || type_str == "junction",
-                                 "Road::Succ/Predecessor::Link::elementType invalid type",
-                                 type_str = "road"); // default to road
-                link.type = (type_str == "road") ? RoadLink::Type_Road : RoadLink::Type_Junction;
+    CHECK_AND_REPAIR(road.length >= 0, "road::length < 0", road.length = 0);
 
-                if (link.type == RoadLink::Type_Road)
-                {
-                    // junction connection has no contact point
-                    std::string contact_point_str = road_link_node.attribute("contactPoint").as_string("");
-                    CHECK_AND_REPAIR(contact_point_str == "start" || contact_point_str == "end",
-                                     "Road::Succ/Predecessor::Link::contactPoint invalid type",
-                                     contact_point_str = "start"); // default to start
-                    link.contact_point = (contact_point_str == "start") ? RoadLink::ContactPoint_Start : RoadLink::ContactPoint_End;
-                }
+    /* parse road links */
+    for (bool is_predecessor : {true, false})
+    {
+        pugi::xml_node road_link_node =
+            is_predecessor ? road_node.child("link").child("predecessor") : road_node.child("link").child("successor");
+        if (road_link_node)
+        {
+            RoadLink& link = is_predecessor ? road.predecessor : road.successor;
+            link.id = road_link_node.attribute("elementId").as_string("");
 
-                link.xml_node = road_link_node;
+            std::string type_str = road_link_node.attribute("elementType").as_string("");
+            CHECK_AND_REPAIR(type_str == "road" || type_str == "junction",
+                             "Road::Succ/Predecessor::Link::elementType invalid type",
+                             type_str = "road"); // default to road
+            link.type = (type_str == "road") ? RoadLink::Type_Road : RoadLink::Type_Junction;
+
+            if (link.type == RoadLink::Type_Road)
+            {
+                // junction connection has no contact point
+                std::string contact_point_str = road_link_node.attribute("contactPoint").as_string("");
+                CHECK_AND_REPAIR(contact_point_str == "start" || contact_point_str == "end",
+                                 "Road::Succ/Predecessor::Link::contactPoint invalid type",
+                                 contact_point_str = "start"); // default to start
+                link.contact_point = (contact_point_str == "start") ? RoadLink::ContactPoint_Start : RoadLink::ContactPoint_End;
             }
-        }
 
-        /* parse road neighbors */
-        for (pugi::xml_node road_neighbor_node : road_node.child("link").children("neighbor"))
-        {
-            const std::string road_neighbor_id = road_neighbor_node.attribute("elementId").as_string("");
-            const std::string road_neighbor_side = road_neighbor_node.attribute("side").as_string("");
-            const std::string road_neighbor_direction = road_neighbor_node.attribute("direction").as_string("");
-            RoadNeighbor      road_neighbor(road_neighbor_id, road_neighbor_side, road_neighbor_direction);
-            road_neighbor.xml_node = road_neighbor_node;
-            road.neighbors.push_back(road_neighbor);
+            link.xml_node = road_link_node;
         }
+    }
 
-        /* parse road type and speed */
-        for (pugi::xml_node road_type_node : road_node.children("type"))
-        {
-            double      s = road_type_node.attribute("s").as_double(0.0);
-            std::string type = road_type_node.attribute("type").as_string("");
+    /* parse road neighbors */
+    for (pugi::xml_node road_neighbor_node : road_node.child("link").children("neighbor"))
+    {
+        const std::string road_neighbor_id = road_neighbor_node.attribute("elementId").as_string("");
+        const std::string road_neighbor_side = road_neighbor_node.attribute("side").as_string("");
+        const std::string road_neighbor_direction = road_neighbor_node.attribute("direction").as_string("");
+        RoadNeighbor      road_neighbor(road_neighbor_id, road_neighbor_side, road_neighbor_direction);
+        road_neighbor.xml_node = road_neighbor_node;
+        road.neighbors.push_back(road_neighbor);
+    }
 
-            CHECK_AND_REPAIR(s >= 0, "road::type::s < 0", s = 0);
+    /* parse road type and speed */
+    for (pugi::xml_node road_type_node : road_node.children("type"))
+    {
+        double      s = road_type_node.attribute("s").as_double(0.0);
+        std::string type = road_type_node.attribute("type").as_string("");
 
-            road.s_to_type[s] = type;
-            if (pugi::xml_node node = road_type_node.child("speed"))
-            {
-                const std::string speed_record_max = node.attribute("max").as_string("");
-                const std::string speed_record_unit = node.attribute("unit").as_string("");
-                SpeedRecord       speed_record(speed_record_max, speed_record_unit);
-                speed_record.xml_node = node;
-                road.s_to_speed.insert({s, speed_record});
-            }
+        CHECK_AND_REPAIR(s >= 0, "road::type::s < 0", s = 0);
+
+        road.s_to_type[s] = type;
+        if (pugi::xml_node node = road_type_node.child("speed"))
+        {
+            const std::string speed_record_max = node.attribute("max").as_string("");
+            const std::string speed_record_unit = node.attribute("unit").as_string("");
+            SpeedRecord       speed_record(speed_record_max, speed_record_unit);
+            speed_record.xml_node = node;
+            road.s_to_speed.insert({s, speed_record});
         }
+    }
 
-        /* make ref_line - parse road geometries */
-        for (pugi::xml_node geometry_hdr_node : road_node.child("planView").children("geometry"))
+    /* make ref_line - parse road geometries */
+    for (pugi::xml_node geometry_hdr_node : road_node.child("planView").children("geometry"))
+    {
+        double s0 = geometry_hdr_node.attribute("s").as_double(0.0);
+        double x0 = geometry_hdr_node.attribute("x").as_double(0.0) - this->x_offs;
+        double y0 = geometry_hdr_node.attribute("y").as_double(0.0) - this->y_offs;
+        double hdg0 = geometry_hdr_node.attribute("hdg").as_double(0.0);
+        double length = geometry_hdr_node.attribute("length").as_double(0.0);
+
+        CHECK_AND_REPAIR(s0 >= 0, "road::planView::geometry::s < 0", s0 = 0);
+        CHECK_AND_REPAIR(length >= 0, "road::planView::geometry::length < 0", length = 0);
+
+        pugi::xml_node geometry_node = geometry_hdr_node.first_child();
+        std::string    geometry_type = geometry_node.name();
+        if (geometry_type == "line")
         {
-            double s0 = geometry_hdr_node.attribute("s").as_double(0.0);
-            double x0 = geometry_hdr_node.attribute("x").as_double(0.0) - this->x_offs;
-            double y0 = geometry_hdr_node.attribute("y").as_double(0.0) - this->y_offs;
-            double hdg0 = geometry_hdr_node.attribute("hdg").as_double(0.0);
-            double length = geometry_hdr_node.attribute("length").as_double(0.0);
-
-            CHECK_AND_REPAIR(s0 >= 0, "road::planView::geometry::s < 0", s0 = 0);
-            CHECK_AND_REPAIR(length >= 0, "road::planView::geometry::length < 0", length = 0);
-
-            pugi::xml_node geometry_node = geometry_hdr_node.first_child();
-            std::string    geometry_type = geometry_node.name();
-            if (geometry_type == "line")
+            road.ref_line.s0_to_geometry[s0] = std::make_unique<Line>(s0, x0, y0, hdg0, length);
+        }
+        else if (geometry_type == "spiral")
+        {
+            double curv_start = geometry_node.attribute("curvStart").as_double(0.0);
+            double curv_end = geometry_node.attribute("curvEnd").as_double(0.0);
+            if (!fix_spiral_edge_cases)
             {
-                road.ref_line.s0_to_geometry[s0] = std::make_unique<Line>(s0, x0, y0, hdg0, length);
+                road.ref_line.s0_to_geometry[s0] = std::make_unique<Spiral>(s0, x0, y0, hdg0, length, curv_start, curv_end);
             }
-            else if (geometry_type == "spiral")
+            else
             {
-                double curv_start = geometry_node.attribute("curvStart").as_double(0.0);
-                double curv_end = geometry_node.attribute("curvEnd").as_double(0.0);
-                if (!fix_spiral_edge_cases)
+                if (std::abs(curv_start) < 1e-6 && std::abs(curv_end) < 1e-6)
                 {
-                    road.ref_line.s0_to_geometry[s0] = std::make_unique<Spiral>(s0, x0, y0, hdg0, length, curv_start, curv_end);
+                    // In effect a line
+                    road.ref_line.s0_to_geometry[s0] = std::make_unique<Line>(s0, x0, y0, hdg0, length);
                 }
-                else
+                else if (std::abs(curv_end - curv_start) < 1e-6)
                 {
-                    if (std::abs(curv_start) < 1e-6 && std::abs(curv_end) < 1e-6)
-                    {
-                        // In effect a line
-                        road.ref_line.s0_to_geometry[s0] = std::make_unique<Line>(s0, x0, y0, hdg0, length);
-                    }
-                    else if (std::abs(curv_end - curv_start) < 1e-6)
-                    {
-                        // In effect an arc
-                        road.ref_line.s0_to_geometry[s0] = std::make_unique<Arc>(s0, x0, y0, hdg0, length, curv_start);
-                    }
-                    else
-                    {
-                        // True spiral
-                        road.ref_line.s0_to_geometry[s0] = std::make_unique<Spiral>(s0, x0, y0, hdg0, length, curv_start, curv_end);
-                    }
+                    // In effect an arc
+                    road.ref_line.s0_to_geometry[s0] = std::make_unique<Arc>(s0, x0, y0, hdg0, length, curv_start);
                 }
-            }
-            else if (geometry_type == "arc")
-            {
-                double curvature = geometry_node.attribute("curvature").as_double(0.0);
-                road.ref_line.s0_to_geometry[s0] = std::make_unique<Arc>(s0, x0, y0, hdg0, length, curvature);
-            }
-            else if (geometry_type == "paramPoly3")
-            {
-                double aU = geometry_node.attribute("aU").as_double(0.0);
-                double bU = geometry_node.attribute("bU").as_double(0.0);
-                double cU = geometry_node.attribute("cU").as_double(0.0);
-                double dU = geometry_node.attribute("dU").as_double(0.0);
-                double aV = geometry_node.attribute("aV").as_double(0.0);
-                double bV = geometry_node.attribute("bV").as_double(0.0);
-                double cV = geometry_node.attribute("cV").as_double(0.0);
-                double dV = geometry_node.attribute("dV").as_double(0.0);
-
-                bool pRange_normalized = true;
-                if (geometry_node.attribute("pRange") || geometry_hdr_node.attribute("pRange"))
+                else
                 {
-                    std::string pRange_str = geometry_node.attribute("pRange") ? geometry_node.attribute("pRange").as_string("")
-                                                                               : geometry_hdr_node.attribute("pRange").as_string("");
-                    std::transform(pRange_str.begin(), pRange_str.end(), pRange_str.begin(), [](unsigned char c) { return std::tolower(c); });
-                    if (pRange_str == "arclength")
-                        pRange_normalized = false;
+                    // True spiral
+                    road.ref_line.s0_to_geometry[s0] = std::make_unique<Spiral>(s0, x0, y0, hdg0, length, curv_start, curv_end);
                 }
-                road.ref_line.s0_to_geometry[s0] =
-                    std::make_unique<ParamPoly3>(s0, x0, y0, hdg0, length, aU, bU, cU, dU, aV, bV, cV, dV, pRange_normalized);
             }
-            else
+        }
+        else if (geometry_type == "arc")
+        {
+            double curvature = geometry_node.attribute("curvature").as_double(0.0);
+            road.ref_line.s0_to_geometry[s0] = std::make_unique<Arc>(s0, x0, y0, hdg0, length, curvature);
+        }
+        else if (geometry_type == "paramPoly3")
+        {
+            double aU = geometry_node.attribute("aU").as_double(0.0);
+            double bU = geometry_node.attribute("bU").as_double(0.0);
+            double cU = geometry_node.attribute("cU").as_double(0.0);
+            double dU = geometry_node.attribute("dU").as_double(0.0);
+            double aV = geometry_node.attribute("aV").as_double(0.0);
+            double bV = geometry_node.attribute("bV").as_double(0.0);
+            double cV = geometry_node.attribute("cV").as_double(0.0);
+            double dV = geometry_node.attribute("dV").as_double(0.0);
+
+            bool pRange_normalized = true;
+            if (geometry_node.attribute("pRange") || geometry_hdr_node.attribute("pRange"))
             {
-                printf("Could not parse %s\n", geometry_type.c_str());
-                continue;
+                std::string pRange_str = geometry_node.attribute("pRange") ? geometry_node.attribute("pRange").as_string("")
+                                                                           : geometry_hdr_node.attribute("pRange").as_string("");
+                std::transform(pRange_str.begin(), pRange_str.end(), pRange_str.begin(), [](unsigned char c) { return std::tolower(c); });
+                if (pRange_str == "arclength")
+                    pRange_normalized = false;
             }
-
-            road.ref_line.s0_to_geometry.at(s0)->xml_node = geometry_node;
+            road.ref_line.s0_to_geometry[s0] =
+                std::make_unique<ParamPoly3>(s0, x0, y0, hdg0, length, aU, bU, cU, dU, aV, bV, cV, dV, pRange_normalized);
+        }
+        else
+        {
+            printf("Could not parse %s\n", geometry_type.c_str());
+            continue;
         }
 
-        std::map<std::string /*x path query*/, CubicSpline&> cubic_spline_fields{{".//elevationProfile//elevation", road.ref_line.elevation_profile},
-                                                                                 {".//lanes//laneOffset", road.lane_offset}};
+        road.ref_line.s0_to_geometry.at(s0)->xml_node = geometry_node;
+    }
 
-        if (with_lateral_profile)
-            cubic_spline_fields.insert({".//lateralProfile//superelevation", road.superelevation});
+    std::map<std::string /*x path query*/, CubicSpline&> cubic_spline_fields{{".//elevationProfile//elevation", road.ref_line.elevation_profile},
+                                                                             {".//lanes//laneOffset", road.lane_offset}};
 
-        /* parse elevation profiles, lane offsets, superelevation */
-        for (auto entry : cubic_spline_fields)
-        {
-            /* handle splines not starting at s=0, assume value 0 until start */
-            entry.second.s0_to_poly[0.0] = Poly3(0.0, 0.0, 0.0, 0.0, 0.0);
+    if (with_lateral_profile)
+        cubic_spline_fields.insert({".//lateralProfile//superelevation", road.superelevation});
 
-            pugi::xpath_node_set nodes = road_node.select_nodes(entry.first.c_str());
-            for (pugi::xpath_node node : nodes)
-            {
-                double s0 = node.node().attribute("s").as_double(0.0);
-                double a = node.node().attribute("a").as_double(0.0);
-                double b = node.node().attribute("b").as_double(0.0);
-                double c = node.node().attribute("c").as_double(0.0);
-                double d = node.node().attribute("d").as_double(0.0);
+    /* parse elevation profiles, lane offsets, superelevation */
+    for (auto entry : cubic_spline_fields)
+    {
+        /* handle splines not starting at s=0, assume value 0 until start */
+        entry.second.s0_to_poly[0.0] = Poly3(0.0, 0.0, 0.0, 0.0, 0.0);
 
-                CHECK_AND_REPAIR(s0 >= 0, (entry.first + "::s < 0").c_str(), s0 = 0);
+        pugi::xpath_node_set nodes = road_node.select_nodes(entry.first.c_str());
+        for (pugi::xpath_node node : nodes)
+        {
+            double s0 = node.node().attribute("s").as_double(0.0);
+            double a = node.node().attribute("a").as_double(0.0);
+            double b = node.node().attribute("b").as_double(0.0);
+            double c = node.node().attribute("c").as_double(0.0);
+            double d = node.node().attribute("d").as_double(0.0);
 
-                entry.second.s0_to_poly[s0] = Poly3(s0, a, b, c, d);
-            }
+            CHECK_AND_REPAIR(s0 >= 0, (entry.first + "::s < 0").c_str(), s0 = 0);
+
+            entry.second.s0_to_poly[s0] = Poly3(s0, a, b, c, d);
         }
+    }
 
-        /* parse crossfall - has extra attribute side */
-        if (with_lateral_profile)
+    /* parse crossfall - has extra attribute side */
+    if (with_lateral_profile)
+    {
+        for (pugi::xml_node crossfall_node : road_node.child("lateralProfile").children("crossfall"))
         {
-            for (pugi::xml_node crossfall_node : road_node.child("lateralProfile").children("crossfall"))
-            {
-                double s0 = crossfall_node.attribute("s").as_double(0.0);
-                double a = crossfall_node.attribute("a").as_double(0.0);
-                double b = crossfall_node.attribute("b").as_double(0.0);
-                double c = crossfall_node.attribute("c").as_double(0.0);
-                double d = crossfall_node.attribute("d").as_double(0.0);
+            double s0 = crossfall_node.attribute("s").as_double(0.0);
+            double a = crossfall_node.attribute("a").as_double(0.0);
+            double b = crossfall_node.attribute("b").as_double(0.0);
+            double c = crossfall_node.attribute("c").as_double(0.0);
+            double d = crossfall_node.attribute("d").as_double(0.0);
 
-                CHECK_AND_REPAIR(s0 >= 0, "road::lateralProfile::crossfall::s < 0", s0 = 0);
+            CHECK_AND_REPAIR(s0 >= 0, "road::lateralProfile::crossfall::s < 0", s0 = 0);
 
-                Poly3 crossfall_poly(s0, a, b, c, d);
-                road.crossfall.s0_to_poly[s0] = crossfall_poly;
-                if (pugi::xml_attribute side = crossfall_node.attribute("side"))
-                {
-                    std::string side_str = side.as_string("");
-                    std::transform(side_str.begin(), side_str.end(), side_str.begin(), [](unsigned char c) { return std::tolower(c); });
-                    if (side_str == "left")
-                        road.crossfall.sides[s0] = Crossfall::Side_Left;
-                    else if (side_str == "right")
-                        road.crossfall.sides[s0] = Crossfall::Side_Right;
-                    else
-                        road.crossfall.sides[s0] = Crossfall::Side_Both;
-                }
-            }
-
-            /* check for lateralProfile shape - not implemented yet */
-            if (road_node.child("lateralProfile").child("shape"))
+            Poly3 crossfall_poly(s0, a, b, c, d);
+            road.crossfall.s0_to_poly[s0] = crossfall_poly;
+            if (pugi::xml_attribute side = crossfall_node.attribute("side"))
             {
-                printf("Lateral Profile Shape not supported\n");
+                std::string side_str = side.as_string("");
+                std::transform(side_str.begin(), side_str.end(), side_str.begin(), [](unsigned char c) { return std::tolower(c); });
+                if (side_str == "left")
+                    road.crossfall.sides[s0] = Crossfall::Side_Left;
+                else if (side_str == "right")
+                    road.crossfall.sides[s0] = Crossfall::Side_Right;
+                else
+                    road.crossfall.sides[s0] = Crossfall::Side_Both;
             }
         }
 
-        /* parse road lane sections and lanes */
-        for (pugi::xml_node lanesection_node : road_node.child("lanes").children("laneSection"))
+        /* check for lateralProfile shape - not implemented yet */
+        if (road_node.child("lateralProfile").child("shape"))
         {
-            const double s0 = lanesection_node.attribute("s").as_double(0.0);
-            LaneSection& lanesection = road.s_to_lanesection.insert({s0, LaneSection(road_id, s0)}).first->second;
-            lanesection.xml_node = lanesection_node;
+            printf("Lateral Profile Shape not supported\n");
+        }
+    }
+
+    /* parse road lane sections and lanes */
+    for (pugi::xml_node lanesection_node : road_node.child("lanes").children("laneSection"))
+    {
+        const double s0 = lanesection_node.attribute("s").as_double(0.0);
+        LaneSection& lanesection = road.s_to_lanesection.insert({s0, LaneSection(road_id, s0)}).first->second;
+        lanesection.xml_node = lanesection_node;
 
-            for (pugi::xpath_node lane_xpath_node : lanesection_node.select_nodes(".//lane"))
+        for (pugi::xpath_node lane_xpath_node : lanesection_node.select_nodes(".//lane"))
+        {
+            pugi::xml_node lane_node = lane_xpath_node.node();
+            const int      lane_id = lane_node.attribute("id").as_int(0);
+
+            Lane& lane =
+                lanesection.id_to_lane
+                    .insert({lane_id,
+                             Lane(road_id, s0, lane_id, lane_node.attribute("level").as_bool(false), lane_node.attribute("type").as_string(""))})
+                    .first->second;
+
+            if (pugi::xml_node node = lane_node.child("link").child("predecessor"))
+                lane.predecessor = node.attribute("id").as_int(0);
+            if (pugi::xml_node node = lane_node.child("link").child("successor"))
+                lane.successor = node.attribute("id").as_int(0);
+            lane.xml_node = lane_node;
+
+            for (pugi::xml_node lane_width_node : lane_node.children("width"))
             {
-                pugi::xml_node lane_node = lane_xpath_node.node();
-                const int      lane_id = lane_node.attribute("id").as_int(0);
-
-                Lane& lane =
-                    lanesection.id_to_lane
-                        .insert({lane_id,
-                                 Lane(road_id, s0, lane_id, lane_node.attribute("level").as_bool(false), lane_node.attribute("type").as_string(""))})
-                        .first->second;
-
-                if (pugi::xml_node node = lane_node.child("link").child("predecessor"))
-                    lane.predecessor = node.attribute("id").as_int(0);
-                if (pugi::xml_node node = lane_node.child("link").child("successor"))
-                    lane.successor = node.attribute("id").as_int(0);
-                lane.xml_node = lane_node;
-
-                for (pugi::xml_node lane_width_node : lane_node.children("width"))
-                {
-                    double s_offset = lane_width_node.attribute("sOffset").as_double(0.0);
-                    double a = lane_width_node.attribute("a").as_double(0.0);
-                    double b = lane_width_node.attribute("b").as_double(0.0);
-                    double c = lane_width_node.attribute("c").as_double(0.0);
-                    double d = lane_width_node.attribute("d").as_double(0.0);
-
-                    CHECK_AND_REPAIR(s_offset >= 0, "lane::width::sOffset < 0", s_offset = 0);
-                    lane.lane_width.s0_to_poly[s0 + s_offset] = Poly3(s0 + s_offset, a, b, c, d);
-                }
+                double s_offset = lane_width_node.attribute("sOffset").as_double(0.0);
+                double a = lane_width_node.attribute("a").as_double(0.0);
+                double b = lane_width_node.attribute("b").as_double(0.0);
+                double c = lane_width_node.attribute("c").as_double(0.0);
+                double d = lane_width_node.attribute("d").as_double(0.0);
+
+                CHECK_AND_REPAIR(s_offset >= 0, "lane::width::sOffset < 0", s_offset = 0);
+                lane.lane_width.s0_to_poly[s0 + s_offset] = Poly3(s0 + s_offset, a, b, c, d);
+            }
 
-                if (with_lane_height)
+            if (with_lane_height)
+            {
+                for (pugi::xml_node lane_height_node : lane_node.children("height"))
                 {
-                    for (pugi::xml_node lane_height_node : lane_node.children("height"))
-                    {
-                        double s_offset = lane_height_node.attribute("sOffset").as_double(0.0);
-                        double inner = lane_height_node.attribute("inner").as_double(0.0);
-                        double outer = lane_height_node.attribute("outer").as_double(0.0);
+                    double s_offset = lane_height_node.attribute("sOffset").as_double(0.0);
+                    double inner = lane_height_node.attribute("inner").as_double(0.0);
+                    double outer = lane_height_node.attribute("outer").as_double(0.0);
 
-                        CHECK_AND_REPAIR(s_offset >= 0, "lane::height::sOffset < 0", s_offset = 0);
-                        lane.s_to_height_offset.insert({s0 + s_offset, HeightOffset(inner, outer)});
-                    }
+                    CHECK_AND_REPAIR(s_offset >= 0, "lane::height::sOffset < 0", s_offset = 0);
+                    lane.s_to_height_offset.insert({s0 + s_offset, HeightOffset(inner, outer)});
                 }
+            }
 
-                for (pugi::xml_node roadmark_node : lane_node.children("roadMark"))
+            for (pugi::xml_node roadmark_node : lane_node.children("roadMark"))
+            {
+                RoadMarkGroup roadmark_group(road_id,
+                                             s0,
+                                             lane_id,
+                                             roadmark_node.attribute("width").as_double(-1),
+                                             roadmark_node.attribute("height").as_double(0),
+                                             roadmark_node.attribute("sOffset").as_double(0),
+                                             roadmark_node.attribute("type").as_string("none"),
+                                             roadmark_node.attribute("weight").as_string("standard"),
+                                             roadmark_node.attribute("color").as_string("standard"),
+                                             roadmark_node.attribute("material").as_string("standard"),
+                                             roadmark_node.attribute("laneChange").as_string("both"));
+                roadmark_group.xml_node = roadmark_node;
+
+                CHECK_AND_REPAIR(roadmark_group.s_offset >= 0, "lane::roadMark::sOffset < 0", roadmark_group.s_offset = 0);
+                const double roadmark_group_s0 = s0 + roadmark_group.s_offset;
+
+                if (pugi::xml_node roadmark_type_node = roadmark_node.child("type"))
                 {
-                    RoadMarkGroup roadmark_group(road_id,
-                                                 s0,
-                                                 lane_id,
-                                                 roadmark_node.attribute("width").as_double(-1),
-                                                 roadmark_node.attribute("height").as_double(0),
-                                                 roadmark_node.attribute("sOffset").as_double(0),
-                                                 roadmark_node.attribute("type").as_string("none"),
-                                                 roadmark_node.attribute("weight").as_string("standard"),
-                                                 roadmark_node.attribute("color").as_string("standard"),
-                                                 roadmark_node.attribute("material").as_string("standard"),
-                                                 roadmark_node.attribute("laneChange").as_string("both"));
-                    roadmark_group.xml_node = roadmark_node;
-
-                    CHECK_AND_REPAIR(roadmark_group.s_offset >= 0, "lane::roadMark::sOffset < 0", roadmark_group.s_offset = 0);
-                    const double roadmark_group_s0 = s0 + roadmark_group.s_offset;
-
-                    if (pugi::xml_node roadmark_type_node = roadmark_node.child("type"))
-                    {
-                        const std::string name = roadmark_type_node.attribute("name").as_string("");
-                        const double      line_width_1 = roadmark_type_node.attribute("width").as_double(-1);
+                    const std::string name = roadmark_type_node.attribute("name").as_string("");
+                    const double      line_width_1 = roadmark_type_node.attribute("width").as_double(-1);
 
-                        for (pugi::xml_node roadmarks_line_node : roadmark_type_node.children("line"))
-                        {
-                            const double line_width_0 = roadmarks_line_node.attribute("width").as_double(-1);
-                            const double roadmark_width = line_width_0 < 0 ? line_width_1 : line_width_0;
-
-                            RoadMarksLine roadmarks_line(road_id,
-                                                         s0,
-                                                         lane_id,
-                                                         roadmark_group_s0,
-                                                         roadmark_width,
-                                                         roadmarks_line_node.attribute("length").as_double(0),
-                                                         roadmarks_line_node.attribute("space").as_double(0),
-                                                         roadmarks_line_node.attribute("tOffset").as_double(0),
-                                                         roadmarks_line_node.attribute("sOffset").as_double(0),
-                                                         name,
-                                                         roadmarks_line_node.attribute("rule").as_string("none"));
-                            roadmarks_line.xml_node = roadmarks_line_node;
-
-                            CHECK_AND_REPAIR(roadmarks_line.length >= 0, "roadMark::type::line::length < 0", roadmarks_line.length = 0);
-                            CHECK_AND_REPAIR(roadmarks_line.space >= 0, "roadMark::type::line::space < 0", roadmarks_line.space = 0);
-                            CHECK_AND_REPAIR(roadmarks_line.s_offset >= 0, "roadMark::type::line::sOffset < 0", roadmarks_line.s_offset = 0);
-
-                            roadmark_group.roadmark_lines.emplace(std::move(roadmarks_line));
-                        }
+                    for (pugi::xml_node roadmarks_line_node : roadmark_type_node.children("line"))
+                    {
+                        const double line_width_0 = roadmarks_line_node.attribute("width").as_double(-1);
+                        const double roadmark_width = line_width_0 < 0 ? line_width_1 : line_width_0;
+
+                        RoadMarksLine roadmarks_line(road_id,
+                                                     s0,
+                                                     lane_id,
+                                                     roadmark_group_s0,
+                                                     roadmark_width,
+                                                     roadmarks_line_node.attribute("length").as_double(0),
+                                                     roadmarks_line_node.attribute("space").as_double(0),
+                                                     roadmarks_line_node.attribute("tOffset").as_double(0),
+                                                     roadmarks_line_node.attribute("sOffset").as_double(0),
+                                                     name,
+                                                     roadmarks_line_node.attribute("rule").as_string("none"));
+                        roadmarks_line.xml_node = roadmarks_line_node;
+
+                        CHECK_AND_REPAIR(roadmarks_line.length >= 0, "roadMark::type::line::length < 0", roadmarks_line.length = 0);
+                        CHECK_AND_REPAIR(roadmarks_line.space >= 0, "roadMark::type::line::space < 0", roadmarks_line.space = 0);
+                        CHECK_AND_REPAIR(roadmarks_line.s_offset >= 0, "roadMark::type::line::sOffset < 0", roadmarks_line.s_offset = 0);
+
+                        roadmark_group.roadmark_lines.emplace(std::move(roadmarks_line));
                     }
-
-                    lane.roadmark_groups.emplace(std::move(roadmark_group));
                 }
-            }
 
-            /* derive lane borders from lane widths */
-            auto id_lane_iter0 = lanesection.id_to_lane.find(0);
-            if (id_lane_iter0 == lanesection.id_to_lane.end())
-                throw std::runtime_error("lane section does not have lane #0");
-
-            /* iterate from id #0 towards +inf */
-            auto id_lane_iter1 = std::next(id_lane_iter0);
-            for (auto iter = id_lane_iter1; iter != lanesection.id_to_lane.end(); iter++)
-            {
-                if (iter == id_lane_iter1)
-                {
-                    iter->second.outer_border = iter->second.lane_width;
-                }
-                else
-                {
-                    iter->second.inner_border = std::prev(iter)->second.outer_border;
-                    iter->second.outer_border = std::prev(iter)->second.outer_border.add(iter->second.lane_width);
-                }
+                lane.roadmark_groups.emplace(std::move(roadmark_group));
             }
+        }
 
-            /* iterate from id #0 towards -inf */
-            std::map<int, Lane>::reverse_iterator r_id_lane_iter_1(id_lane_iter0);
-            for (auto r_iter = r_id_lane_iter_1; r_iter != lanesection.id_to_lane.rend(); r_iter++)
+        /* derive lane borders from lane widths */
+        auto id_lane_iter0 = lanesection.id_to_lane.find(0);
+        if (id_lane_iter0 == lanesection.id_to_lane.end())
+            throw std::runtime_error("lane section does not have lane #0");
+
+        /* iterate from id #0 towards +inf */
+        auto id_lane_iter1 = std::next(id_lane_iter0);
+        for (auto iter = id_lane_iter1; iter != lanesection.id_to_lane.end(); iter++)
+        {
+            if (iter == id_lane_iter1)
             {
-                if (r_iter == r_id_lane_iter_1)
-                {
-                    r_iter->second.outer_border = r_iter->second.lane_width.negate();
-                }
-                else
-                {
-                    r_iter->second.inner_border = std::prev(r_iter)->second.outer_border;
-                    r_iter->second.outer_border = std::prev(r_iter)->second.outer_border.add(r_iter->second.lane_width.negate());
-                }
+                iter->second.outer_border = iter->second.lane_width;
             }
-
-            for (auto& id_lane : lanesection.id_to_lane)
+            else
             {
-                id_lane.second.inner_border = id_lane.second.inner_border.add(road.lane_offset);
-                id_lane.second.outer_border = id_lane.second.outer_border.add(road.lane_offset);
+                iter->second.inner_border = std::prev(iter)->second.outer_border;
+                iter->second.outer_border = std::prev(iter)->second.outer_border.add(iter->second.lane_width);
             }
         }
 
-        pugi::xml_node customProfile_node = road_node.child("roadRunnerProfile");
-        if (customProfile_node) 
+        /* iterate from id #0 towards -inf */
+        std::map<int, Lane>::reverse_iterator r_id_lane_iter_1(id_lane_iter0);
+        for (auto r_iter = r_id_lane_iter_1; r_iter != lanesection.id_to_lane.rend(); r_iter++)
         {
-            pugi::xml_node leftProfile = customProfile_node.child("left");
-            if (leftProfile) 
+            if (r_iter == r_id_lane_iter_1)
             {
-                for (auto sectionNode : leftProfile.children("section")) 
-                {
-                    auto s = sectionNode.attribute("type_s").as_uint();
-                    auto laneCount = sectionNode.attribute("laneCount").as_int();
-                    auto offsetX2 = sectionNode.attribute("offsetX2").as_int();
-                    LM::LanePlan profile{offsetX2, laneCount};
-                    road.rr_profile.leftPlans.emplace(s, profile);
-                }
+                r_iter->second.outer_border = r_iter->second.lane_width.negate();
             }
-            
-            pugi::xml_node rightProfile = customProfile_node.child("right");
-            if (rightProfile) 
+            else
             {
-                for (auto sectionNode : rightProfile.children("section"))
-                {
-                    auto s = sectionNode.attribute("type_s").as_uint();
-                    auto laneCount = sectionNode.attribute("laneCount").as_int();
-                    auto offsetX2 = sectionNode.attribute("offsetX2").as_int();
-                    LM::LanePlan profile{offsetX2, laneCount};
-                    road.rr_profile.rightPlans.emplace(s, profile);
-                }
+                r_iter->second.inner_border = std::prev(r_iter)->second.outer_border;
+                r_iter->second.outer_border = std::prev(r_iter)->second.outer_border.add(r_iter->second.lane_width.negate());
             }
         }
-        else
+
+        for (auto& id_lane : lanesection.id_to_lane)
         {
-            supported = false;
+            id_lane.second.inner_border = id_lane.second.inner_border.add(road.lane_offset);
+            id_lane.second.outer_border = id_lane.second.outer_border.add(road.lane_offset);
         }
+    }
 
-        pugi::xml_node boundaryHide_node = road_node.child("roadRunnerBoundaryHide");
-        if (boundaryHide_node)
+    pugi::xml_node customProfile_node = road_node.child("roadRunnerProfile");
+    if (customProfile_node) 
+    {
+        pugi::xml_node leftProfile = customProfile_node.child("left");
+        if (leftProfile) 
+        {
+            for (auto sectionNode : leftProfile.children("section")) 
+            {
+                auto s = sectionNode.attribute("type_s").as_uint();
+                auto laneCount = sectionNode.attribute("laneCount").as_int();
+                auto offsetX2 = sectionNode.attribute("offsetX2").as_int();
+                LM::LanePlan profile{offsetX2, laneCount};
+                road.rr_profile.leftPlans.emplace(s, profile);
+            }
+        }
+        
+        pugi::xml_node rightProfile = customProfile_node.child("right");
+        if (rightProfile) 
         {
-            for (auto detail_node : boundaryHide_node.children())
+            for (auto sectionNode : rightProfile.children("section"))
             {
-                odr::RoadLink::ContactPoint c = detail_node.attribute("contactPoint").as_string() == "start" ?
-                    odr::RoadLink::ContactPoint_Start : odr::RoadLink::ContactPoint_End;
-                int side = strcmp(detail_node.attribute("side").as_string(), "left") == 0 ? 1 : -1;
-                double length = detail_node.attribute("s").as_double();
-                road.boundaryHide.emplace(std::make_pair(c, side), length);
+                auto s = sectionNode.attribute("type_s").as_uint();
+                auto laneCount = sectionNode.attribute("laneCount").as_int();
+                auto offsetX2 = sectionNode.attribute("offsetX2").as_int();
+                LM::LanePlan profile{offsetX2, laneCount};
+                road.rr_profile.rightPlans.emplace(s, profile);
             }
         }
+    }
+    else
+    {
+        supported = false;
+    }
+
+    pugi::xml_node boundaryHide_node = road_node.child("roadRunnerBoundaryHide");
+    if (boundaryHide_node)
+    {
+        for (auto detail_node : boundaryHide_node.children())
+        {
+            odr::RoadLink::ContactPoint c = detail_node.attribute("contactPoint").as_string() == "start" ?
+                odr::RoadLink::ContactPoint_Start : odr::RoadLink::ContactPoint_End;
+            int side = strcmp(detail_node.attribute("side").as_string(), "left") == 0 ? 1 : -1;
+            double length = detail_node.attribute("s").as_double();
+            road.boundaryHide.emplace(std::make_pair(c, side), length);
+        }
+    }
 
-        /* parse road objects */
-        if (with_road_objects)
+    /* parse road objects */
+    if (with_road_objects)
+    {
+        const RoadObjectCorner::Type default_local_outline_type =
+            abs_z_for_for_local_road_obj_outline ? RoadObjectCorner::Type_Local_AbsZ : RoadObjectCorner::Type_Local_RelZ;
+
+        for (pugi::xml_node object_node : road_node.child("objects").children("object"))
         {
-            const RoadObjectCorner::Type default_local_outline_type =
-                abs_z_for_for_local_road_obj_outline ? RoadObjectCorner::Type_Local_AbsZ : RoadObjectCorner::Type_Local_RelZ;
+            std::string road_object_id = object_node.attribute("id").as_string("");
+            CHECK_AND_REPAIR(road.id_to_object.find(road_object_id) == road.id_to_object.end(),
+                             (std::string("object::id already exists - ") + road_object_id).c_str(),
+                             road_object_id = road_object_id + std::string("_dup"));
+
+            const bool  is_dynamic_object = std::string(object_node.attribute("dynamic").as_string("no")) == "yes" ? true : false;
+            RoadObject& road_object = road.id_to_object
+                                          .insert({road_object_id,
+                                                   RoadObject(road_id,
+                                                              road_object_id,
+                                                              object_node.attribute("s").as_double(0),
+                                                              object_node.attribute("t").as_double(0),
+                                                              object_node.attribute("zOffset").as_double(0),
+                                                              object_node.attribute("length").as_double(0),
+                                                              object_node.attribute("validLength").as_double(0),
+                                                              object_node.attribute("width").as_double(0),
+                                                              object_node.attribute("radius").as_double(0),
+                                                              object_node.attribute("height").as_double(0),
+                                                              object_node.attribute("hdg").as_double(0),
+                                                              object_node.attribute("pitch").as_double(0),
+                                                              object_node.attribute("roll").as_double(0),
+                                                              object_node.attribute("type").as_string(""),
+                                                              object_node.attribute("name").as_string(""),
+                                                              object_node.attribute("orientation").as_string(""),
+                                                              object_node.attribute("subtype").as_string(""),
+                                                              is_dynamic_object)})
+                                          .first->second;
+            road_object.xml_node = object_node;
+
+            CHECK_AND_REPAIR(road_object.s0 >= 0, "object::s < 0", road_object.s0 = 0);
+            CHECK_AND_REPAIR(road_object.valid_length >= 0, "object::validLength < 0", road_object.valid_length = 0);
+            CHECK_AND_REPAIR(road_object.length >= 0, "object::length < 0", road_object.length = 0);
+            CHECK_AND_REPAIR(road_object.width >= 0, "object::width < 0", road_object.width = 0);
+            CHECK_AND_REPAIR(road_object.radius >= 0, "object::radius < 0", road_object.radius = 0);
+
+            for (pugi::xml_node repeat_node : object_node.children("repeat"))
+            {
+                RoadObjectRepeat road_object_repeat(repeat_node.attribute("s").as_double(NAN),
+                                                    repeat_node.attribute("length").as_double(0),
+                                                    repeat_node.attribute("distance").as_double(0),
+                                                    repeat_node.attribute("tStart").as_double(NAN),
+                                                    repeat_node.attribute("tEnd").as_double(NAN),
+                                                    repeat_node.attribute("widthStart").as_double(NAN),
+                                                    repeat_node.attribute("widthEnd").as_double(NAN),
+                                                    repeat_node.attribute("heightStart").as_double(NAN),
+                                                    repeat_node.attribute("heightEnd").as_double(NAN),
+                                                    repeat_node.attribute("zOffsetStart").as_double(NAN),
+                                                    repeat_node.attribute("zOffsetEnd").as_double(NAN));
+                road_object_repeat.xml_node = repeat_node;
+
+                CHECK_AND_REPAIR(
+                    std::isnan(road_object_repeat.s0) || road_object_repeat.s0 >= 0, "object::repeat::s < 0", road_object_repeat.s0 = 0);
+                CHECK_AND_REPAIR(std::isnan(road_object_repeat.width_start) || road_object_repeat.width_start >= 0,
+                                 "object::repeat::widthStart < 0",
+                                 road_object_repeat.width_start = 0);
+                CHECK_AND_REPAIR(std::isnan(road_object_repeat.width_end) || road_object_repeat.width_end >= 0,
+                                 "object::repeat::widthStart < 0",
+                                 road_object_repeat.width_end = 0);
+                CHECK_AND_REPAIR(road_object_repeat.length >= 0, "object::repeat::length < 0", road_object_repeat.length = 0);
+                CHECK_AND_REPAIR(road_object_repeat.distance >= 0, "object::repeat::distance < 0", road_object_repeat.distance = 0);
+
+                road_object.repeats.push_back(road_object_repeat);
+            }
 
-            for (pugi::xml_node object_node : road_node.child("objects").children("object"))
+            /* since v1.45 multiple <outline> are allowed and parent tag is <outlines>, not <object>; this supports v1.4 and v1.45+ */
+            pugi::xml_node outlines_parent_node = object_node.child("outlines") ? object_node.child("outlines") : object_node;
+            for (pugi::xml_node outline_node : outlines_parent_node.children("outline"))
             {
-                std::string road_object_id = object_node.attribute("id").as_string("");
-                CHECK_AND_REPAIR(road.id_to_object.find(road_object_id) == road.id_to_object.end(),
-                                 (std::string("object::id already exists - ") + road_object_id).c_str(),
-                                 road_object_id = road_object_id + std::string("_dup"));
-
-                const bool  is_dynamic_object = std::string(object_node.attribute("dynamic").as_string("no")) == "yes" ? true : false;
-                RoadObject& road_object = road.id_to_object
-                                              .insert({road_object_id,
-                                                       RoadObject(road_id,
-                                                                  road_object_id,
-                                                                  object_node.attribute("s").as_double(0),
-                                                                  object_node.attribute("t").as_double(0),
-                                                                  object_node.attribute("zOffset").as_double(0),
-                                                                  object_node.attribute("length").as_double(0),
-                                                                  object_node.attribute("validLength").as_double(0),
-                                                                  object_node.attribute("width").as_double(0),
-                                                                  object_node.attribute("radius").as_double(0),
-                                                                  object_node.attribute("height").as_double(0),
-                                                                  object_node.attribute("hdg").as_double(0),
-                                                                  object_node.attribute("pitch").as_double(0),
-                                                                  object_node.attribute("roll").as_double(0),
-                                                                  object_node.attribute("type").as_string(""),
-                                                                  object_node.attribute("name").as_string(""),
-                                                                  object_node.attribute("orientation").as_string(""),
-                                                                  object_node.attribute("subtype").as_string(""),
-                                                                  is_dynamic_object)})
-                                              .first->second;
-                road_object.xml_node = object_node;
-
-                CHECK_AND_REPAIR(road_object.s0 >= 0, "object::s < 0", road_object.s0 = 0);
-                CHECK_AND_REPAIR(road_object.valid_length >= 0, "object::validLength < 0", road_object.valid_length = 0);
-                CHECK_AND_REPAIR(road_object.length >= 0, "object::length < 0", road_object.length = 0);
-                CHECK_AND_REPAIR(road_object.width >= 0, "object::width < 0", road_object.width = 0);
-                CHECK_AND_REPAIR(road_object.radius >= 0, "object::radius < 0", road_object.radius = 0);
-
-                for (pugi::xml_node repeat_node : object_node.children("repeat"))
+                RoadObjectOutline road_object_outline(outline_node.attribute("id").as_int(-1),
+                                                      outline_node.attribute("fillType").as_string(""),
+                                                      outline_node.attribute("laneType").as_string(""),
+                                                      outline_node.attribute("outer").as_bool(true),
+                                                      outline_node.attribute("closed").as_bool(true));
+                road_object_outline.xml_node = outline_node;
+
+                for (pugi::xml_node corner_local_node : outline_node.children("cornerLocal"))
                 {
-                    RoadObjectRepeat road_object_repeat(repeat_node.attribute("s").as_double(NAN),
-                                                        repeat_node.attribute("length").as_double(0),
-                                                        repeat_node.attribute("distance").as_double(0),
-                                                        repeat_node.attribute("tStart").as_double(NAN),
-                                                        repeat_node.attribute("tEnd").as_double(NAN),
-                                                        repeat_node.attribute("widthStart").as_double(NAN),
-                                                        repeat_node.attribute("widthEnd").as_double(NAN),
-                                                        repeat_node.attribute("heightStart").as_double(NAN),
-                                                        repeat_node.attribute("heightEnd").as_double(NAN),
-                                                        repeat_node.attribute("zOffsetStart").as_double(NAN),
-                                                        repeat_node.attribute("zOffsetEnd").as_double(NAN));
-                    road_object_repeat.xml_node = repeat_node;
-
-                    CHECK_AND_REPAIR(
-                        std::isnan(road_object_repeat.s0) || road_object_repeat.s0 >= 0, "object::repeat::s < 0", road_object_repeat.s0 = 0);
-                    CHECK_AND_REPAIR(std::isnan(road_object_repeat.width_start) || road_object_repeat.width_start >= 0,
-                                     "object::repeat::widthStart < 0",
-                                     road_object_repeat.width_start = 0);
-                    CHECK_AND_REPAIR(std::isnan(road_object_repeat.width_end) || road_object_repeat.width_end >= 0,
-                                     "object::repeat::widthStart < 0",
-                                     road_object_repeat.width_end = 0);
-                    CHECK_AND_REPAIR(road_object_repeat.length >= 0, "object::repeat::length < 0", road_object_repeat.length = 0);
-                    CHECK_AND_REPAIR(road_object_repeat.distance >= 0, "object::repeat::distance < 0", road_object_repeat.distance = 0);
-
-                    road_object.repeats.push_back(road_object_repeat);
+                    const Vec3D pt_local{corner_local_node.attribute("u").as_double(0),
+                                         corner_local_node.attribute("v").as_double(0),
+                                         corner_local_node.attribute("z").as_double(0)};
+
+                    RoadObjectCorner road_object_corner_local(corner_local_node.attribute("id").as_int(-1),
+                                                              pt_local,
+                                                              corner_local_node.attribute("height").as_double(0),
+                                                              default_local_outline_type);
+                    road_object_corner_local.xml_node = corner_local_node;
+                    road_object_outline.outline.push_back(road_object_corner_local);
                 }
 
-                /* since v1.45 multiple <outline> are allowed and parent tag is <outlines>, not <object>; this supports v1.4 and v1.45+ */
-                pugi::xml_node outlines_parent_node = object_node.child("outlines") ? object_node.child("outlines") : object_node;
-                for (pugi::xml_node outline_node : outlines_parent_node.children("outline"))
+                for (pugi::xml_node corner_road_node : outline_node.children("cornerRoad"))
                 {
-                    RoadObjectOutline road_object_outline(outline_node.attribute("id").as_int(-1),
-                                                          outline_node.attribute("fillType").as_string(""),
-                                                          outline_node.attribute("laneType").as_string(""),
-                                                          outline_node.attribute("outer").as_bool(true),
-                                                          outline_node.attribute("closed").as_bool(true));
-                    road_object_outline.xml_node = outline_node;
-
-                    for (pugi::xml_node corner_local_node : outline_node.children("cornerLocal"))
-                    {
-                        const Vec3D pt_local{corner_local_node.attribute("u").as_double(0),
-                                             corner_local_node.attribute("v").as_double(0),
-                                             corner_local_node.attribute("z").as_double(0)};
-
-                        RoadObjectCorner road_object_corner_local(corner_local_node.attribute("id").as_int(-1),
-                                                                  pt_local,
-                                                                  corner_local_node.attribute("height").as_double(0),
-                                                                  default_local_outline_type);
-                        road_object_corner_local.xml_node = corner_local_node;
-                        road_object_outline.outline.push_back(road_object_corner_local);
-                    }
-
-                    for (pugi::xml_node corner_road_node : outline_node.children("cornerRoad"))
-                    {
-                        const Vec3D pt_road{corner_road_node.attribute("s").as_double(0),
-                                            corner_road_node.attribute("t").as_double(0),
-                                            corner_road_node.attribute("dz").as_double(0)};
-
-                        RoadObjectCorner road_object_corner_road(corner_road_node.attribute("id").as_int(-1),
-                                                                 pt_road,
-                                                                 corner_road_node.attribute("height").as_double(0),
-                                                                 RoadObjectCorner::Type_Road);
-                        road_object_corner_road.xml_node = corner_road_node;
-                        road_object_outline.outline.push_back(road_object_corner_road);
-                    }
-
-                    road_object.outlines.push_back(road_object_outline);
+                    const Vec3D pt_road{corner_road_node.attribute("s").as_double(0),
+                                        corner_road_node.attribute("t").as_double(0),
+                                        corner_road_node.attribute("dz").as_double(0)};
+
+                    RoadObjectCorner road_object_corner_road(corner_road_node.attribute("id").as_int(-1),
+                                                             pt_road,
+                                                             corner_road_node.attribute("height").as_double(0),
+                                                             RoadObjectCorner::Type_Road);
+                    road_object_corner_road.xml_node = corner_road_node;
+                    road_object_outline.outline.push_back(road_object_corner_road);
                 }
 
-                road_object.lane_validities = extract_lane_validity_records(object_node);
+                road_object.outlines.push_back(road_object_outline);
             }
+
+            road_object.lane_validities = extract_lane_validity_records(object_node);
         }
-        /* parse signals */
-        if (with_road_signals)
+    }
+    /* parse signals */
+    if (with_road_signals)
+    {
+        for (pugi::xml_node signal_node : road_node.child("signals").children("signal"))
         {
-            for (pugi::xml_node signal_node : road_node.child("signals").children("signal"))
-            {
-                std::string road_signal_id = signal_node.attribute("id").as_string("");
-                CHECK_AND_REPAIR(road.id_to_signal.find(road_signal_id) == road.id_to_signal.end(),
-                                 (std::string("signal::id already exists - ") + road_signal_id).c_str(),
-                                 road_signal_id = road_signal_id + std::string("_dup"));
-
-                RoadSignal& road_signal = road.id_to_signal
-                                              .insert({road_signal_id,
-                                                       RoadSignal(road_id,
-                                                                  road_signal_id,
-                                                                  signal_node.attribute("name").as_string(""),
-                                                                  signal_node.attribute("s").as_double(0),
-                                                                  signal_node.attribute("t").as_double(0),
-                                                                  signal_node.attribute("dynamic").as_bool(),
-                                                                  signal_node.attribute("zOffset").as_double(0),
-                                                                  signal_node.attribute("value").as_double(0),
-                                                                  signal_node.attribute("height").as_double(0),
-                                                                  signal_node.attribute("width").as_double(0),
-                                                                  signal_node.attribute("hOffset").as_double(0),
-                                                                  signal_node.attribute("pitch").as_double(0),
-                                                                  signal_node.attribute("roll").as_double(0),
-                                                                  signal_node.attribute("orientation").as_string("none"),
-                                                                  signal_node.attribute("country").as_string(""),
-                                                                  signal_node.attribute("type").as_string("none"),
-                                                                  signal_node.attribute("subtype").as_string("none"),
-                                                                  signal_node.attribute("unit").as_string(""),
-                                                                  signal_node.attribute("text").as_string("none"))})
-                                              .first->second;
-                road_signal.xml_node = signal_node;
-
-                CHECK_AND_REPAIR(road_signal.s0 >= 0, "signal::s < 0", road_signal.s0 = 0);
-                CHECK_AND_REPAIR(road_signal.height >= 0, "signal::height < 0", road_signal.height = 0);
-                CHECK_AND_REPAIR(road_signal.width >= 0, "signal::width < 0", road_signal.width = 0);
-
-                road_signal.lane_validities = extract_lane_validity_records(signal_node);
-            }
+            std::string road_signal_id = signal_node.attribute("id").as_string("");
+            CHECK_AND_REPAIR(road.id_to_signal.find(road_signal_id) == road.id_to_signal.end(),
+                             (std::string("signal::id already exists - ") + road_signal_id).c_str(),
+                             road_signal_id = road_signal_id + std::string("_dup"));
+
+            RoadSignal& road_signal = road.id_to_signal
+                                          .insert({road_signal_id,
+                                                   RoadSignal(road_id,
+                                                              road_signal_id,
+                                                              signal_node.attribute("name").as_string(""),
+                                                              signal_node.attribute("s").as_double(0),
+                                                              signal_node.attribute("t").as_double(0),
+                                                              signal_node.attribute("dynamic").as_bool(),
+                                                              signal_node.attribute("zOffset").as_double(0),
+                                                              signal_node.attribute("value").as_double(0),
+                                                              signal_node.attribute("height").as_double(0),
+                                                              signal_node.attribute("width").as_double(0),
+                                                              signal_node.attribute("hOffset").as_double(0),
+                                                              signal_node.attribute("pitch").as_double(0),
+                                                              signal_node.attribute("roll").as_double(0),
+                                                              signal_node.attribute("orientation").as_string("none"),
+                                                              signal_node.attribute("country").as_string(""),
+                                                              signal_node.attribute("type").as_string("none"),
+                                                              signal_node.attribute("subtype").as_string("none"),
+                                                              signal_node.attribute("unit").as_string(""),
+                                                              signal_node.attribute("text").as_string("none"))})
+                                          .first->second;
+            road_signal.xml_node = signal_node;
+
+            CHECK_AND_REPAIR(road_signal.s0 >= 0, "signal::s < 0", road_signal.s0 = 0);
+            CHECK_AND_REPAIR(road_signal.height >= 0, "signal::height < 0", road_signal.height = 0);
+            CHECK_AND_REPAIR(road_signal.width >= 0, "signal::width < 0", road_signal.width = 0);
+
+            road_signal.lane_validities = extract_lane_validity_records(signal_node);
         }
     }
 
-    return supported;
+    return road;
 }
 
 bool OpenDriveMap::Load(const std::string& xodr_file,
@@ -800,7 +855,8 @@ bool OpenDriveMap::Load(const std::string& xodr_file,
                         const bool         with_lane_height,
                         const bool         abs_z_for_for_local_road_obj_outline,
                         const bool         fix_spiral_edge_cases,
-                        const bool         with_road_signals)
+                        const bool         with_road_signals,
+                        const unsigned     num_threads)
 {
     std::ifstream     ifs(xodr_file);
     std::stringstream buffer;
@@ -812,7 +868,8 @@ bool OpenDriveMap::Load(const std::string& xodr_file,
                       with_lane_height,
                       abs_z_for_for_local_road_obj_outline,
                       fix_spiral_edge_cases,
-                      with_road_signals);
+                      with_road_signals,
+                      num_threads);
 }
 
 std::vector<Road> OpenDriveMap::get_roads() const { return get_map_values(this->id_to_road); }
@@ -1070,7 +1127,7 @@ std::vector<std::tuple<LaneKey, double, LaneKey, double>> OpenDriveMap::get_rout
                 auto roadObj = id_object.second;
 
                 auto objRoad = roadObj.road_id;
-                auto objLaneSection = id_to_road.at(objRoad).get_lanesection(roadObj.s0);
+                const auto& objLaneSection = id_to_road.at(objRoad).get_lanesection(roadObj.s0);
                 auto possibleLeftLanes = objLaneSection.get_sorted_driving_lanes(1);
                 auto possibleLanes = objLaneSection.get_sorted_driving_lanes(-1);
 
@@ -1258,383 +1315,541 @@ double OpenDriveMap::get_lanekey_length(LaneKey key) const
     return road.get_lanesection_length(section);
 }
 
-void OpenDriveMap::export_file(const std::string& fpath) const
+namespace
+{
+/* Appends xml text formatted exactly as pugi::xml_document::save does by default: tab indent, " />" for empty elements,
+   "%.17g" doubles and pugixml's attribute escaping */
+class XmlTextWriter
 {
-    pugi::xml_document doc;
-    pugi::xml_node     main = doc.append_child("OpenDRIVE");
-    pugi::xml_node     header = main.append_child("header");
-    header.append_attribute("revMajor").set_value("1");
-    header.append_attribute("revMinor").set_value("4");
+public:
+    XmlTextWriter(std::string& out, const std::size_t base_depth) : out(out), base_depth(base_depth) {}
 
-    for (auto rit : id_to_road) 
+    XmlTextWriter& open(const char* name)
     {
-        const odr::Road&      road = rit.second;
-        pugi::xml_node road_node = main.append_child("road");
-        road_node.append_attribute("name").set_value(road.name.c_str());
-        road_node.append_attribute("length").set_value(road.length);
-        road_node.append_attribute("id").set_value(rit.first.c_str());
-        road_node.append_attribute("junction").set_value(road.junction.c_str());
-
-        // link
-        pugi::xml_node link = road_node.append_child("link");
-        if (road.predecessor.type != odr::RoadLink::Type_None) 
+        if (!open_elements.empty() && !open_elements.back().second)
         {
-            pugi::xml_node pred = link.append_child("predecessor");
-            roadNodeToXML(road.predecessor, pred);
+            out += ">\n";
+            open_elements.back().second = true;
         }
-        if (road.successor.type != odr::RoadLink::Type_None) 
+        out.append(base_depth + open_elements.size(), '\t');
+        out += '<';
+        out += name;
+        open_elements.emplace_back(name, false);
+        return *this;
+    }
+
+    void close()
+    {
+        const auto& element = open_elements.back();
+        if (element.second)
         {
-            pugi::xml_node succ = link.append_child("successor");
-            roadNodeToXML(road.successor, succ);
+            out.append(base_depth + open_elements.size() - 1, '\t');
+            out += "</";
+            out += element.first;
+            out += ">\n";
         }
-
-        // type
-        for (auto it : road.s_to_type) 
+        else
         {
-            pugi::xml_node type = road_node.append_child("type");
-            type.append_attribute("s").set_value(it.first);
-            type.append_attribute("type").set_value(it.second.c_str());
+            out += " />\n";
         }
+        open_elements.pop_back();
+    }
 
-        // planView
-        pugi::xml_node planView = road_node.append_child("planView");
-        for (auto it = road.ref_line.s0_to_geometry.begin(); it != road.ref_line.s0_to_geometry.end(); ++it) 
+    XmlTextWriter& attr(const char* name, const char* value)
+    {
+        out += ' ';
+        out += name;
+        out += "=\"";
+        for (const char* c = value; *c; c++)
         {
-            pugi::xml_node geometry = planView.append_child("geometry");
-            geometry.append_attribute("s").set_value(it->first);
-            geometry.append_attribute("x").set_value(it->second->x0);
-            geometry.append_attribute("y").set_value(it->second->y0);
-            geometry.append_attribute("hdg").set_value(it->second->hdg0);
-            geometry.append_attribute("length").set_value(it->second->length);
-
-            if (dynamic_cast<odr::Line*>(it->second.get()))
+            switch (*c)
             {
-                geometry.append_child("line");
-            }
-            else if (odr::Arc* geo = dynamic_cast<odr::Arc*>(it->second.get()))
-            {
-                geometry.append_child("arc").append_attribute("curvature").set_value(geo->curvature);
-            }
-            else if (odr::Spiral* geo = dynamic_cast<odr::Spiral*>(it->second.get()))
-            {
-                pugi::xml_node spiral = geometry.append_child("spiral");
-                spiral.append_attribute("curvStart").set_value(geo->curv_start);
-                spiral.append_attribute("curvEnd").set_value(geo->curv_end);
-            }
-            else 
-            {
-                odr::ParamPoly3* g = dynamic_cast<odr::ParamPoly3*>(it->second.get());
-                pugi::xml_node   poly3 = geometry.append_child("paramPoly3");
-                poly3.append_attribute("aU").set_value(g->aU);
-                poly3.append_attribute("aV").set_value(g->aV);
-                poly3.append_attribute("bU").set_value(g->bU);
-                poly3.append_attribute("bV").set_value(g->bV);
-                poly3.append_attribute("cU").set_value(g->cU);
-                poly3.append_attribute("cV").set_value(g->cV);
-                poly3.append_attribute("dU").set_value(g->dU);
-                poly3.append_attribute("dV").set_value(g->dV);
-                poly3.append_attribute("pRange").set_value(g->pRange_normalized ? "normalized" : "arcLength");
+            case '&':
+                out += "&amp;";
+                break;
+            case '<':
+                out += "&lt;";
+                break;
+            case '"':
+                out += "&quot;";
+                break;
+            default:
+                if (static_cast<unsigned char>(*c) < 32)
+                {
+                    out += "&#";
+                    out += static_cast<char>('0' + *c / 10);
+                    out += static_cast<char>('0' + *c % 10);
+                    out += ';';
+                }
+                else
+                {
+                    out += *c;
+                }
             }
         }
+        out += '"';
+        return *this;
+    }
+
+    XmlTextWriter& attr(const char* name, const std::string& value) { return attr(name, value.c_str()); }
+
+    XmlTextWriter& attr(const char* name, const bool value) { return attr(name, value ? "true" : "false"); }
+
+    XmlTextWriter& attr(const char* name, const int value) { return attr(name, std::to_string(value)); }
+
+    XmlTextWriter& attr(const char* name, const unsigned value) { return attr(name, std::to_string(value)); }
+
+    XmlTextWriter& attr(const char* name, const double value)
+    {
+        char buf[128];
+        snprintf(buf, sizeof(buf), "%.17g", value);
+        return attr(name, buf);
+    }
+
+private:
+    std::string&                              out;
+    const std::size_t                         base_depth;
+    std::vector<std::pair<const char*, bool>> open_elements; // name, has children
+};
+
+void write_road_link(const RoadLink& road_link, XmlTextWriter& w)
+{
+    const char* type_s = road_link.type == RoadLink::Type_Road ? "road" : road_link.type == RoadLink::Type_Junction ? "junction" : "";
+    const char* contact_s = road_link.contact_point == RoadLink::ContactPoint_Start ? "start"
+                            : road_link.contact_point == RoadLink::ContactPoint_End ? "end"
+                                                                                    : "";
+    w.attr("elementType", type_s).attr("elementId", road_link.id).attr("contactPoint", contact_s);
+}
+
+void write_poly3(const char* name, const double s, const Poly3& poly, XmlTextWriter& w)
+{
+    w.open(name).attr("s", s).attr("a", poly.raw_a).attr("b", poly.raw_b).attr("c", poly.raw_c).attr("d", poly.raw_d);
+    w.close();
+}
+
+/* Re-encodes items that are dirty or not cached yet and drops fragments of items that are gone.
+   Fragments stay keyed by id, so they iterate in the same order as the map itself. */
+template<typename T, typename Encode>
+void refresh_fragments(const std::map<std::string, T>&     items,
+                       std::map<std::string, std::string>& fragments,
+                       std::set<std::string>&              dirty,
+                       const unsigned                      num_threads,
+                       Encode                              encode)
+{
+    for (const auto& id : dirty)
+    {
+        if (items.find(id) == items.end())
+            fragments.erase(id);
+    }
+
+    std::vector<const std::pair<const std::string, T>*> outdated;
+    for (const auto& id_item : items)
+    {
+        if (dirty.find(id_item.first) != dirty.end() || fragments.find(id_item.first) == fragments.end())
+            outdated.push_back(&id_item);
+    }
+
+    /* each item serializes independently into its own buffer */
+    std::vector<std::string> encoded(outdated.size());
+    parallel_for(outdated.size(),
+                 get_worker_count(outdated.size(), num_threads),
+                 [&](const std::size_t i, const std::size_t) { encoded[i] = encode(outdated[i]->first, outdated[i]->second); });
+    for (std::size_t i = 0; i < outdated.size(); i++)
+        fragments[outdated[i]->first] = std::move(encoded[i]);
+    dirty.clear();
+
+    if (fragments.size() != items.size())
+    {
+        for (auto it = fragments.begin(); it != fragments.end();)
+            it = items.find(it->first) == items.end() ? fragments.erase(it) : std::next(it);
+    }
+}
+const char XODR_HEAD[] = "<?xml version=\"1.0\"?>\n<OpenDRIVE>\n\t<header revMajor=\"1\" revMinor=\"4\" />\n";
+const char XODR_TAIL[] = "</OpenDRIVE>\n";
+
+void fnv1a(const char* data, const std::size_t size, uint64_t& hash)
+{
+    for (std::size_t i = 0; i < size; i++)
+    {
+        hash ^= static_cast<unsigned char>(data[i]);
+        hash *= 1099511628211ull;
+    }
+}
+} // namespace
+
+bool OpenDriveMap::export_file(const std::string& fpath, const unsigned num_threads) const
+{
+    XodrFragmentCache cache;
+    return export_file(fpath, cache, num_threads);
+}
+
+bool OpenDriveMap::export_file(const std::string& fpath, XodrFragmentCache& cache, const unsigned num_threads) const
+{
+    refresh_fragments(id_to_road,
+                      cache.road_fragments,
+                      cache.dirty_roads,
+                      num_threads,
+                      [this](const std::string& id, const Road& road) { return road_to_xml(id, road); });
+    refresh_fragments(id_to_junction,
+                      cache.junction_fragments,
+                      cache.dirty_junctions,
+                      num_threads,
+                      [this](const std::string&, const Junction& junction) { return junction_to_xml(junction); });
+
+    /* written aside then renamed, so a failed save leaves the previous file intact */
+    const std::string tmp_path = fpath + ".tmp";
+    FILE*             file = fopen(tmp_path.c_str(), "wb");
+    if (!file)
+    {
+        printf("Could not open %s for writing\n", tmp_path.c_str());
+        return false;
+    }
+    fwrite(XODR_HEAD, 1, sizeof(XODR_HEAD) - 1, file);
+    for (const auto& id_fragment : cache.road_fragments)
+        fwrite(id_fragment.second.data(), 1, id_fragment.second.size(), file);
+    for (const auto& id_fragment : cache.junction_fragments)
+        fwrite(id_fragment.second.data(), 1, id_fragment.second.size(), file);
+    fwrite(XODR_TAIL, 1, sizeof(XODR_TAIL) - 1, file);
+
+    const bool write_failed = ferror(file) != 0;
+    if (fclose(file) != 0 || write_failed)
+    {
+        printf("Could not write %s\n", tmp_path.c_str());
+        remove(tmp_path.c_str());
+        return false;
+    }
 
-        // elevationProfile
-        pugi::xml_node elevationProfile = road_node.append_child("elevationProfile");
-        for (const auto& s0_poly : road.ref_line.elevation_profile.s0_to_poly) 
+    if (rename(tmp_path.c_str(), fpath.c_str()) != 0)
+    {
+        /* rename does not replace an existing file on Windows */
+        remove(fpath.c_str());
+        if (rename(tmp_path.c_str(), fpath.c_str()) != 0)
         {
-            pugi::xml_node elevation = elevationProfile.append_child("elevation");
-            elevation.append_attribute("s").set_value(s0_poly.first);
-            elevation.append_attribute("a").set_value(s0_poly.second.raw_a);
-            elevation.append_attribute("b").set_value(s0_poly.second.raw_b);
-            elevation.append_attribute("c").set_value(s0_poly.second.raw_c);
-            elevation.append_attribute("d").set_value(s0_poly.second.raw_d);
+            printf("Could not replace %s\n", fpath.c_str());
+            remove(tmp_path.c_str());
+            return false;
         }
+    }
+    return true;
+}
 
-        // lanes
-        pugi::xml_node lanes = road_node.append_child("lanes");
-        for (auto it : road.lane_offset.s0_to_poly) 
+void XodrFragmentCache::clear()
+{
+    road_fragments.clear();
+    junction_fragments.clear();
+    dirty_roads.clear();
+    dirty_junctions.clear();
+}
+
+uint64_t XodrFragmentCache::content_hash() const
+{
+    uint64_t hash = 14695981039346656037ull;
+    fnv1a(XODR_HEAD, sizeof(XODR_HEAD) - 1, hash);
+    for (const auto& id_fragment : road_fragments)
+        fnv1a(id_fragment.second.data(), id_fragment.second.size(), hash);
+    for (const auto& id_fragment : junction_fragments)
+        fnv1a(id_fragment.second.data(), id_fragment.second.size(), hash);
+    fnv1a(XODR_TAIL, sizeof(XODR_TAIL) - 1, hash);
+    return hash;
+}
+
+std::string OpenDriveMap::road_to_xml(const std::string& road_id, const Road& road) const
+{
+    std::string   out;
+    XmlTextWriter w(out, 1);
+
+    w.open("road").attr("name", road.name).attr("length", road.length).attr("id", road_id).attr("junction", road.junction);
+
+    // link
+    w.open("link");
+    if (road.predecessor.type != RoadLink::Type_None)
+    {
+        w.open("predecessor");
+        write_road_link(road.predecessor, w);
+        w.close();
+    }
+    if (road.successor.type != RoadLink::Type_None)
+    {
+        w.open("successor");
+        write_road_link(road.successor, w);
+        w.close();
+    }
+    w.close();
+
+    // type
+    for (const auto& s_type : road.s_to_type)
+    {
+        w.open("type").attr("s", s_type.first).attr("type", s_type.second);
+        w.close();
+    }
+
+    // planView
+    w.open("planView");
+    for (const auto& s0_geometry : road.ref_line.s0_to_geometry)
+    {
+        const RoadGeometry* geometry = s0_geometry.second.get();
+        w.open("geometry")
+            .attr("s", s0_geometry.first)
+            .attr("x", geometry->x0)
+            .attr("y", geometry->y0)
+            .attr("hdg", geometry->hdg0)
+            .attr("length", geometry->length);
+
+        if (dynamic_cast<const Line*>(geometry))
+        {
+            w.open("line");
+        }
+        else if (const Arc* arc = dynamic_cast<const Arc*>(geometry))
         {
-            pugi::xml_node laneOffset = lanes.append_child("laneOffset");
-            laneOffset.append_attribute("s").set_value(it.first);
-            laneOffset.append_attribute("a").set_value(it.second.raw_a);
-            laneOffset.append_attribute("b").set_value(it.second.raw_b);
-            laneOffset.append_attribute("c").set_value(it.second.raw_c);
-            laneOffset.append_attribute("d").set_value(it.second.raw_d);
+            w.open("arc").attr("curvature", arc->curvature);
         }
-        for (auto sectionIt : road.s_to_lanesection) 
+        else if (const Spiral* spiral = dynamic_cast<const Spiral*>(geometry))
         {
-            pugi::xml_node laneSection = lanes.append_child("laneSection");
-            laneSection.append_attribute("s").set_value(sectionIt.first);
-            bool leftCreated = false, rightCreated = false;
+            w.open("spiral").attr("curvStart", spiral->curv_start).attr("curvEnd", spiral->curv_end);
+        }
+        else
+        {
+            const ParamPoly3* g = dynamic_cast<const ParamPoly3*>(geometry);
+            w.open("paramPoly3")
+                .attr("aU", g->aU)
+                .attr("aV", g->aV)
+                .attr("bU", g->bU)
+                .attr("bV", g->bV)
+                .attr("cU", g->cU)
+                .attr("cV", g->cV)
+                .attr("dU", g->dU)
+                .attr("dV", g->dV)
+                .attr("pRange", g->pRange_normalized ? "normalized" : "arcLength");
+        }
+        w.close();
+        w.close();
+    }
+    w.close();
+
+    // elevationProfile
+    w.open("elevationProfile");
+    for (const auto& s0_poly : road.ref_line.elevation_profile.s0_to_poly)
+        write_poly3("elevation", s0_poly.first, s0_poly.second, w);
+    w.close();
+
+    // lanes
+    w.open("lanes");
+    for (const auto& s0_poly : road.lane_offset.s0_to_poly)
+        write_poly3("laneOffset", s0_poly.first, s0_poly.second, w);
+    for (const auto& s_section : road.s_to_lanesection)
+    {
+        w.open("laneSection").attr("s", s_section.first);
 
-            pugi::xml_node left, right;
+        /* lanes are visited by ascending id, so right, center and left groups are each contiguous */
+        const char* open_group = nullptr;
+        for (const auto& id_lane : s_section.second.id_to_lane)
+        {
+            const Lane& l = id_lane.second;
+            const char* group = id_lane.first > 0 ? "left" : id_lane.first == 0 ? "center" : "right";
+            if (group != open_group)
+            {
+                if (open_group)
+                    w.close();
+                w.open(group);
+                open_group = group;
+            }
 
-            for (auto laneIt : sectionIt.second.id_to_lane) 
+            w.open("lane").attr("id", id_lane.first).attr("type", l.type).attr("level", l.level ? "true" : "false");
+            if (l.predecessor != 0 || l.successor != 0)
             {
-                pugi::xml_node lane;
-                odr::Lane      l = laneIt.second;
-                if (laneIt.first > 0) 
-                {   
-                    if (!leftCreated) 
-                    {
-                        left = laneSection.append_child("left");
-                        leftCreated = true;
-                    }
-                    lane = left.append_child("lane");
-                }
-                else if (laneIt.first == 0)
+                w.open("link");
+                if (l.predecessor != 0)
                 {
-                    pugi::xml_node center = laneSection.append_child("center");
-                    lane = center.append_child("lane");
+                    w.open("predecessor").attr("id", l.predecessor);
+                    w.close();
                 }
-                else
+                if (l.successor != 0)
                 {
-                    if (!rightCreated) 
-                    {
-                        right = laneSection.append_child("right");
-                        rightCreated = true;
-                    }
-                    lane = right.append_child("lane");
+                    w.open("successor").attr("id", l.successor);
+                    w.close();
                 }
-                lane.append_attribute("id").set_value(laneIt.first);
-                lane.append_attribute("type").set_value(l.type.c_str());
-                lane.append_attribute("level").set_value(l.level ? "true" : "false");
-                if (l.predecessor != 0 || l.successor != 0) 
-                {
-                    pugi::xml_node link = lane.append_child("link");
-                    if (l.predecessor != 0)
-                    {
-                        link.append_child("predecessor").append_attribute("id").set_value(l.predecessor);
-                    }
-                    if (l.successor != 0)
-                    {
-                        link.append_child("successor").append_attribute("id").set_value(l.successor);
-                    }
-                }
-                for (auto laneWidthIt : l.lane_width.s0_to_poly) 
-                {
-                    pugi::xml_node width = lane.append_child("width");
-                    width.append_attribute("sOffset").set_value(laneWidthIt.first - sectionIt.first);
-                    width.append_attribute("a").set_value(laneWidthIt.second.raw_a);
-                    width.append_attribute("b").set_value(laneWidthIt.second.raw_b);
-                    width.append_attribute("c").set_value(laneWidthIt.second.raw_c);
-                    width.append_attribute("d").set_value(laneWidthIt.second.raw_d);
-                }
-                // Not sorted
-                for (auto roadMarkIt : l.roadmark_groups) 
+                w.close();
+            }
+            for (const auto& s0_width : l.lane_width.s0_to_poly)
+            {
+                w.open("width")
+                    .attr("sOffset", s0_width.first - s_section.first)
+                    .attr("a", s0_width.second.raw_a)
+                    .attr("b", s0_width.second.raw_b)
+                    .attr("c", s0_width.second.raw_c)
+                    .attr("d", s0_width.second.raw_d);
+                w.close();
+            }
+            // Not sorted
+            for (const auto& roadmark : l.roadmark_groups)
+            {
+                w.open("roadMark").attr("sOffset", roadmark.s_offset).attr("type", roadmark.type).attr("color", roadmark.color);
+                if (roadmark.height != 0)
+                    w.attr("height", roadmark.height);
+                if (roadmark.lane_change != "both")
+                    w.attr("laneChange", roadmark.lane_change);
+                if (roadmark.material != "standard")
+                    w.attr("material", roadmark.material);
+                if (roadmark.weight != "standard")
+                    w.attr("weight", roadmark.weight);
+                if (roadmark.width >= 0)
+                    w.attr("width", roadmark.width);
+
+                if (!roadmark.roadmark_lines.empty())
                 {
-                    pugi::xml_node roadMark = lane.append_child("roadMark");
-                    roadMark.append_attribute("sOffset").set_value(roadMarkIt.s_offset);
-                    roadMark.append_attribute("type").set_value(roadMarkIt.type.c_str());
-                    roadMark.append_attribute("color").set_value(roadMarkIt.color.c_str());
-                    if (roadMarkIt.height != 0) 
-                        roadMark.append_attribute("height").set_value(roadMarkIt.height);
-                    if (roadMarkIt.lane_change != "both")
-                        roadMark.append_attribute("laneChange").set_value(roadMarkIt.lane_change.c_str());
-                    if (roadMarkIt.material != "standard")
-                        roadMark.append_attribute("material").set_value(roadMarkIt.material.c_str());
-                    if (roadMarkIt.weight != "standard")
-                        roadMark.append_attribute("weight").set_value(roadMarkIt.weight.c_str());
-                    if (roadMarkIt.width >= 0)
-                        roadMark.append_attribute("width").set_value(roadMarkIt.width);
-
-                    if (!roadMarkIt.roadmark_lines.empty()) 
+                    w.open("type");
+                    for (const auto& line : roadmark.roadmark_lines)
                     {
-                        auto typeChild = roadMark.append_child("type");
-                        for (auto roadMarkLineIt : roadMarkIt.roadmark_lines)
-                        {
-                            pugi::xml_node roadMarkLine = typeChild.append_child("line");
-                            roadMarkLine.append_attribute("length").set_value(roadMarkLineIt.length);
-                            roadMarkLine.append_attribute("space").set_value(roadMarkLineIt.space);
-                            roadMarkLine.append_attribute("width").set_value(roadMarkLineIt.width);
-                            roadMarkLine.append_attribute("sOffset").set_value(roadMarkLineIt.s_offset);
-                            roadMarkLine.append_attribute("tOffset").set_value(roadMarkLineIt.t_offset);
-                            if (!roadMarkLineIt.rule.empty() != 0)
-                                roadMarkLine.append_attribute("rule").set_value(roadMarkLineIt.rule.c_str());
-                        }
+                        w.open("line")
+                            .attr("length", line.length)
+                            .attr("space", line.space)
+                            .attr("width", line.width)
+                            .attr("sOffset", line.s_offset)
+                            .attr("tOffset", line.t_offset);
+                        if (!line.rule.empty())
+                            w.attr("rule", line.rule);
+                        w.close();
                     }
+                    w.close();
                 }
-                // Missing user data
+                w.close();
             }
+            // Missing user data
+            w.close();
         }
+        if (open_group)
+            w.close();
+        w.close();
+    }
+    w.close();
 
-        // road objects
-        if (!road.id_to_object.empty())
-        {
-            auto objects_node = road_node.append_child("objects");
-            for (const auto& id_object : road.id_to_object)
-            {
-                auto road_object = id_object.second;
-                auto object_node = objects_node.append_child("object");
-                object_node.append_attribute("id").set_value(id_object.first.c_str());
-                object_node.append_attribute("dynamic").set_value(road_object.is_dynamic);
-                object_node.append_attribute("s").set_value(road_object.s0);
-                object_node.append_attribute("t").set_value(road_object.t0);
-                object_node.append_attribute("zOffset").set_value(road_object.z0);
-                object_node.append_attribute("length").set_value(road_object.length);
-                object_node.append_attribute("validLength").set_value(road_object.valid_length);
-                object_node.append_attribute("width").set_value(road_object.width);
-                object_node.append_attribute("radius").set_value(road_object.radius);
-                object_node.append_attribute("height").set_value(road_object.height);
-                object_node.append_attribute("hdg").set_value(road_object.hdg);
-                object_node.append_attribute("pitch").set_value(road_object.pitch);
-                object_node.append_attribute("roll").set_value(road_object.roll);
-                object_node.append_attribute("type").set_value(road_object.type.c_str());
-                object_node.append_attribute("name").set_value(road_object.name.c_str());
-                object_node.append_attribute("orientation").set_value(road_object.hdg);
-                object_node.append_attribute("subtype").set_value(road_object.subtype.c_str());
-                // currently no repeat or outline child
-            }
-        }
-        
-        pugi::xml_node customProfile = road_node.append_child("roadRunnerProfile");
-        if (!road.rr_profile.leftPlans.empty()) 
-        {
-            pugi::xml_node customLeft = customProfile.append_child("left");
-            for (auto customProfile : road.rr_profile.leftPlans)
-            {
-                pugi::xml_node section = customLeft.append_child("section");
-                section.append_attribute("type_s").set_value(customProfile.first);
-                section.append_attribute("laneCount").set_value(customProfile.second.laneCount);
-                section.append_attribute("offsetX2").set_value(customProfile.second.offsetx2);
-            }
-        }
-        if (!road.rr_profile.rightPlans.empty()) 
+    // road objects
+    if (!road.id_to_object.empty())
+    {
+        w.open("objects");
+        for (const auto& id_object : road.id_to_object)
         {
-            pugi::xml_node customRight = customProfile.append_child("right");
-            for (auto customProfile : road.rr_profile.rightPlans) 
-            {
-                pugi::xml_node section = customRight.append_child("section");
-                section.append_attribute("type_s").set_value(customProfile.first);
-                section.append_attribute("laneCount").set_value(customProfile.second.laneCount);
-                section.append_attribute("offsetX2").set_value(customProfile.second.offsetx2);
-            }
+            const RoadObject& road_object = id_object.second;
+            w.open("object")
+                .attr("id", id_object.first)
+                .attr("dynamic", road_object.is_dynamic)
+                .attr("s", road_object.s0)
+                .attr("t", road_object.t0)
+                .attr("zOffset", road_object.z0)
+                .attr("length", road_object.length)
+                .attr("validLength", road_object.valid_length)
+                .attr("width", road_object.width)
+                .attr("radius", road_object.radius)
+                .attr("height", road_object.height)
+                .attr("hdg", road_object.hdg)
+                .attr("pitch", road_object.pitch)
+                .attr("roll", road_object.roll)
+                .attr("type", road_object.type)
+                .attr("name", road_object.name)
+                .attr("orientation", road_object.hdg)
+                .attr("subtype", road_object.subtype);
+            // currently no repeat or outline child
+            w.close();
         }
+        w.close();
+    }
 
-        if (!road.boundaryHide.empty())
+    w.open("roadRunnerProfile");
+    for (const int side : {1, -1})
+    {
+        const auto& plans = side > 0 ? road.rr_profile.leftPlans : road.rr_profile.rightPlans;
+        if (plans.empty())
+            continue;
+        w.open(side > 0 ? "left" : "right");
+        for (const auto& s_plan : plans)
         {
-            pugi::xml_node customBoundaryHide = road_node.append_child("roadRunnerBoundaryHide");
-            for (auto boundary_length : road.boundaryHide)
-            {
-                auto           boundary = boundary_length.first;
-                pugi::xml_node hideDetail = customBoundaryHide.append_child("hide");
-                hideDetail.append_attribute("contactPoint").set_value(
-                    boundary.first == odr::RoadLink::ContactPoint_Start ? "start" : "end");
-                hideDetail.append_attribute("side").set_value(boundary.second == -1 ? "right" : "left");
-                hideDetail.append_attribute("s").set_value(boundary_length.second);
-            }
+            w.open("section")
+                .attr("type_s", static_cast<unsigned>(s_plan.first))
+                .attr("laneCount", static_cast<int>(s_plan.second.laneCount))
+                .attr("offsetX2", static_cast<int>(s_plan.second.offsetx2));
+            w.close();
         }
+        w.close();
     }
+    w.close();
 
-    for (auto j : get_junctions()) 
+    if (!road.boundaryHide.empty())
     {
-        pugi::xml_node junction = main.append_child("junction");
-        junction.append_attribute("id").set_value(j.id.c_str());
-        junction.append_attribute("name").set_value(j.name.c_str());
-        if (j.type == JunctionType::Direct) 
+        w.open("roadRunnerBoundaryHide");
+        for (const auto& boundary_length : road.boundaryHide)
         {
-            junction.append_attribute("type").set_value("direct");   
+            const auto& boundary = boundary_length.first;
+            w.open("hide")
+                .attr("contactPoint", boundary.first == RoadLink::ContactPoint_Start ? "start" : "end")
+                .attr("side", boundary.second == -1 ? "right" : "left")
+                .attr("s", boundary_length.second);
+            w.close();
         }
-        for (auto c : j.id_to_connection) 
-        {
-            auto connection = junction.append_child("connection");
-            connection.append_attribute("id").set_value(c.first.c_str());
-
-            std::string incomingRoad = c.second.incoming_road;
-            if (incomingRoad.size() > 0)
-                connection.append_attribute("incomingRoad").set_value(incomingRoad.c_str());
-            connection.append_attribute(j.type == JunctionType::Common ? "connectingRoad" : "linkedRoad").set_value(c.second.connecting_road.c_str());
+        w.close();
+    }
 
-            std::string contectPoint;
-            switch (c.second.contact_point)
-            {
-            case odr::JunctionConnection::ContactPoint_Start:
-                contectPoint = "start";
-                break;
-            case odr::JunctionConnection::ContactPoint_End:
-                contectPoint = "end";
-                break;
-            default:
-                break;
-            }
-            if (!contectPoint.empty())
-                connection.append_attribute("contactPoint").set_value(contectPoint.c_str());
+    w.close();
+    return out;
+}
 
-            std::string interfaceProviderContect;
-            switch (c.second.interface_provider_contact)
-            {
-            case odr::JunctionConnection::ContactPoint_Start:
-                interfaceProviderContect = "start";
-                break;
-            case odr::JunctionConnection::ContactPoint_End:
-                interfaceProviderContect = "end";
-                break;
-            default:
-                break;
-            }
-            if (!interfaceProviderContect.empty())
-                connection.append_attribute("interfaceProviderContactPoint").set_value(interfaceProviderContect.c_str());
+std::string OpenDriveMap::junction_to_xml(const Junction& j) const
+{
+    std::string   out;
+    XmlTextWriter w(out, 1);
 
-            for (auto p: c.second.signalPhases)
-            {
-                connection.append_child("signalPhase").append_attribute("id").set_value(p);
-            }
+    w.open("junction").attr("id", j.id).attr("name", j.name);
+    if (j.type == JunctionType::Direct)
+        w.attr("type", "direct");
 
-            for (auto ll : c.second.lane_links) 
-            {
-                pugi::xml_node laneLink = connection.append_child("laneLink");
-                laneLink.append_attribute("from").set_value(ll.from);
-                laneLink.append_attribute("to").set_value(ll.to);
-                if (ll.overlapZone > 0)
-                {
-                    laneLink.append_attribute("overlapZone").set_value(ll.overlapZone);
-                }
-            }
+    for (const auto& id_conn : j.id_to_connection)
+    {
+        const JunctionConnection& c = id_conn.second;
+        w.open("connection").attr("id", id_conn.first);
+        if (!c.incoming_road.empty())
+            w.attr("incomingRoad", c.incoming_road);
+        w.attr(j.type == JunctionType::Common ? "connectingRoad" : "linkedRoad", c.connecting_road);
+
+        if (c.contact_point == JunctionConnection::ContactPoint_Start)
+            w.attr("contactPoint", "start");
+        else if (c.contact_point == JunctionConnection::ContactPoint_End)
+            w.attr("contactPoint", "end");
+
+        if (c.interface_provider_contact == JunctionConnection::ContactPoint_Start)
+            w.attr("interfaceProviderContactPoint", "start");
+        else if (c.interface_provider_contact == JunctionConnection::ContactPoint_End)
+            w.attr("interfaceProviderContactPoint", "end");
+
+        for (const int phase : c.signalPhases)
+        {
+            w.open("signalPhase").attr("id", phase);
+            w.close();
         }
 
-        // Modified version based on xodr
-        auto boundary_node = junction.append_child("boundary");
-        for (auto segment : j.boundary)
+        for (const auto& ll : c.lane_links)
         {
-            auto segment_node = boundary_node.append_child("segment");
-            segment_node.append_attribute("roadID").set_value(segment.road.c_str());
-            segment_node.append_attribute("sStart").set_value(segment.sBegin);
-            segment_node.append_attribute("sEnd").set_value(segment.sEnd);
-            segment_node.append_attribute("side").set_value(segment.side > 0 ? "left" : "right");
-            segment_node.append_attribute("type").set_value(segment.type == odr::BoundarySegmentType::Lane ? "lane" : "joint");
+            w.open("laneLink").attr("from", ll.from).attr("to", ll.to);
+            if (ll.overlapZone > 0)
+                w.attr("overlapZone", ll.overlapZone);
+            w.close();
         }
+        w.close();
     }
-    // junctions
-    doc.save_file(fpath.c_str());
-}
 
-void OpenDriveMap::roadNodeToXML(const odr::RoadLink& roadLink, pugi::xml_node& out) const 
-{ 
-    std::string type_s;
-    switch (roadLink.type)
-    {
-    case odr::RoadLink::Type_Road:
-        type_s = "road";
-        break;
-    case odr::RoadLink::Type_Junction:
-        type_s = "junction";
-        break;
-    default:
-        break;
-    }
-    out.append_attribute("elementType").set_value(type_s.c_str());
-    out.append_attribute("elementId").set_value(roadLink.id.c_str());
-    std::string contact_s;
-    switch (roadLink.contact_point)
+    // Modified version based on xodr
+    w.open("boundary");
+    for (const auto& segment : j.boundary)
     {
-    case odr::RoadLink::ContactPoint::ContactPoint_Start:
-        contact_s = "start";
-        break;
-    case odr::RoadLink::ContactPoint::ContactPoint_End:
-        contact_s = "end";
-        break;
-    default:
-        break;
+        w.open("segment")
+            .attr("roadID", segment.road)
+            .attr("sStart", segment.sBegin)
+            .attr("sEnd", segment.sEnd)
+            .attr("side", segment.side > 0 ? "left" : "right")
+            .attr("type", segment.type == BoundarySegmentType::Lane ? "lane" : "joint");
+        w.close();
     }
-    out.append_attribute("contactPoint").set_value(contact_s.c_str());
+    w.close();
+
+    w.close();
+    return out;
 }
 }
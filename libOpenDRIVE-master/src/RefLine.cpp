@@ -3,6 +3,7 @@
 #include "Math.hpp"
 #include "Utils.hpp"
 
+#include <algorithm>
 #include <cmath>
 #include <functional>
 #include <iterator>
@@ -16,6 +17,36 @@ namespace odr
 {
 double RefLine::MinGeoLength = 1e-3f;
 
+namespace
+{
+/* Newton from s towards the nearest point on ref_line, kept within [s_lo, s_hi] */
+double refine_nearest(const RefLine& ref_line, const Vec2D& xy, double s, const double s_lo, const double s_hi, double& out_dist)
+{
+    /* Newton on (p(s) - xy) . T(s), T the unit tangent: derivative 1 + (p - xy) . T'.
+       Gauss-Newton step where that is not positive, beyond the center of curvature. */
+    const double h = 1e-4;
+    for (int iter = 0; iter < 8; iter++)
+    {
+        const RoadGeometry* geom = ref_line.get_geometry(s);
+        const Vec2D         offset = sub(geom->get_xy(s), xy);
+        const Vec2D         tangent = normalize(geom->get_grad(s));
+        const double        s_near = s + h <= s_hi ? s + h : s - h;
+        const Vec2D         tangent_near = normalize(ref_line.get_geometry(s_near)->get_grad(s_near));
+        const double        curving = dot(offset, sub(tangent_near, tangent)) / (s_near - s);
+
+        const double g = dot(offset, tangent);
+        const double g_prime = 1 + curving > 0 ? 1 + curving : 1;
+        const double s_next = std::min(std::max(s - g / g_prime, s_lo), s_hi);
+        const double step = std::abs(s_next - s);
+        s = s_next;
+        if (step < 1e-9)
+            break;
+    }
+    out_dist = euclDistance(xy, ref_line.get_geometry(s)->get_xy(s));
+    return s;
+}
+} // namespace
+
 RefLine::RefLine(std::string road_id, double length) : road_id(road_id), length(length) {}
 
 RefLine::RefLine(const RefLine& other) : road_id(other.road_id), length(other.length), elevation_profile(other.elevation_profile)
@@ -200,6 +231,42 @@ Vec3D RefLine::get_xyz(const double s, const double t) const
     return Vec3D{pt_xy[0], pt_xy[1], this->elevation_profile.get(s)};
 }
 
+void RefLine::get_xyz(const std::vector<double>& s_vals, Line3D& xyz_out, std::vector<Vec3D>* grad_out) const
+{
+    const std::size_t n = s_vals.size();
+    std::vector<Vec2D> xy(n, Vec2D{0, 0});
+    std::vector<Vec2D> grad_xy(n, Vec2D{0, 0});
+    std::vector<double> z(n), grad_z(n);
+
+    // hand each run of s values within one geometry to it at once
+    for (std::size_t begin = 0; begin < n && !this->s0_to_geometry.empty();)
+    {
+        auto geom_iter = this->s0_to_geometry.upper_bound(s_vals[begin]);
+        auto next_geom_iter = geom_iter;
+        if (geom_iter != this->s0_to_geometry.begin())
+            geom_iter--;
+
+        std::size_t end = begin + 1;
+        while (end < n && s_vals[end] >= s_vals[end - 1] &&
+               (next_geom_iter == this->s0_to_geometry.end() || s_vals[end] < next_geom_iter->first))
+            end++;
+
+        geom_iter->second->get_xy_grad(s_vals.data() + begin, end - begin, xy.data() + begin, grad_out ? grad_xy.data() + begin : nullptr);
+        begin = end;
+    }
+    this->elevation_profile.get(s_vals.data(), n, z.data(), grad_out ? grad_z.data() : nullptr);
+
+    xyz_out.resize(n);
+    for (std::size_t i = 0; i < n; i++)
+        xyz_out[i] = Vec3D{xy[i][0], xy[i][1], z[i]};
+    if (grad_out)
+    {
+        grad_out->resize(n);
+        for (std::size_t i = 0; i < n; i++)
+            (*grad_out)[i] = Vec3D{grad_xy[i][0], grad_xy[i][1], grad_z[i]};
+    }
+}
+
 Vec2D RefLine::get_grad_xy(const double s) const 
 {
     const RoadGeometry* geom = this->get_geometry(s);
@@ -227,14 +294,81 @@ double RefLine::get_hdg(const double s) const
 
 double RefLine::match(const double x, const double y) const
 {
-    std::function<double(double)> f_dist = [&](const double s)
+    /* one-off query, so no RefLineIndex: every point of the line is within Step / 2 of a sample,
+       thus the nearest point lies next to a locally nearest sample at most best + Step / 2 away.
+       One pass: the best sample so far only shrinks, so local minima it rules out stay ruled out */
+    const double Step = 1;
+    if (this->s0_to_geometry.empty())
+        return 0;
+
+    const Vec2D       xy{x, y};
+    const std::size_t num_steps = static_cast<std::size_t>(std::ceil(this->length / Step));
+
+    double best_sample = std::numeric_limits<double>::infinity();
+    double best_s = 0;
+    double best_dist = std::numeric_limits<double>::infinity();
+    auto   consider = [&](const std::size_t i, const double prev_dist, const double dist, const double next_dist)
     {
-        const Vec3D pt = this->get_xyz(s);
-        return euclDistance(Vec2D{pt[0], pt[1]}, {x, y});
+        best_sample = std::min(best_sample, dist);
+        /* refining within Step of sample i cannot get closer than dist - Step */
+        if (dist > prev_dist || dist > next_dist || dist > best_sample + Step / 2 || dist - Step >= best_dist)
+            return;
+
+        double       refined_dist;
+        const double s = refine_nearest(*this,
+                                        xy,
+                                        std::min(i * Step, this->length),
+                                        i == 0 ? 0 : (i - 1) * Step,
+                                        std::min((i + 1) * Step, this->length),
+                                        refined_dist);
+        if (refined_dist < best_dist)
+        {
+            best_dist = refined_dist;
+            best_s = s;
+        }
     };
-    return golden_section_search<double>(f_dist, 0.0, length, 1e-2);
+
+    /* sample in stack-sized chunks, handing each run within one geometry to it at once */
+    constexpr std::size_t Chunk = 64;
+    double                s_chunk[Chunk];
+    Vec2D                 xy_chunk[Chunk];
+    auto                  geom_iter = this->s0_to_geometry.begin();
+    double                prev_dist = std::numeric_limits<double>::infinity();
+    double                dist = std::numeric_limits<double>::infinity();
+    for (std::size_t chunk_begin = 0; chunk_begin <= num_steps; chunk_begin += Chunk)
+    {
+        const std::size_t count = std::min(Chunk, num_steps + 1 - chunk_begin);
+        for (std::size_t k = 0; k < count; k++)
+            s_chunk[k] = std::min((chunk_begin + k) * Step, this->length);
+
+        for (std::size_t begin = 0; begin < count;)
+        {
+            for (auto next = std::next(geom_iter); next != this->s0_to_geometry.end() && next->first <= s_chunk[begin]; next = std::next(geom_iter))
+                geom_iter = next;
+            const auto  next_geom_iter = std::next(geom_iter);
+            std::size_t end = begin + 1;
+            while (end < count && (next_geom_iter == this->s0_to_geometry.end() || s_chunk[end] < next_geom_iter->first))
+                end++;
+
+            geom_iter->second->get_xy_grad(s_chunk + begin, end - begin, xy_chunk + begin, nullptr);
+            begin = end;
+        }
+
+        for (std::size_t k = 0; k < count; k++)
+        {
+            const double next_dist = euclDistance(xy, xy_chunk[k]);
+            if (chunk_begin + k != 0)
+                consider(chunk_begin + k - 1, prev_dist, dist, next_dist);
+            prev_dist = dist;
+            dist = next_dist;
+        }
+    }
+    consider(num_steps, prev_dist, dist, std::numeric_limits<double>::infinity());
+    return best_s;
 }
 
+std::vector<Vec2D> RefLine::match(const std::vector<Vec2D>& xy) const { return RefLineIndex(*this).project(xy); }
+
 Line3D RefLine::get_line(const double s_start, const double s_end, const double eps) const
 {
     std::set<double> s_vals = this->approximate_linear(eps, s_start, s_end);
@@ -283,4 +417,157 @@ std::set<double> RefLine::approximate_linear(const double eps, const double s_st
     return s_vals_set;
 }
 
-} // namespace odr
\ No newline at end of file
+RefLineIndex::RefLineIndex(const RefLine& ref_line, const double eps) : ref_line(&ref_line), eps(eps)
+{
+    const std::set<double> s_set = ref_line.approximate_linear(eps, 0, ref_line.length);
+    this->s_vals.assign(s_set.begin(), s_set.end());
+
+    Line3D xyz;
+    ref_line.get_xyz(this->s_vals, xyz);
+    this->pts.reserve(xyz.size());
+    for (const Vec3D& pt : xyz)
+        this->pts.push_back(Vec2D{pt[0], pt[1]});
+
+    if (this->pts.size() >= 2)
+        this->build(0, static_cast<std::uint32_t>(this->pts.size() - 1));
+}
+
+std::int32_t RefLineIndex::build(const std::uint32_t begin, const std::uint32_t end)
+{
+    const std::uint32_t LeafSize = 4;
+
+    const std::int32_t idx = static_cast<std::int32_t>(this->nodes.size());
+    this->nodes.push_back(Node{this->pts[begin], this->pts[begin], begin, end, -1, -1});
+    for (std::uint32_t i = begin + 1; i <= end; i++)
+    {
+        for (std::size_t dim = 0; dim < 2; dim++)
+        {
+            this->nodes[idx].min[dim] = std::min(this->nodes[idx].min[dim], this->pts[i][dim]);
+            this->nodes[idx].max[dim] = std::max(this->nodes[idx].max[dim], this->pts[i][dim]);
+        }
+    }
+
+    /* consecutive segments stay close, so halving the range keeps boxes tight */
+    if (end - begin > LeafSize)
+    {
+        const std::uint32_t mid = begin + (end - begin) / 2;
+        const std::int32_t  left = this->build(begin, mid);
+        const std::int32_t  right = this->build(mid, end);
+        this->nodes[idx].left = left;
+        this->nodes[idx].right = right;
+    }
+    return idx;
+}
+
+Vec2D RefLineIndex::project(const Vec2D& xy, const double s_min, const double s_max) const
+{
+    if (this->nodes.empty())
+        return Vec2D{0, 0};
+
+    struct Candidate
+    {
+        std::uint32_t segment;
+        double        s;
+        double        dist;
+    };
+
+    auto box_dist = [&xy](const Node& node)
+    {
+        const double dx = std::max({node.min[0] - xy[0], 0.0, xy[0] - node.max[0]});
+        const double dy = std::max({node.min[1] - xy[1], 0.0, xy[1] - node.max[1]});
+        return std::sqrt(dx * dx + dy * dy);
+    };
+
+    /* nearer child first; any segment within eps of the polyline nearest may hold the exact nearest */
+    std::vector<Candidate> candidates;
+    double                 best = std::numeric_limits<double>::infinity();
+    std::int32_t           stack[64];
+    int                    stack_size = 0;
+    stack[stack_size++] = 0;
+    while (stack_size != 0)
+    {
+        const Node& node = this->nodes[stack[--stack_size]];
+        if (this->s_vals[node.end] < s_min || this->s_vals[node.begin] > s_max || box_dist(node) > best + this->eps)
+            continue;
+
+        if (node.left != -1)
+        {
+            const bool left_first = box_dist(this->nodes[node.left]) <= box_dist(this->nodes[node.right]);
+            stack[stack_size++] = left_first ? node.right : node.left;
+            stack[stack_size++] = left_first ? node.left : node.right;
+            continue;
+        }
+
+        for (std::uint32_t i = node.begin; i < node.end; i++)
+        {
+            const double s1 = std::max(this->s_vals[i], s_min);
+            const double s2 = std::min(this->s_vals[i + 1], s_max);
+            if (s1 > s2)
+                continue;
+
+            const Vec2D  seg = sub(this->pts[i + 1], this->pts[i]);
+            const double seg_len_sq = dot(seg, seg);
+            const double seg_s_len = this->s_vals[i + 1] - this->s_vals[i];
+            double       frac = seg_len_sq > 0 ? dot(sub(xy, this->pts[i]), seg) / seg_len_sq : 0;
+            frac = std::min(std::max(frac, (s1 - this->s_vals[i]) / seg_s_len), (s2 - this->s_vals[i]) / seg_s_len);
+
+            const double dist = euclDistance(xy, add(this->pts[i], mut(frac, seg)));
+            if (dist <= best + this->eps)
+                candidates.push_back(Candidate{i, this->s_vals[i] + frac * seg_s_len, dist});
+            best = std::min(best, dist);
+        }
+    }
+
+    /* refine once per run of neighboring segments, from its nearest polyline point */
+    std::sort(candidates.begin(), candidates.end(), [](const Candidate& a, const Candidate& b) { return a.segment < b.segment; });
+    /* no segment in the window: it lies past an end of the ref line, or s_min > s_max */
+    double best_s = std::min(std::max(s_min, 0.0), this->ref_line->length);
+    double best_dist = std::numeric_limits<double>::infinity();
+    for (std::size_t run_begin = 0; run_begin < candidates.size();)
+    {
+        std::size_t run_end = run_begin + 1;
+        std::size_t nearest = run_begin;
+        while (run_end < candidates.size() && candidates[run_end].segment <= candidates[run_end - 1].segment + 1)
+        {
+            if (candidates[run_end].dist < candidates[nearest].dist)
+                nearest = run_end;
+            run_end++;
+        }
+
+        if (candidates[nearest].dist <= best + this->eps)
+        {
+            const std::uint32_t lo = candidates[run_begin].segment == 0 ? 0 : candidates[run_begin].segment - 1;
+            const std::uint32_t hi = std::min<std::uint32_t>(candidates[run_end - 1].segment + 2, this->s_vals.size() - 1);
+            double              dist;
+            const double        s = refine_nearest(
+                *this->ref_line, xy, candidates[nearest].s, std::max(this->s_vals[lo], s_min), std::min(this->s_vals[hi], s_max), dist);
+            if (dist < best_dist)
+            {
+                best_dist = dist;
+                best_s = s;
+            }
+        }
+        run_begin = run_end;
+    }
+
+    const Vec3D pt = this->ref_line->get_xyz(best_s);
+    const Vec2D dir = normalize(this->ref_line->get_grad_xy(best_s));
+    return Vec2D{best_s, crossProduct(dir, sub(xy, Vec2D{pt[0], pt[1]}))};
+}
+
+std::vector<Vec2D> RefLineIndex::project(const std::vector<Vec2D>& xy) const
+{
+    const std::size_t  ChunkSize = 64;
+    std::vector<Vec2D> st(xy.size());
+    const std::size_t  num_chunks = (xy.size() + ChunkSize - 1) / ChunkSize;
+    parallel_for(num_chunks,
+                 get_worker_count(num_chunks, 0),
+                 [&](const std::size_t chunk, const std::size_t)
+                 {
+                     for (std::size_t i = chunk * ChunkSize; i < std::min(xy.size(), (chunk + 1) * ChunkSize); i++)
+                         st[i] = this->project(xy[i]);
+                 });
+    return st;
+}
+
+} // namespace odr
@@ -77,7 +77,7 @@ double Road::get_lanesection_s0(const double s) const
     return lanesec.s0;
 }
 
-LaneSection Road::get_lanesection(const double s) const
+const LaneSection& Road::get_lanesection(const double s) const
 {
     const double lanesec_s0 = this->get_lanesection_s0(s);
     if (std::isnan(lanesec_s0))
@@ -132,7 +132,18 @@ Vec3D Road::get_xyz(double s, const double t, const double h, Vec3D* _e_s, Vec3D
         xtra = s - length; // xtra > 0
         s = length;
     }
-    const Vec3D  s_vec = this->ref_line.get_grad(s);
+    Vec3D e_s;
+    Vec3D xyz = this->get_xyz(s, t, h, this->ref_line.get_xyz(s), this->ref_line.get_grad(s), &e_s, _e_t, _e_h);
+    xyz = odr::add(xyz, odr::mut(xtra, e_s));
+
+    if (_e_s)
+        *_e_s = e_s;
+
+    return xyz;
+}
+
+Vec3D Road::get_xyz(double s, const double t, const double h, const Vec3D& p0, const Vec3D& s_vec, Vec3D* _e_s, Vec3D* _e_t, Vec3D* _e_h) const
+{
     const double theta = this->superelevation.get(s);
 
     const Vec3D e_s = normalize(s_vec);
@@ -140,11 +151,9 @@ Vec3D Road::get_xyz(double s, const double t, const double h, Vec3D* _e_s, Vec3D
                                       std::cos(theta) * e_s[0] + std::sin(theta) * -e_s[2] * e_s[1],
                                       std::sin(theta) * (e_s[0] * e_s[0] + e_s[1] * e_s[1])});
     const Vec3D e_h = normalize(crossProduct(s_vec, e_t));
-    const Vec3D p0 = this->ref_line.get_xyz(s);
     const Mat3D trans_mat{{{e_t[0], e_h[0], p0[0]}, {e_t[1], e_h[1], p0[1]}, {e_t[2], e_h[2], p0[2]}}};
 
-    Vec3D xyz = MatVecMultiplication(trans_mat, Vec3D{t, h, 1});
-    xyz = odr::add(xyz, odr::mut(xtra, e_s));
+    const Vec3D xyz = MatVecMultiplication(trans_mat, Vec3D{t, h, 1});
 
     if (_e_s)
         *_e_s = e_s;
@@ -164,8 +173,8 @@ Vec2D Road::get_boundary_xy(int side, double s) const
 
 Vec3D Road::get_boundary_xyz(int side, double s) const
 {
-    auto   laneSection = get_lanesection(s);
-    double t = lane_offset.get(s);
+    const auto& laneSection = get_lanesection(s);
+    double      t = lane_offset.get(s);
     if (side < 0)
     {
         auto rightMost = laneSection.id_to_lane.begin();
@@ -186,6 +195,13 @@ Vec3D Road::get_boundary_xyz(int side, double s) const
 }
 
 Vec3D Road::get_surface_pt(double s, const double t, Vec3D* vn) const
+{
+    CHECK_AND_REPAIR(s >= 0, "s < 0", s = 0);
+    CHECK_AND_REPAIR(s <= this->length, "s > Road::length", s = this->length);
+    return this->get_surface_pt(s, t, this->ref_line.get_xyz(s), this->ref_line.get_grad(s), vn);
+}
+
+Vec3D Road::get_surface_pt(double s, const double t, const Vec3D& ref_pt, const Vec3D& ref_grad, Vec3D* vn) const
 {
     CHECK_AND_REPAIR(s >= 0, "s < 0", s = 0);
     CHECK_AND_REPAIR(s <= this->length, "s > Road::length", s = this->length);
@@ -239,7 +255,7 @@ Vec3D Road::get_surface_pt(double s, const double t, Vec3D* vn) const
         }
     }
 
-    return this->get_xyz(s, t, h_t, nullptr, nullptr, vn);
+    return this->get_xyz(s, t, h_t, ref_pt, ref_grad, nullptr, nullptr, vn);
 }
 
 std::vector<std::pair<double, double>> Road::sample_st(double sBegin, double sEnd, double interval) const 
@@ -251,9 +267,9 @@ std::vector<std::pair<double, double>> Road::sample_st(double sBegin, double sEn
     }
     for (auto s : odr::xrange(sBegin, sEnd - 0.01, interval)) 
     {
-        auto   laneSection = get_lanesection(s);
-        double tmin = lane_offset.get(s);
-        double tmax = tmin;
+        const auto& laneSection = get_lanesection(s);
+        double      tmin = lane_offset.get(s);
+        double      tmax = tmin;
         if (laneSection.id_to_lane.begin()->first < 0) 
         {
             // has right lane
@@ -303,14 +319,18 @@ std::set<double> Road::approximate_lane_border_linear(const Lane& lane, const do
 
 Line3D Road::get_lane_border_line(const Lane& lane, const double s_start, const double s_end, const double eps, const bool outer) const
 {
-    std::set<double> s_vals = this->approximate_lane_border_linear(lane, s_start, s_end, eps, outer);
+    const std::set<double>    s_set = this->approximate_lane_border_linear(lane, s_start, s_end, eps, outer);
+    const std::vector<double> s_vals(s_set.begin(), s_set.end());
+    Line3D                    ref_pts;
+    std::vector<Vec3D>        ref_grads;
+    this->ref_line.get_xyz(s_vals, ref_pts, &ref_grads);
+
+    std::vector<double> t_vals(s_vals.size());
+    (outer ? lane.outer_border : lane.inner_border).get(s_vals.data(), s_vals.size(), t_vals.data(), nullptr);
 
     Line3D border_line;
-    for (const double& s : s_vals)
-    {
-        const double t = outer ? lane.outer_border.get(s) : lane.inner_border.get(s);
-        border_line.push_back(this->get_surface_pt(s, t));
-    }
+    for (std::size_t i = 0; i < s_vals.size(); i++)
+        border_line.push_back(this->get_surface_pt(s_vals[i], t_vals[i], ref_pts[i], ref_grads[i]));
 
     return border_line;
 }
@@ -331,16 +351,18 @@ Line3D Road::get_lane_center_line(const LaneKey& laneKey, const double travelSBe
         sEndOnRoad = lanesection_s1 - travelSBegin;
     }
 
-    const auto lane = s_to_lanesection.at(laneKey.lanesection_s0).id_to_lane.at(laneKey.lane_id);
+    const auto& lane = s_to_lanesection.at(laneKey.lanesection_s0).id_to_lane.at(laneKey.lane_id);
 
-    std::set<double> s_vals = this->approximate_lane_border_linear(lane, sBeginOnRoad, sEndOnRoad, eps, true);
+    const std::set<double>    s_set = this->approximate_lane_border_linear(lane, sBeginOnRoad, sEndOnRoad, eps, true);
+    const std::vector<double> s_vals(s_set.begin(), s_set.end());
+    std::vector<double>       t_inner(s_vals.size()), t_outer(s_vals.size());
+    lane.inner_border.get(s_vals.data(), s_vals.size(), t_inner.data(), nullptr);
+    lane.outer_border.get(s_vals.data(), s_vals.size(), t_outer.data(), nullptr);
 
     Line3D center_line;
-    for (const double& s : s_vals)
+    for (std::size_t i = 0; i < s_vals.size(); i++)
     {
-        const double tInner = lane.inner_border.get(s);
-        const double tOuter = lane.outer_border.get(s);
-        center_line.push_back(this->get_surface_pt(s, (tInner + tOuter) / 2));
+        center_line.push_back(this->get_surface_pt(s_vals[i], (t_inner[i] + t_outer[i]) / 2));
     }
     return center_line;
 }
@@ -358,12 +380,19 @@ void Road::get_lane_border_line(
         s_vals_out.insert(v);
     }
 
-    for (const double& s : s_vals_out)
+    const std::vector<double> s_vals(s_vals_out.begin(), s_vals_out.end());
+    Line3D                    ref_pts;
+    std::vector<Vec3D>        ref_grads;
+    this->ref_line.get_xyz(s_vals, ref_pts, &ref_grads);
+
+    std::vector<double> t_inner(s_vals.size()), t_outer(s_vals.size());
+    lane.inner_border.get(s_vals.data(), s_vals.size(), t_inner.data(), nullptr);
+    lane.outer_border.get(s_vals.data(), s_vals.size(), t_outer.data(), nullptr);
+
+    for (std::size_t i = 0; i < s_vals.size(); i++)
     {
-        double tOut = lane.outer_border.get(s);
-        double tIn = lane.inner_border.get(s);
-        outerOut.push_back(this->get_surface_pt(s, tOut));
-        innerOut.push_back(this->get_surface_pt(s, tIn));
+        outerOut.push_back(this->get_surface_pt(s_vals[i], t_outer[i], ref_pts[i], ref_grads[i]));
+        innerOut.push_back(this->get_surface_pt(s_vals[i], t_inner[i], ref_pts[i], ref_grads[i]));
     }
 }
 
@@ -405,8 +434,7 @@ Line3D Road::get_side_border_line(const int8_t side, const double s_start, const
         }
 
         const auto& section = s_and_section->second;
-        const auto& lanes = section.get_sorted_driving_lanes(side);
-        const auto  lane = outer ? lanes.back() : lanes.front();
+        const auto& lane = *section.get_driving_lane(side, outer);
         auto section_border = get_lane_border_line(lane, s_start_section, s_end_section, eps, outer);
 
         if (side < 0) 
@@ -430,7 +458,7 @@ std::pair<Line3D, Line3D> Road::get_both_dirs_poly(const double s_start, const d
 {
     const auto& firstSection = s_to_lanesection.begin()->second;
     Line3D      left, right;
-    if (!firstSection.get_sorted_driving_lanes(1).empty())
+    if (firstSection.get_driving_lane(1, false) != nullptr)
     {
         // Has left side
         left = get_side_border_line(1, s_start, s_end, false, eps);
@@ -438,7 +466,7 @@ std::pair<Line3D, Line3D> Road::get_both_dirs_poly(const double s_start, const d
         left.insert(left.end(), leftBack.rbegin(), leftBack.rend());
         if (!left.empty()) left.push_back(left.front());
     }
-    if (!firstSection.get_sorted_driving_lanes(-1).empty())
+    if (firstSection.get_driving_lane(-1, false) != nullptr)
     {
         // Has right side
         right = get_side_border_line(-1, s_start, s_end, false, eps);
@@ -454,7 +482,7 @@ Line3D Road::get_road_boundary(int side, const double eps) const
 { 
     const auto& firstSection = s_to_lanesection.begin()->second;
 
-    if (!firstSection.get_sorted_driving_lanes(side).empty()) 
+    if (firstSection.get_driving_lane(side, false) != nullptr) 
     {
         // Has side
         auto rtn = get_side_border_line(side, 0, length, true, eps);
@@ -517,18 +545,28 @@ Mesh3D Road::get_lane_mesh(const Lane& lane, const double s_start, const double
             s_iter++;
     }
 
+    const std::vector<double> s_vec(s_vals.begin(), s_vals.end());
+    Line3D                    ref_pts;
+    std::vector<Vec3D>        ref_grads;
+    this->ref_line.get_xyz(s_vec, ref_pts, &ref_grads);
+
+    std::vector<double> t_inner(s_vec.size()), t_outer(s_vec.size());
+    lane.inner_border.get(s_vec.data(), s_vec.size(), t_inner.data(), nullptr);
+    lane.outer_border.get(s_vec.data(), s_vec.size(), t_outer.data(), nullptr);
+
     Mesh3D out_mesh;
-    for (const double& s : s_vals)
+    for (std::size_t i = 0; i < s_vec.size(); i++)
     {
+        const double s = s_vec[i];
         Vec3D        vn_inner_brdr{0, 0, 0};
-        const double t_inner_brdr = lane.inner_border.get(s);
-        out_mesh.vertices.push_back(this->get_surface_pt(s, t_inner_brdr, &vn_inner_brdr));
+        const double t_inner_brdr = t_inner[i];
+        out_mesh.vertices.push_back(this->get_surface_pt(s, t_inner_brdr, ref_pts[i], ref_grads[i], &vn_inner_brdr));
         out_mesh.normals.push_back(vn_inner_brdr);
         out_mesh.st_coordinates.push_back({s, t_inner_brdr});
 
         Vec3D        vn_outer_brdr{0, 0, 0};
-        const double t_outer_brdr = lane.outer_border.get(s);
-        out_mesh.vertices.push_back(this->get_surface_pt(s, t_outer_brdr, &vn_outer_brdr));
+        const double t_outer_brdr = t_outer[i];
+        out_mesh.vertices.push_back(this->get_surface_pt(s, t_outer_brdr, ref_pts[i], ref_grads[i], &vn_outer_brdr));
         out_mesh.normals.push_back(vn_outer_brdr);
         out_mesh.st_coordinates.push_back({s, t_outer_brdr});
     }
@@ -561,13 +599,17 @@ Mesh3D Road::get_lane_mesh(const Lane& lane, const double eps, std::vector<uint3
 
 Mesh3D Road::get_roadmark_mesh(const Lane& lane, const RoadMark& roadmark, const double eps) const
 {
-    const std::set<double> s_vals = this->approximate_lane_border_linear(lane, roadmark.s_start, roadmark.s_end, eps, true);
+    const std::set<double>    s_set = this->approximate_lane_border_linear(lane, roadmark.s_start, roadmark.s_end, eps, true);
+    const std::vector<double> s_vals(s_set.begin(), s_set.end());
+    std::vector<double>       t_outer(s_vals.size());
+    lane.outer_border.get(s_vals.data(), s_vals.size(), t_outer.data(), nullptr);
 
     Mesh3D out_mesh;
-    for (const double& s : s_vals)
+    for (std::size_t i = 0; i < s_vals.size(); i++)
     {
+        const double s = s_vals[i];
         Vec3D        vn_edge_a{0, 0, 0};
-        const double t_edge_a = lane.outer_border.get(s) + roadmark.width * 0.5 + roadmark.t_offset;
+        const double t_edge_a = t_outer[i] + roadmark.width * 0.5 + roadmark.t_offset;
         out_mesh.vertices.push_back(this->get_surface_pt(s, t_edge_a, &vn_edge_a));
         out_mesh.normals.push_back(vn_edge_a);
 
@@ -0,0 +1,35 @@
+#include "allocation_counter.h"
+
+#include <cstdlib>
+#include <new>
+
+namespace AllocationCounter
+{
+    std::atomic<bool> enabled{ false };
+    std::atomic<size_t> count{ 0 };
+    std::atomic<size_t> bytes{ 0 };
+}
+
+void* operator new(std::size_t size)
+{
+    if (AllocationCounter::enabled)
+    {
+        ++AllocationCounter::count;
+        AllocationCounter::bytes += size;
+    }
+    if (void* p = std::malloc(size == 0 ? 1 : size))
+    {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept
+{
+    std::free(p);
+}
+
+void operator delete(void* p, std::size_t) noexcept
+{
+    std::free(p);
+}
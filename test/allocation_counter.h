@@ -0,0 +1,13 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+
+// Counts heap allocations while AllocationCounter::enabled is set.
+// The global operator new feeding it is defined in allocation_counter.cpp.
+namespace AllocationCounter
+{
+    extern std::atomic<bool> enabled;
+    extern std::atomic<size_t> count;
+    extern std::atomic<size_t> bytes;
+}
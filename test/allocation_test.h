@@ -0,0 +1,255 @@
+#include <gtest/gtest.h>
+
+#include "randomization_utils.h"
+#include "allocation_counter.h"
+#include "xodr/road.h"
+
+#include "OpenDriveMap.h"
+#include "Geometries/Line.h"
+#include "Geometries/Arc.h"
+#include "Geometries/Spiral.h"
+
+#include <cmath>
+
+namespace LTest
+{
+    template<typename F>
+    size_t AllocationsDuring(F&& f)
+    {
+        AllocationCounter::count = 0;
+        AllocationCounter::enabled = true;
+        f();
+        AllocationCounter::enabled = false;
+        return AllocationCounter::count;
+    }
+
+    // Total size of heap allocations made by f, freed or not
+    template<typename F>
+    size_t AllocatedBytesDuring(F&& f)
+    {
+        AllocationCounter::bytes = 0;
+        AllocationsDuring(f);
+        return AllocationCounter::bytes;
+    }
+
+    // Per-point queries of border sampling and vehicle stepping read lane sections in place
+    void VerifyZeroCopyQueries(const odr::Road& road)
+    {
+        const double Step = 0.25;
+        double checksum = 0;
+        size_t n = 0;
+
+        n = AllocationsDuring([&]() {
+            for (double s = 0; s <= road.length; s += Step)
+            {
+                const auto& section = road.get_lanesection(s);
+                checksum += section.s0 + section.id_to_lane.size();
+            }
+        });
+        EXPECT_EQ(n, 0) << "get_lanesection";
+
+        n = AllocationsDuring([&]() {
+            for (double s = 0; s <= road.length; s += Step)
+            {
+                const auto& section = road.get_lanesection(s);
+                const double tMin = section.id_to_lane.begin()->second.outer_border.get(s);
+                const double tMax = section.id_to_lane.rbegin()->second.outer_border.get(s);
+                for (double t = tMin - 1; t <= tMax + 1; t += Step)
+                {
+                    checksum += section.get_lane_id(s, t);
+                    checksum += section.get_lane(s, t).id;
+                    checksum += road.get_surface_pt(s, t)[2];
+                }
+            }
+        });
+        EXPECT_EQ(n, 0) << "get_lane_id / get_surface_pt";
+
+        n = AllocationsDuring([&]() {
+            for (double s = 0; s <= road.length; s += Step)
+            {
+                checksum += road.get_boundary_xyz(-1, s)[0] + road.get_boundary_xyz(1, s)[0];
+                const auto& section = road.get_lanesection(s);
+                for (int8_t side : { -1, 1 })
+                {
+                    const auto outermost = section.get_driving_lane(side, true);
+                    checksum += outermost == nullptr ? 0 : outermost->id;
+                }
+            }
+        });
+        EXPECT_EQ(n, 0) << "get_boundary_xyz / get_driving_lane";
+        EXPECT_TRUE(std::isfinite(checksum));
+    }
+
+    // Lookups made by Vehicle::PlanStep / MakeStep (traffic/vehicle.cpp) on each simulation step
+    void VerifyVehicleStepQueries(const odr::OpenDriveMap& map, const odr::LaneKey& key)
+    {
+        const double Step = 0.25;
+        const double laneLength = map.get_lanekey_length(key);
+        double checksum = 0;
+
+        size_t n = AllocationsDuring([&]() {
+            for (double s = 0; s < laneLength; s += Step)
+            {
+                // PlanStep
+                checksum += map.get_lanekey_length(key);
+                const auto& planRoad = map.id_to_road.at(key.road_id);
+                const auto& planSection = planRoad.get_lanesection(key.lanesection_s0);
+                checksum += planRoad.get_lanesection_length(planSection);
+                checksum += planSection.id_to_lane.at(key.lane_id).outer_border.get(s + key.lanesection_s0);
+
+                // MakeStep
+                const auto& road = map.id_to_road.at(key.road_id);
+                const auto& section = road.get_lanesection(key.lanesection_s0);
+                const auto& lane = section.id_to_lane.at(key.lane_id);
+                const double sOnRefLine = (key.lane_id > 0 ? laneLength - s : s) + key.lanesection_s0;
+                const double tCenter = (lane.inner_border.get(sOnRefLine) + lane.outer_border.get(sOnRefLine)) / 2;
+                checksum += road.get_xyz(sOnRefLine, tCenter, 0)[2];
+                checksum += lane.outer_border.get_grad(sOnRefLine);
+                checksum += road.ref_line.get_grad_xy(sOnRefLine)[0];
+                checksum += road.ref_line.elevation_profile.get_grad(sOnRefLine);
+            }
+        });
+        EXPECT_EQ(n, 0) << "vehicle step on " << key.to_string();
+        EXPECT_TRUE(std::isfinite(checksum));
+    }
+
+    TEST(Allocation, ZeroCopyLaneSectionAccess)
+    {
+        for (int seed = 1; seed != 6; ++seed)
+        {
+            const uint32_t Length_M = 100;
+            auto refLine = std::make_unique<odr::Line>(0, 0, 0, 0, Length_M);
+            LM::Road road(GenerateConfig(seed, Length_M), std::move(refLine));
+            VerifyZeroCopyQueries(road.generated);
+        }
+    }
+
+    TEST(Allocation, BorderSamplingIndependentOfLaneCount)
+    {
+        // Lane -1 has the same border on both roads, so sampling it costs the same unless other lanes get copied
+        const uint32_t Length_M = 100;
+        LM::Road narrow(LM::LaneProfile(1, 0, 1, 0), std::make_unique<odr::Arc>(0, 0, 0, 0, Length_M, 0.01));
+        LM::Road wide(LM::LaneProfile(4, 0, 4, 0), std::make_unique<odr::Arc>(0, 0, 0, 0, Length_M, 0.01));
+
+        std::vector<size_t> allocations;
+        std::vector<size_t> nPoints;
+        for (const odr::Road* road : { &narrow.generated, &wide.generated })
+        {
+            const auto& lane = road->s_to_lanesection.begin()->second.id_to_lane.at(-1);
+            odr::Line3D outer, inner;
+            outer.reserve(1000);
+            inner.reserve(1000);
+            allocations.push_back(AllocationsDuring([&]() {
+                road->get_lane_border_line(lane, 0, road->length, 0.01, outer, inner);
+            }));
+            nPoints.push_back(outer.size());
+
+            // Batched border evaluation over given s values
+            std::vector<double> s(outer.size()), t(outer.size());
+            for (int i = 0; i != s.size(); ++i)
+            {
+                s[i] = road->length * i / s.size();
+            }
+            EXPECT_EQ(AllocationsDuring([&]() {
+                lane.outer_border.get(s.data(), s.size(), t.data(), nullptr);
+                lane.inner_border.get(s.data(), s.size(), t.data(), nullptr);
+            }), 0);
+        }
+        EXPECT_EQ(nPoints[0], nPoints[1]);
+        EXPECT_GT(nPoints[0], 10);
+        EXPECT_EQ(allocations[0], allocations[1]);
+    }
+
+    TEST(Allocation, SpiralBatchEvaluation)
+    {
+        // Longer than one internal chunk
+        const odr::Spiral spiral(0, 0, 0, 0, 100, 0.001, 0.05);
+        std::vector<double> s(1000);
+        std::vector<odr::Vec2D> xy(s.size()), grad(s.size());
+        for (int i = 0; i != s.size(); ++i)
+        {
+            s[i] = spiral.length * i / (s.size() - 1);
+        }
+        EXPECT_EQ(AllocationsDuring([&]() {
+            spiral.get_xy_grad(s.data(), s.size(), xy.data(), grad.data());
+        }), 0);
+        for (int i = 0; i != s.size(); ++i)
+        {
+            EXPECT_NEAR(odr::euclDistance(xy[i], spiral.get_xy(s[i])), 0, 1e-9);
+            EXPECT_NEAR(odr::euclDistance(grad[i], spiral.get_grad(s[i])), 0, 1e-9);
+        }
+    }
+
+    TEST(Allocation, SingleRefLineMatch)
+    {
+        // Arc then line, longer than one scan chunk: samples cross a geometry boundary and chunk boundaries
+        const double Radius = 50;
+        const double ArcLength = 100;
+        odr::RefLine refLine("", ArcLength + 100);
+        refLine.s0_to_geometry.emplace(0, std::make_unique<odr::Arc>(0, 0, 0, 0, ArcLength, 1 / Radius));
+        auto arcEnd = refLine.s0_to_geometry.at(0)->get_xy(ArcLength);
+        refLine.s0_to_geometry.emplace(ArcLength, std::make_unique<odr::Line>(ArcLength, arcEnd[0], arcEnd[1], ArcLength / Radius, 100));
+
+        double checksum = 0;
+        EXPECT_EQ(AllocationsDuring([&]() {
+            for (double x = -100; x <= 100; x += 10)
+            {
+                checksum += refLine.match(x, Radius);
+            }
+        }), 0);
+        EXPECT_TRUE(std::isfinite(checksum));
+    }
+
+    TEST(Allocation, VehicleStepQueries)
+    {
+        const uint32_t Length_M = 100;
+        std::vector<std::unique_ptr<LM::Road>> roads;
+        odr::OpenDriveMap map;
+        for (int seed = 1; seed != 4; ++seed)
+        {
+            roads.push_back(std::make_unique<LM::Road>(GenerateConfig(seed, Length_M),
+                std::make_unique<odr::Arc>(0, 0, 10.0 * seed, 0, Length_M, 0.005)));
+            roads.back()->generated.ref_line.elevation_profile.s0_to_poly.emplace(0, odr::Poly3(0, seed, 0.02, 0, 0));
+            map.id_to_road.emplace(roads.back()->ID(), roads.back()->generated);
+        }
+        for (const auto& idAndRoad : map.id_to_road)
+        {
+            for (const auto& s_section : idAndRoad.second.s_to_lanesection)
+            {
+                for (const auto& idAndLane : s_section.second.id_to_lane)
+                {
+                    if (idAndLane.first != 0)
+                    {
+                        VerifyVehicleStepQueries(map, idAndLane.second.key);
+                    }
+                }
+            }
+        }
+    }
+
+    TEST(Allocation, DrivingLaneMatchesSortedLanes)
+    {
+        const uint32_t Length_M = 100;
+        auto refLine = std::make_unique<odr::Line>(0, 0, 0, 0, Length_M);
+        LM::Road road(GenerateConfig(3, Length_M), std::move(refLine));
+        for (const auto& s_section : road.generated.s_to_lanesection)
+        {
+            for (int8_t side : { -1, 1 })
+            {
+                auto sorted = s_section.second.get_sorted_driving_lanes(side);
+                auto innermost = s_section.second.get_driving_lane(side, false);
+                auto outermost = s_section.second.get_driving_lane(side, true);
+                if (sorted.empty())
+                {
+                    EXPECT_EQ(innermost, nullptr);
+                    EXPECT_EQ(outermost, nullptr);
+                }
+                else
+                {
+                    EXPECT_EQ(innermost->id, sorted.front().id);
+                    EXPECT_EQ(outermost->id, sorted.back().id);
+                }
+            }
+        }
+    }
+}
@@ -0,0 +1,395 @@
+#include "validation.h"
+#include "OpenDriveMap.h"
+
+#include "Geometries/Arc.h"
+#include "Geometries/Line.h"
+#include "Geometries/ParamPoly3.h"
+#include "Geometries/Spiral.h"
+
+#include <pugixml/pugixml.hpp>
+
+namespace LTest
+{
+    namespace
+    {
+        void RoadLinkToXML(const odr::RoadLink& roadLink, pugi::xml_node& out)
+        {
+            std::string type_s;
+            switch (roadLink.type)
+            {
+            case odr::RoadLink::Type_Road:
+                type_s = "road";
+                break;
+            case odr::RoadLink::Type_Junction:
+                type_s = "junction";
+                break;
+            default:
+                break;
+            }
+            out.append_attribute("elementType").set_value(type_s.c_str());
+            out.append_attribute("elementId").set_value(roadLink.id.c_str());
+            std::string contact_s;
+            switch (roadLink.contact_point)
+            {
+            case odr::RoadLink::ContactPoint::ContactPoint_Start:
+                contact_s = "start";
+                break;
+            case odr::RoadLink::ContactPoint::ContactPoint_End:
+                contact_s = "end";
+                break;
+            default:
+                break;
+            }
+            out.append_attribute("contactPoint").set_value(contact_s.c_str());
+        }
+    }
+
+    void Validation::ExportDOM(const odr::OpenDriveMap& map, const std::string& fpath)
+    {
+        pugi::xml_document doc;
+        pugi::xml_node     main = doc.append_child("OpenDRIVE");
+        pugi::xml_node     header = main.append_child("header");
+        header.append_attribute("revMajor").set_value("1");
+        header.append_attribute("revMinor").set_value("4");
+
+        for (auto rit : map.id_to_road)
+        {
+            const odr::Road&      road = rit.second;
+            pugi::xml_node road_node = main.append_child("road");
+            road_node.append_attribute("name").set_value(road.name.c_str());
+            road_node.append_attribute("length").set_value(road.length);
+            road_node.append_attribute("id").set_value(rit.first.c_str());
+            road_node.append_attribute("junction").set_value(road.junction.c_str());
+
+            // link
+            pugi::xml_node link = road_node.append_child("link");
+            if (road.predecessor.type != odr::RoadLink::Type_None)
+            {
+                pugi::xml_node pred = link.append_child("predecessor");
+                RoadLinkToXML(road.predecessor, pred);
+            }
+            if (road.successor.type != odr::RoadLink::Type_None)
+            {
+                pugi::xml_node succ = link.append_child("successor");
+                RoadLinkToXML(road.successor, succ);
+            }
+
+            // type
+            for (auto it : road.s_to_type)
+            {
+                pugi::xml_node type = road_node.append_child("type");
+                type.append_attribute("s").set_value(it.first);
+                type.append_attribute("type").set_value(it.second.c_str());
+            }
+
+            // planView
+            pugi::xml_node planView = road_node.append_child("planView");
+            for (auto it = road.ref_line.s0_to_geometry.begin(); it != road.ref_line.s0_to_geometry.end(); ++it)
+            {
+                pugi::xml_node geometry = planView.append_child("geometry");
+                geometry.append_attribute("s").set_value(it->first);
+                geometry.append_attribute("x").set_value(it->second->x0);
+                geometry.append_attribute("y").set_value(it->second->y0);
+                geometry.append_attribute("hdg").set_value(it->second->hdg0);
+                geometry.append_attribute("length").set_value(it->second->length);
+
+                if (dynamic_cast<odr::Line*>(it->second.get()))
+                {
+                    geometry.append_child("line");
+                }
+                else if (odr::Arc* geo = dynamic_cast<odr::Arc*>(it->second.get()))
+                {
+                    geometry.append_child("arc").append_attribute("curvature").set_value(geo->curvature);
+                }
+                else if (odr::Spiral* geo = dynamic_cast<odr::Spiral*>(it->second.get()))
+                {
+                    pugi::xml_node spiral = geometry.append_child("spiral");
+                    spiral.append_attribute("curvStart").set_value(geo->curv_start);
+                    spiral.append_attribute("curvEnd").set_value(geo->curv_end);
+                }
+                else
+                {
+                    odr::ParamPoly3* g = dynamic_cast<odr::ParamPoly3*>(it->second.get());
+                    pugi::xml_node   poly3 = geometry.append_child("paramPoly3");
+                    poly3.append_attribute("aU").set_value(g->aU);
+                    poly3.append_attribute("aV").set_value(g->aV);
+                    poly3.append_attribute("bU").set_value(g->bU);
+                    poly3.append_attribute("bV").set_value(g->bV);
+                    poly3.append_attribute("cU").set_value(g->cU);
+                    poly3.append_attribute("cV").set_value(g->cV);
+                    poly3.append_attribute("dU").set_value(g->dU);
+                    poly3.append_attribute("dV").set_value(g->dV);
+                    poly3.append_attribute("pRange").set_value(g->pRange_normalized ? "normalized" : "arcLength");
+                }
+            }
+
+            // elevationProfile
+            pugi::xml_node elevationProfile = road_node.append_child("elevationProfile");
+            for (const auto& s0_poly : road.ref_line.elevation_profile.s0_to_poly)
+            {
+                pugi::xml_node elevation = elevationProfile.append_child("elevation");
+                elevation.append_attribute("s").set_value(s0_poly.first);
+                elevation.append_attribute("a").set_value(s0_poly.second.raw_a);
+                elevation.append_attribute("b").set_value(s0_poly.second.raw_b);
+                elevation.append_attribute("c").set_value(s0_poly.second.raw_c);
+                elevation.append_attribute("d").set_value(s0_poly.second.raw_d);
+            }
+
+            // lanes
+            pugi::xml_node lanes = road_node.append_child("lanes");
+            for (auto it : road.lane_offset.s0_to_poly)
+            {
+                pugi::xml_node laneOffset = lanes.append_child("laneOffset");
+                laneOffset.append_attribute("s").set_value(it.first);
+                laneOffset.append_attribute("a").set_value(it.second.raw_a);
+                laneOffset.append_attribute("b").set_value(it.second.raw_b);
+                laneOffset.append_attribute("c").set_value(it.second.raw_c);
+                laneOffset.append_attribute("d").set_value(it.second.raw_d);
+            }
+            for (auto sectionIt : road.s_to_lanesection)
+            {
+                pugi::xml_node laneSection = lanes.append_child("laneSection");
+                laneSection.append_attribute("s").set_value(sectionIt.first);
+                bool leftCreated = false, rightCreated = false;
+
+                pugi::xml_node left, right;
+
+                for (auto laneIt : sectionIt.second.id_to_lane)
+                {
+                    pugi::xml_node lane;
+                    odr::Lane      l = laneIt.second;
+                    if (laneIt.first > 0)
+                    {
+                        if (!leftCreated)
+                        {
+                            left = laneSection.append_child("left");
+                            leftCreated = true;
+                        }
+                        lane = left.append_child("lane");
+                    }
+                    else if (laneIt.first == 0)
+                    {
+                        pugi::xml_node center = laneSection.append_child("center");
+                        lane = center.append_child("lane");
+                    }
+                    else
+                    {
+                        if (!rightCreated)
+                        {
+                            right = laneSection.append_child("right");
+                            rightCreated = true;
+                        }
+                        lane = right.append_child("lane");
+                    }
+                    lane.append_attribute("id").set_value(laneIt.first);
+                    lane.append_attribute("type").set_value(l.type.c_str());
+                    lane.append_attribute("level").set_value(l.level ? "true" : "false");
+                    if (l.predecessor != 0 || l.successor != 0)
+                    {
+                        pugi::xml_node link = lane.append_child("link");
+                        if (l.predecessor != 0)
+                        {
+                            link.append_child("predecessor").append_attribute("id").set_value(l.predecessor);
+                        }
+                        if (l.successor != 0)
+                        {
+                            link.append_child("successor").append_attribute("id").set_value(l.successor);
+                        }
+                    }
+                    for (auto laneWidthIt : l.lane_width.s0_to_poly)
+                    {
+                        pugi::xml_node width = lane.append_child("width");
+                        width.append_attribute("sOffset").set_value(laneWidthIt.first - sectionIt.first);
+                        width.append_attribute("a").set_value(laneWidthIt.second.raw_a);
+                        width.append_attribute("b").set_value(laneWidthIt.second.raw_b);
+                        width.append_attribute("c").set_value(laneWidthIt.second.raw_c);
+                        width.append_attribute("d").set_value(laneWidthIt.second.raw_d);
+                    }
+                    // Not sorted
+                    for (auto roadMarkIt : l.roadmark_groups)
+                    {
+                        pugi::xml_node roadMark = lane.append_child("roadMark");
+                        roadMark.append_attribute("sOffset").set_value(roadMarkIt.s_offset);
+                        roadMark.append_attribute("type").set_value(roadMarkIt.type.c_str());
+                        roadMark.append_attribute("color").set_value(roadMarkIt.color.c_str());
+                        if (roadMarkIt.height != 0)
+                            roadMark.append_attribute("height").set_value(roadMarkIt.height);
+                        if (roadMarkIt.lane_change != "both")
+                            roadMark.append_attribute("laneChange").set_value(roadMarkIt.lane_change.c_str());
+                        if (roadMarkIt.material != "standard")
+                            roadMark.append_attribute("material").set_value(roadMarkIt.material.c_str());
+                        if (roadMarkIt.weight != "standard")
+                            roadMark.append_attribute("weight").set_value(roadMarkIt.weight.c_str());
+                        if (roadMarkIt.width >= 0)
+                            roadMark.append_attribute("width").set_value(roadMarkIt.width);
+
+                        if (!roadMarkIt.roadmark_lines.empty())
+                        {
+                            auto typeChild = roadMark.append_child("type");
+                            for (auto roadMarkLineIt : roadMarkIt.roadmark_lines)
+                            {
+                                pugi::xml_node roadMarkLine = typeChild.append_child("line");
+                                roadMarkLine.append_attribute("length").set_value(roadMarkLineIt.length);
+                                roadMarkLine.append_attribute("space").set_value(roadMarkLineIt.space);
+                                roadMarkLine.append_attribute("width").set_value(roadMarkLineIt.width);
+                                roadMarkLine.append_attribute("sOffset").set_value(roadMarkLineIt.s_offset);
+                                roadMarkLine.append_attribute("tOffset").set_value(roadMarkLineIt.t_offset);
+                                if (!roadMarkLineIt.rule.empty() != 0)
+                                    roadMarkLine.append_attribute("rule").set_value(roadMarkLineIt.rule.c_str());
+                            }
+                        }
+                    }
+                    // Missing user data
+                }
+            }
+
+            // road objects
+            if (!road.id_to_object.empty())
+            {
+                auto objects_node = road_node.append_child("objects");
+                for (const auto& id_object : road.id_to_object)
+                {
+                    auto road_object = id_object.second;
+                    auto object_node = objects_node.append_child("object");
+                    object_node.append_attribute("id").set_value(id_object.first.c_str());
+                    object_node.append_attribute("dynamic").set_value(road_object.is_dynamic);
+                    object_node.append_attribute("s").set_value(road_object.s0);
+                    object_node.append_attribute("t").set_value(road_object.t0);
+                    object_node.append_attribute("zOffset").set_value(road_object.z0);
+                    object_node.append_attribute("length").set_value(road_object.length);
+                    object_node.append_attribute("validLength").set_value(road_object.valid_length);
+                    object_node.append_attribute("width").set_value(road_object.width);
+                    object_node.append_attribute("radius").set_value(road_object.radius);
+                    object_node.append_attribute("height").set_value(road_object.height);
+                    object_node.append_attribute("hdg").set_value(road_object.hdg);
+                    object_node.append_attribute("pitch").set_value(road_object.pitch);
+                    object_node.append_attribute("roll").set_value(road_object.roll);
+                    object_node.append_attribute("type").set_value(road_object.type.c_str());
+                    object_node.append_attribute("name").set_value(road_object.name.c_str());
+                    object_node.append_attribute("orientation").set_value(road_object.hdg);
+                    object_node.append_attribute("subtype").set_value(road_object.subtype.c_str());
+                    // currently no repeat or outline child
+                }
+            }
+
+            pugi::xml_node customProfile = road_node.append_child("roadRunnerProfile");
+            if (!road.rr_profile.leftPlans.empty())
+            {
+                pugi::xml_node customLeft = customProfile.append_child("left");
+                for (auto customProfile : road.rr_profile.leftPlans)
+                {
+                    pugi::xml_node section = customLeft.append_child("section");
+                    section.append_attribute("type_s").set_value(customProfile.first);
+                    section.append_attribute("laneCount").set_value(customProfile.second.laneCount);
+                    section.append_attribute("offsetX2").set_value(customProfile.second.offsetx2);
+                }
+            }
+            if (!road.rr_profile.rightPlans.empty())
+            {
+                pugi::xml_node customRight = customProfile.append_child("right");
+                for (auto customProfile : road.rr_profile.rightPlans)
+                {
+                    pugi::xml_node section = customRight.append_child("section");
+                    section.append_attribute("type_s").set_value(customProfile.first);
+                    section.append_attribute("laneCount").set_value(customProfile.second.laneCount);
+                    section.append_attribute("offsetX2").set_value(customProfile.second.offsetx2);
+                }
+            }
+
+            if (!road.boundaryHide.empty())
+            {
+                pugi::xml_node customBoundaryHide = road_node.append_child("roadRunnerBoundaryHide");
+                for (auto boundary_length : road.boundaryHide)
+                {
+                    auto           boundary = boundary_length.first;
+                    pugi::xml_node hideDetail = customBoundaryHide.append_child("hide");
+                    hideDetail.append_attribute("contactPoint").set_value(
+                        boundary.first == odr::RoadLink::ContactPoint_Start ? "start" : "end");
+                    hideDetail.append_attribute("side").set_value(boundary.second == -1 ? "right" : "left");
+                    hideDetail.append_attribute("s").set_value(boundary_length.second);
+                }
+            }
+        }
+
+        for (auto j : map.get_junctions())
+        {
+            pugi::xml_node junction = main.append_child("junction");
+            junction.append_attribute("id").set_value(j.id.c_str());
+            junction.append_attribute("name").set_value(j.name.c_str());
+            if (j.type == odr::JunctionType::Direct)
+            {
+                junction.append_attribute("type").set_value("direct");
+            }
+            for (auto c : j.id_to_connection)
+            {
+                auto connection = junction.append_child("connection");
+                connection.append_attribute("id").set_value(c.first.c_str());
+
+                std::string incomingRoad = c.second.incoming_road;
+                if (incomingRoad.size() > 0)
+                    connection.append_attribute("incomingRoad").set_value(incomingRoad.c_str());
+                connection.append_attribute(j.type == odr::JunctionType::Common ? "connectingRoad" : "linkedRoad").set_value(c.second.connecting_road.c_str());
+
+                std::string contectPoint;
+                switch (c.second.contact_point)
+                {
+                case odr::JunctionConnection::ContactPoint_Start:
+                    contectPoint = "start";
+                    break;
+                case odr::JunctionConnection::ContactPoint_End:
+                    contectPoint = "end";
+                    break;
+                default:
+                    break;
+                }
+                if (!contectPoint.empty())
+                    connection.append_attribute("contactPoint").set_value(contectPoint.c_str());
+
+                std::string interfaceProviderContect;
+                switch (c.second.interface_provider_contact)
+                {
+                case odr::JunctionConnection::ContactPoint_Start:
+                    interfaceProviderContect = "start";
+                    break;
+                case odr::JunctionConnection::ContactPoint_End:
+                    interfaceProviderContect = "end";
+                    break;
+                default:
+                    break;
+                }
+                if (!interfaceProviderContect.empty())
+                    connection.append_attribute("interfaceProviderContactPoint").set_value(interfaceProviderContect.c_str());
+
+                for (auto p: c.second.signalPhases)
+                {
+                    connection.append_child("signalPhase").append_attribute("id").set_value(p);
+                }
+
+                for (auto ll : c.second.lane_links)
+                {
+                    pugi::xml_node laneLink = connection.append_child("laneLink");
+                    laneLink.append_attribute("from").set_value(ll.from);
+                    laneLink.append_attribute("to").set_value(ll.to);
+                    if (ll.overlapZone > 0)
+                    {
+                        laneLink.append_attribute("overlapZone").set_value(ll.overlapZone);
+                    }
+                }
+            }
+
+            // Modified version based on xodr
+            auto boundary_node = junction.append_child("boundary");
+            for (auto segment : j.boundary)
+            {
+                auto segment_node = boundary_node.append_child("segment");
+                segment_node.append_attribute("roadID").set_value(segment.road.c_str());
+                segment_node.append_attribute("sStart").set_value(segment.sBegin);
+                segment_node.append_attribute("sEnd").set_value(segment.sEnd);
+                segment_node.append_attribute("side").set_value(segment.side > 0 ? "left" : "right");
+                segment_node.append_attribute("type").set_value(segment.type == odr::BoundarySegmentType::Lane ? "lane" : "joint");
+            }
+        }
+        // junctions
+        doc.save_file(fpath.c_str());
+    }
+}
@@ -100,4 +100,39 @@ namespace LTest
 		RandomElevation,
 		RandElevationParam,
 		testing::Range(1, 30));
+
+	TEST(ElevationProfile, BatchMatchesMap)
+	{
+		srand(5);
+		odr::CubicSpline eProfile;
+		for (int i = 0; i != 15; ++i)
+		{
+			int from = RandomIntBetween(0, 19) * 5;
+			SplineGen::OverwriteSection(eProfile, 100, from, from + 5 * RandomIntBetween(1, 4), RandomIntBetween(-10, 10));
+		}
+
+		// Ascending (incl. beyond both ends), then going back
+		std::vector<double> probes;
+		for (double s = -5; s <= 105; s += 0.25)
+		{
+			probes.push_back(s);
+		}
+		for (double s = 100; s >= 0; s -= 7.5)
+		{
+			probes.push_back(s);
+		}
+
+		std::vector<double> values(probes.size()), grads(probes.size());
+		eProfile.get(probes.data(), probes.size(), values.data(), grads.data());
+		for (int i = 0; i != probes.size(); ++i)
+		{
+			EXPECT_DOUBLE_EQ(values[i], eProfile.get(probes[i])) << " at " << probes[i];
+			EXPECT_DOUBLE_EQ(grads[i], eProfile.get_grad(probes[i])) << " at " << probes[i];
+		}
+
+		odr::CubicSpline empty;
+		double emptyValue = 1;
+		empty.get(probes.data(), 1, &emptyValue, nullptr);
+		EXPECT_EQ(emptyValue, 0);
+	}
 }
\ No newline at end of file
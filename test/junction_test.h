@@ -5,6 +5,7 @@
 #include "randomization_utils.h"
 #include <math.h>
 #include "Geometries/Arc.h"
+#include "Geometries/Line.h"
 
 namespace LTest
 {
@@ -92,6 +93,199 @@ namespace LTest
         Validation::VerifyJunction(j1.get());
     }
 
+    TEST(SingleJunction, ConflictMatrixMatchesPairwise)
+    {
+        const int NumRoads = 6;
+        const double SeparationAngle = M_PI * 2 / NumRoads;
+        std::vector<std::shared_ptr<LM::Road>> roads;
+        std::vector<LM::ConnectionInfo> connectionInfo;
+        for (int i = 0; i != NumRoads; ++i)
+        {
+            bool incoming = i % 2 == 0;
+            odr::Vec2D refLineOrigin = odr::rotateCCW(odr::Vec2D{ incoming ? 55.0 : 25.0, 0 }, SeparationAngle * i);
+            double hdg = SeparationAngle * i + (incoming ? M_PI : 0);
+            auto refLine = std::make_unique<odr::Line>(0, refLineOrigin[0], refLineOrigin[1], hdg, 30);
+            auto road = std::make_shared<LM::Road>(LM::LaneProfile(3, 0, 3, 0), std::move(refLine));
+            road->Generate();
+            roads.push_back(road);
+            connectionInfo.push_back(LM::ConnectionInfo{
+                road, incoming ? odr::RoadLink::ContactPoint_End : odr::RoadLink::ContactPoint_Start });
+        }
+
+        auto j1 = std::make_shared<LM::Junction>();
+        j1->CreateFrom(connectionInfo);
+        Validation::VerifyJunction(j1.get());
+
+        auto connectings = Validation::ConnectingRoads(j1.get());
+        auto matrix = LM::connRoadsConflictMatrix(connectings);
+        ASSERT_EQ(matrix.Size(), connectings.size());
+        int nConflict = 0;
+        for (size_t i = 0; i != connectings.size(); ++i)
+        {
+            EXPECT_FALSE(matrix.Conflict(i, i));
+            for (size_t j = i + 1; j != connectings.size(); ++j)
+            {
+                bool expected = LM::connRoadsConflict(*connectings[i], *connectings[j]);
+                EXPECT_EQ(matrix.Conflict(i, j), expected) << connectings[i]->id << " x " << connectings[j]->id;
+                EXPECT_EQ(matrix.Conflict(j, i), expected);
+                nConflict += expected;
+            }
+        }
+        EXPECT_GT(nConflict, 0);
+    }
+
+    // Connecting roads are built on worker threads, but IDs and linkage must not depend on scheduling
+    TEST(SingleJunction, ConnectingRoadsDeterministic)
+    {
+        const int NumRoads = 6;
+        const double SeparationAngle = M_PI * 2 / NumRoads;
+
+        std::vector<std::tuple<std::string, std::string, std::string, double, int, int>> firstRun;
+        for (int run = 0; run != 5; ++run)
+        {
+            std::vector<std::shared_ptr<LM::Road>> roads;
+            std::vector<LM::ConnectionInfo> connectionInfo;
+            for (int i = 0; i != NumRoads; ++i)
+            {
+                bool incoming = i % 2 == 0;
+                odr::Vec2D refLineOrigin = odr::rotateCCW(odr::Vec2D{ incoming ? 55.0 : 25.0, 0 }, SeparationAngle * i);
+                double hdg = SeparationAngle * i + (incoming ? M_PI : 0);
+                auto refLine = std::make_unique<odr::Line>(0, refLineOrigin[0], refLineOrigin[1], hdg, 30);
+                auto road = std::make_shared<LM::Road>(LM::LaneProfile(3, 0, 3, 0), std::move(refLine));
+                roads.push_back(road);
+                connectionInfo.push_back(LM::ConnectionInfo{
+                    road, incoming ? odr::RoadLink::ContactPoint_End : odr::RoadLink::ContactPoint_Start });
+            }
+
+            auto j1 = std::make_shared<LM::Junction>();
+            j1->CreateFrom(connectionInfo);
+            Validation::VerifyJunction(j1.get());
+
+            // IDs are freed with the roads of last run, so the same ones get picked
+            std::vector<std::tuple<std::string, std::string, std::string, double, int, int>> thisRun;
+            for (auto connecting : Validation::ConnectingRoads(j1.get()))
+            {
+                const auto& lane = connecting->s_to_lanesection.begin()->second.id_to_lane.begin()->second;
+                thisRun.emplace_back(connecting->id, connecting->predecessor.id, connecting->successor.id,
+                    connecting->length, lane.predecessor, lane.successor);
+            }
+            if (run == 0)
+            {
+                firstRun = thisRun;
+                EXPECT_FALSE(firstRun.empty());
+            }
+            else
+            {
+                EXPECT_EQ(thisRun, firstRun);
+            }
+        }
+    }
+
+    // Many changes to incoming roads in one edit regenerate the junction once, to the same result
+    TEST(SingleJunction, DeferredRegenerationCoalesced)
+    {
+        const int NumRoads = 6;
+        const double SeparationAngle = M_PI * 2 / NumRoads;
+
+        std::vector<std::vector<double>> connectingLengths;
+        for (bool defer : { true, false })
+        {
+            std::vector<std::shared_ptr<LM::Road>> roads;
+            std::vector<LM::ConnectionInfo> connectionInfo;
+            for (int i = 0; i != NumRoads; ++i)
+            {
+                bool incoming = i % 2 == 0;
+                odr::Vec2D refLineOrigin = odr::rotateCCW(odr::Vec2D{ incoming ? 55.0 : 25.0, 0 }, SeparationAngle * i);
+                double hdg = SeparationAngle * i + (incoming ? M_PI : 0);
+                auto refLine = std::make_unique<odr::Line>(0, refLineOrigin[0], refLineOrigin[1], hdg, 30);
+                auto road = std::make_shared<LM::Road>(LM::LaneProfile(3, 0, 3, 0), std::move(refLine));
+                roads.push_back(road);
+                connectionInfo.push_back(LM::ConnectionInfo{
+                    road, incoming ? odr::RoadLink::ContactPoint_End : odr::RoadLink::ContactPoint_Start });
+            }
+
+            auto j1 = std::make_shared<LM::Junction>();
+            j1->CreateFrom(connectionInfo);
+            auto connectingsBefore = Validation::ConnectingRoads(j1.get());
+
+            auto counterBefore = LM::AbstractJunction::regenerationCounter;
+            if (defer)
+            {
+                LM::AbstractJunction::BeginDeferRegeneration();
+            }
+            for (auto& road : roads)
+            {
+                road->ReverseRefLine();
+                road->ReverseRefLine();
+                road->generated.rr_profile = LM::LaneProfile(2, 0, 2, 0);
+                road->Generate();
+            }
+            if (defer)
+            {
+                EXPECT_EQ(Validation::ConnectingRoads(j1.get()), connectingsBefore);
+                LM::AbstractJunction::EndDeferRegeneration();
+            }
+
+            auto counterAfter = LM::AbstractJunction::regenerationCounter;
+            EXPECT_EQ(counterAfter.requested - counterBefore.requested, 3 * NumRoads);
+            EXPECT_EQ(counterAfter.performed - counterBefore.performed, defer ? 1 : 3 * NumRoads);
+            EXPECT_EQ(j1->generationError, LM::Junction_NoError);
+            Validation::VerifyJunction(j1.get());
+
+            std::vector<double> lengths;
+            for (auto connecting : Validation::ConnectingRoads(j1.get()))
+            {
+                lengths.push_back(connecting->length);
+            }
+            std::sort(lengths.begin(), lengths.end());
+            connectingLengths.push_back(lengths);
+        }
+        EXPECT_EQ(connectingLengths[0], connectingLengths[1]);
+    }
+
+    TEST(SingleJunction, DeferredRegenerationEndsOnException)
+    {
+        const int NumRoads = 4;
+        std::vector<std::shared_ptr<LM::Road>> roads;
+        std::vector<LM::ConnectionInfo> connectionInfo;
+        for (int i = 0; i != NumRoads; ++i)
+        {
+            odr::Vec2D refLineOrigin = odr::rotateCCW(odr::Vec2D{ 25, 0 }, M_PI_2 * i);
+            auto refLine = std::make_unique<odr::Line>(0, refLineOrigin[0], refLineOrigin[1], M_PI_2 * i, 30);
+            auto road = std::make_shared<LM::Road>(LM::LaneProfile(2, 0, 2, 0), std::move(refLine));
+            roads.push_back(road);
+            connectionInfo.push_back(LM::ConnectionInfo{ road, odr::RoadLink::ContactPoint_Start });
+        }
+        auto j1 = std::make_shared<LM::Junction>();
+        j1->CreateFrom(connectionInfo);
+
+        // Edit fails half way, as confirmEdit handles it
+        auto counterBefore = LM::AbstractJunction::regenerationCounter;
+        LM::AbstractJunction::BeginDeferRegeneration();
+        try
+        {
+            roads[0]->ReverseRefLine();
+            throw std::runtime_error("edit failed");
+        }
+        catch (const std::runtime_error&)
+        {
+            LM::AbstractJunction::AbortDeferRegeneration();
+        }
+        auto counterAfter = LM::AbstractJunction::regenerationCounter;
+        EXPECT_EQ(counterAfter.requested - counterBefore.requested, 1);
+        EXPECT_EQ(counterAfter.performed - counterBefore.performed, 0);
+
+        // Dropped, not left pending
+        j1->RegenerateIfPending();
+        EXPECT_EQ(LM::AbstractJunction::regenerationCounter.performed, counterAfter.performed);
+
+        // No longer deferred: next change regenerates right away
+        roads[0]->ReverseRefLine();
+        EXPECT_EQ(LM::AbstractJunction::regenerationCounter.performed - counterAfter.performed, 1);
+        EXPECT_EQ(j1->generationError, LM::Junction_NoError);
+        Validation::VerifyJunction(j1.get());
+    }
+
     INSTANTIATE_TEST_SUITE_P(
         RandomJunction,
         Seed_SingleJunction,
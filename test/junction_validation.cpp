@@ -163,6 +163,16 @@ namespace LTest
         }
     }
 
+    std::vector<const odr::Road*> Validation::ConnectingRoads(const LM::Junction* junction)
+    {
+        std::vector<const odr::Road*> rtn;
+        for (const auto& road : junction->connectingRoads)
+        {
+            rtn.push_back(&road->generated);
+        }
+        return rtn;
+    }
+
     void Validation::EnsureEndsMeet(const odr::Road* road1, double s1, odr::Lane l1,
         const odr::Road* road2, double s2, odr::Lane l2)
     {
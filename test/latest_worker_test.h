@@ -0,0 +1,60 @@
+#include <gtest/gtest.h>
+
+#include "latest_worker.h"
+
+#include <atomic>
+#include <future>
+
+namespace LTest
+{
+    TEST(LatestOnlyWorker, NewerSubmitSupersedesPending)
+    {
+        std::promise<void> release;
+        std::shared_future<void> released = release.get_future().share();
+        std::atomic<int> nRun{ 0 };
+
+        LatestOnlyWorker<int> worker;
+        worker.Submit([&]() { nRun++; released.wait(); return 0; });
+        // Queued behind the blocked job, each replacing the previous
+        for (int i = 1; i <= 10; ++i)
+        {
+            worker.Submit([&, i]() { nRun++; return i; });
+        }
+        release.set_value();
+
+        auto latest = worker.WaitLatest();
+        ASSERT_TRUE(latest.has_value());
+        EXPECT_EQ(latest->result, 10);
+        EXPECT_EQ(latest->generation, 11);
+        EXPECT_LE(nRun, 2); // blocked job and the newest one
+
+        // Taken by WaitLatest
+        EXPECT_FALSE(worker.TakeLatest().has_value());
+        EXPECT_FALSE(worker.WaitLatest().has_value());
+    }
+
+    TEST(LatestOnlyWorker, CancelDropsRunningResult)
+    {
+        std::promise<void> release;
+        std::shared_future<void> released = release.get_future().share();
+
+        LatestOnlyWorker<int> worker;
+        worker.Submit([&]() { released.wait(); return 1; });
+        worker.Cancel();
+        EXPECT_FALSE(worker.WaitLatest().has_value());
+        release.set_value();
+
+        worker.Submit([]() { return 2; });
+        auto latest = worker.WaitLatest();
+        ASSERT_TRUE(latest.has_value());
+        EXPECT_EQ(latest->result, 2);
+        EXPECT_FALSE(worker.TakeLatest().has_value());
+    }
+
+    TEST(LatestOnlyWorker, FailedJobYieldsNoResult)
+    {
+        LatestOnlyWorker<int> worker;
+        worker.Submit([]() -> int { throw std::runtime_error("bad fit"); });
+        EXPECT_FALSE(worker.WaitLatest().has_value());
+    }
+}
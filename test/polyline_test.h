@@ -0,0 +1,225 @@
+#include <gtest/gtest.h>
+
+#include "junction.h"
+#include "polyline.h"
+#include "validation.h"
+
+#include "Geometries/Line.h"
+
+#include <CGAL/Exact_predicates_exact_constructions_kernel.h>
+#include <CGAL/Arr_non_caching_segment_traits_2.h>
+#include <CGAL/Arrangement_with_history_2.h>
+
+#include "spdlog/spdlog.h"
+#include <chrono>
+#include <math.h>
+
+namespace LTest::ArrangementReference
+{
+    typedef CGAL::Exact_predicates_exact_constructions_kernel Kernel;
+    typedef CGAL::Arr_non_caching_segment_traits_2<Kernel>  Traits_2;
+    typedef Traits_2::Point_2                               Point;
+    typedef Traits_2::X_monotone_curve_2                    Segment;
+    typedef CGAL::Arrangement_with_history_2<Traits_2>      Arrangement;
+    typedef Arrangement::Halfedge_around_vertex_circulator  Halfedge_circulator;
+    typedef Kernel::FT                                      FT;
+
+    std::string Serialize(Point p)
+    {
+        std::string rtn = p.exact().x().get_str();
+        rtn += p.exact().y().get_str();
+        return rtn;
+    }
+
+    std::map<std::string, double> addToArrangement(Arrangement& arrangement, const odr::Road& road, const int side,
+        const odr::RoadLink::ContactPoint searchBegin, const double SearchLimit)
+    {
+        const double Resolution = 1.0;
+
+        std::map<std::string, double> pointToS;
+        double searchBeginS = searchBegin == odr::RoadLink::ContactPoint_End ? road.length : 0;
+        double searchStep = searchBegin == odr::RoadLink::ContactPoint_End ? -Resolution : Resolution;
+
+        for (double s1 = searchBeginS, s2 = searchBeginS + searchStep;
+            0 <= s1 && s1 <= road.length && 0 <= s2 && s2 <= road.length &&
+            std::abs(s1 - searchBeginS) < SearchLimit &&
+            std::abs(s2 - searchBeginS) < SearchLimit
+            ; s1 += searchStep, s2 += searchStep)
+        {
+            auto p1 = road.get_boundary_xy(side, s1);
+            auto p2 = road.get_boundary_xy(side, s2);
+            Point point1(p1[0], p1[1]);
+            Point point2(p2[0], p2[1]);
+            pointToS.emplace(Serialize(point1), s1);
+            pointToS.emplace(Serialize(point2), s2);
+            CGAL::insert(arrangement, Segment(point1, point2));
+        }
+
+        return pointToS;
+    }
+
+    // Exact-arrangement borderIntersect replaced by the segment sweep, kept to compare against
+    bool borderIntersect(const odr::Road& roadA, const int sideA,
+        const odr::Road& roadB, const int sideB, double& outSA, double& outSB,
+        const odr::RoadLink::ContactPoint searchBeginA,
+        const odr::RoadLink::ContactPoint searchBeginB,
+        const double SearchLimit = 200.0)
+    {
+        Arrangement arrangement;
+        std::map<std::string, double> pointAToS = addToArrangement(arrangement, roadA, sideA, searchBeginA, SearchLimit);
+        std::map<std::string, double> pointBToS = addToArrangement(arrangement, roadB, sideB, searchBeginB, SearchLimit);
+
+        outSA = searchBeginA == odr::RoadLink::ContactPoint_End ? -1e9 : 1e9;
+        outSB = searchBeginB == odr::RoadLink::ContactPoint_End ? -1e9 : 1e9;
+        for (auto key : pointAToS)
+        {
+            if (pointBToS.find(key.first) != pointBToS.end())
+            {
+                outSA = key.second;
+                outSB = pointBToS.at(key.first);
+                return true;
+            }
+        }
+
+        bool iFound = false;
+        for (auto vIt = arrangement.vertices_begin(); vIt != arrangement.vertices_end(); ++vIt)
+        {
+            if (vIt->degree() <= 2)
+            {
+                continue;
+            }
+            std::vector<double> sMarksA, sMarksB;
+            std::vector<double> heLengthA, heLengthB;
+
+            auto vSer = Serialize(vIt->point());
+            if (pointAToS.find(vSer) != pointAToS.end())
+            {
+                sMarksA.push_back(pointAToS.at(vSer));
+                heLengthA.push_back(0);
+            }
+            if (pointBToS.find(vSer) != pointBToS.end())
+            {
+                sMarksB.push_back(pointBToS.at(vSer));
+                heLengthB.push_back(0);
+            }
+
+            Halfedge_circulator start = vIt->incident_halfedges();
+            Halfedge_circulator circulator = start;
+            do
+            {
+                FT squared_length = CGAL::squared_distance(circulator->source()->point(), circulator->target()->point());
+                double heLength = std::sqrt(CGAL::to_double(squared_length));
+                for (auto end : { circulator->source(), circulator->target() })
+                {
+                    if (vIt == end)
+                    {
+                        continue;
+                    }
+                    auto endSer = Serialize(end->point());
+                    if (pointAToS.find(endSer) != pointAToS.end())
+                    {
+                        sMarksA.push_back(pointAToS.at(endSer));
+                        heLengthA.push_back(heLength);
+                    }
+                    if (pointBToS.find(endSer) != pointBToS.end())
+                    {
+                        sMarksB.push_back(pointBToS.at(endSer));
+                        heLengthB.push_back(heLength);
+                    }
+                }
+                ++circulator;
+            } while (circulator != start);
+            if (sMarksA.size() != 2 || sMarksB.size() != 2)
+            {
+                continue;
+            }
+
+            iFound = true;
+            auto candSA = (sMarksA[0] * heLengthA[1] + sMarksA[1] * heLengthA[0]) / (heLengthA[0] + heLengthA[1]);
+            auto candSB = (sMarksB[0] * heLengthB[1] + sMarksB[1] * heLengthB[0]) / (heLengthB[0] + heLengthB[1]);
+            outSA = searchBeginA == odr::RoadLink::ContactPoint_End ? std::max(outSA, candSA) : std::min(outSA, candSA);
+            outSB = searchBeginB == odr::RoadLink::ContactPoint_End ? std::max(outSB, candSB) : std::min(outSB, candSB);
+        }
+        return iFound;
+    }
+}
+
+namespace LTest
+{
+    struct NumRoads_BorderIntersect
+        : public testing::TestWithParam<int> {};
+
+    // Connecting roads of a junction are tested pairwise, as in conflict check
+    TEST_P(NumRoads_BorderIntersect, MatchesArrangement)
+    {
+        const int NumRoads = GetParam();
+        const double SeparationAngle = M_PI * 2 / NumRoads;
+        const double RoadLength = 30;
+        const odr::Vec2D nearEnd{ 25, 0 };
+        const odr::Vec2D farEnd{ 55, 0 };
+
+        std::vector<std::shared_ptr<LM::Road>> roads;
+        std::vector<LM::ConnectionInfo> connectionInfo;
+        for (int i = 0; i != NumRoads; ++i)
+        {
+            bool incoming = i % 2 == 0;
+            odr::Vec2D refLineOrigin = odr::rotateCCW(incoming ? farEnd : nearEnd, SeparationAngle * i);
+            double hdg = SeparationAngle * i;
+            if (incoming) hdg += M_PI;
+            auto refLine = std::make_unique<odr::Line>(0, refLineOrigin[0], refLineOrigin[1], hdg, RoadLength);
+            auto road = std::make_shared<LM::Road>(LM::LaneProfile(2, 0, 2, 0), std::move(refLine));
+            road->Generate();
+            roads.push_back(road);
+            connectionInfo.push_back(LM::ConnectionInfo{
+                road, incoming ? odr::RoadLink::ContactPoint_End : odr::RoadLink::ContactPoint_Start });
+        }
+
+        auto junction = std::make_shared<LM::Junction>();
+        junction->CreateFrom(connectionInfo);
+        Validation::VerifyJunction(junction.get());
+
+        auto connectings = Validation::ConnectingRoads(junction.get());
+        double sweepMicros = 0, arrangementMicros = 0;
+        int nPair = 0, nIntersect = 0;
+        for (size_t i = 0; i != connectings.size(); ++i)
+        {
+            for (size_t j = i + 1; j != connectings.size(); ++j)
+            {
+                const odr::Road& roadA = *connectings[i];
+                const odr::Road& roadB = *connectings[j];
+                if (roadA.predecessor.id == roadB.predecessor.id)
+                {
+                    continue;
+                }
+                for (auto contact : { odr::RoadLink::ContactPoint_None, odr::RoadLink::ContactPoint_End })
+                {
+                    double sweepSA, sweepSB, exactSA, exactSB;
+                    auto begin = std::chrono::steady_clock::now();
+                    bool sweepFound = LM::borderIntersect(roadA, -1, roadB, -1, sweepSA, sweepSB, contact, contact);
+                    auto mid = std::chrono::steady_clock::now();
+                    bool exactFound = ArrangementReference::borderIntersect(roadA, -1, roadB, -1, exactSA, exactSB, contact, contact);
+                    auto end = std::chrono::steady_clock::now();
+                    sweepMicros += std::chrono::duration<double, std::micro>(mid - begin).count();
+                    arrangementMicros += std::chrono::duration<double, std::micro>(end - mid).count();
+
+                    nPair++;
+                    nIntersect += exactFound;
+                    EXPECT_EQ(sweepFound, exactFound) << roadA.id << " x " << roadB.id;
+                    if (sweepFound && exactFound)
+                    {
+                        EXPECT_NEAR(sweepSA, exactSA, 1e-6);
+                        EXPECT_NEAR(sweepSB, exactSB, 1e-6);
+                    }
+                }
+            }
+        }
+        EXPECT_GT(nIntersect, 0);
+        spdlog::info("{}-way junction, {} border pairs: sweep {:.0f}us, arrangement {:.0f}us",
+            NumRoads, nPair, sweepMicros, arrangementMicros);
+    }
+
+    INSTANTIATE_TEST_SUITE_P(
+        BorderIntersect,
+        NumRoads_BorderIntersect,
+        testing::Values(4, 6));
+}
@@ -4,9 +4,14 @@
 #include "Geometries/Arc.h"
 #include "Geometries/Spiral.h"
 #include "Geometries/ParamPoly3.h"
+#include "Geometries/Spiral/odrSpiral.h"
+#include "RefLine.h"
 #include "curve_fitting.h"
 
 #include "spdlog/spdlog.h"
+#include <algorithm>
+#include <chrono>
+#include <random>
 #include "test_macros.h"
 
 extern const std::map<int, std::pair<int, int>> posAngleCombo;
@@ -228,4 +233,294 @@ namespace LTest
     {
         LM::TestSpiralFitting();
     }
+
+    // Run on demand when the solver changes. Writes to the working directory.
+    TEST(RoadGeometry, DISABLED_GenerateSpiralFitTable)
+    {
+        LM::GenerateSpiralFitTable("spiral_fit_table.h");
+    }
+
+    TEST(RoadGeometry, BatchEvaluation)
+    {
+        odr::RefLine refLine("", 0);
+        std::vector<double> sVals;
+        for (int geoIndex = 0; geoIndex != NGeometry; ++geoIndex)
+        {
+            auto geo = TestingGeo[geoIndex]->clone();
+            geo->s0 = refLine.length;
+            for (int i = 0; i <= Subdivision; ++i)
+            {
+                sVals.push_back(geo->s0 + static_cast<double>(i) / Subdivision * geo->length);
+            }
+            refLine.length += geo->length;
+            refLine.s0_to_geometry.emplace(geo->s0, std::move(geo));
+        }
+        refLine.elevation_profile.s0_to_poly.emplace(0, odr::Poly3(0, 1, 0.1, -0.01, 0.0001));
+        refLine.elevation_profile.s0_to_poly.emplace(60, odr::Poly3(60, 2, -0.05, 0, 0));
+
+        odr::Line3D points;
+        std::vector<odr::Vec3D> grads;
+        refLine.get_xyz(sVals, points, &grads);
+        ASSERT_EQ(points.size(), sVals.size());
+        ASSERT_EQ(grads.size(), sVals.size());
+        for (int i = 0; i != sVals.size(); ++i)
+        {
+            EXPECT_LT(odr::euclDistance(points[i], refLine.get_xyz(sVals[i])), LM::epsilon) << " at " << sVals[i];
+            EXPECT_LT(odr::euclDistance(grads[i], refLine.get_grad(sVals[i])), LM::epsilon) << " at " << sVals[i];
+        }
+    }
+
+    TEST(RoadGeometry, FresnelTable)
+    {
+        double maxErr = 0;
+        for (double x = -20; x <= 20; x += 1e-4)
+        {
+            double s1, c1, s2, c2;
+            odrFresnel(x, &s1, &c1);
+            odrFresnelCephes(x, &s2, &c2);
+            maxErr = std::max({ maxErr, std::abs(s1 - s2), std::abs(c1 - c2) });
+        }
+        EXPECT_LT(maxErr, 1e-9);
+
+        // Microbenchmark over the table range
+        std::mt19937 gen(3);
+        std::uniform_real_distribution<double> dist(-8, 8);
+        std::vector<double> xs(1 << 20);
+        for (auto& x : xs)
+        {
+            x = dist(gen);
+        }
+        auto timeNS = [&xs](void (*fresnel)(double, double*, double*))
+        {
+            double sum = 0;
+            auto begin = std::chrono::steady_clock::now();
+            for (double x : xs)
+            {
+                double s, c;
+                fresnel(x, &s, &c);
+                sum += s + c;
+            }
+            auto ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - begin).count();
+            EXPECT_FALSE(std::isnan(sum));
+            return ns / xs.size();
+        };
+        spdlog::info("Fresnel table: {:.1f}ns / eval; CEPHES: {:.1f}ns / eval", timeNS(odrFresnel), timeNS(odrFresnelCephes));
+    }
+
+    TEST(RoadGeometry, SpiralApproximateLinear)
+    {
+        const std::vector<odr::Spiral> spirals
+        {
+            odr::Spiral(0, 20, 10, 2.55, 50, 1.0 / 25, 1.0 / 50),
+            odr::Spiral(0, 20, 10, 0.34, 50, -1.0 / 25, -1.0 / 50),
+            odr::Spiral(10, 0, 0, 0, 30, -1.0 / 20, 1.0 / 40), // inflection
+            odr::Spiral(0, 0, 0, 1, 800, 0, 1.0 / 2000) // gentle highway transition
+        };
+
+        for (double eps : { 0.01, 0.1 })
+        {
+            for (const auto& spiral : spirals)
+            {
+                auto sVals = spiral.approximate_linear(eps);
+                EXPECT_DOUBLE_EQ(*sVals.begin(), spiral.s0);
+                EXPECT_DOUBLE_EQ(*sVals.rbegin(), spiral.s0 + spiral.length);
+
+                // Curve between two samples stays within eps of their chord
+                for (auto it = sVals.begin(); std::next(it) != sVals.end(); ++it)
+                {
+                    auto s1 = *it, s2 = *std::next(it);
+                    auto p1 = spiral.get_xy(s1), p2 = spiral.get_xy(s2);
+                    auto chordDir = odr::normalize(odr::sub(p2, p1));
+                    for (int i = 1; i < Subdivision; ++i)
+                    {
+                        auto p = spiral.get_xy(s1 + (s2 - s1) * i / Subdivision);
+                        auto deviation = std::abs(odr::crossProduct(chordDir, odr::sub(p, p1)));
+                        EXPECT_LT(deviation, eps * (1 + 1e-6)) << "Between s=" << s1 << " and " << s2;
+                    }
+                }
+            }
+        }
+
+        // Straight-ish geometry needs few vertices, instead of one per 10 * eps
+        auto gentle = spirals.back().approximate_linear(0.1);
+        EXPECT_LT(gentle.size(), 30);
+        // Tight geometry keeps at least the vertices an arc of its min curvature needs
+        auto tight = spirals.front().approximate_linear(0.01);
+        EXPECT_GE(tight.size(), 50 / std::sqrt(8 * 0.01 * 50));
+    }
+    TEST(RoadGeometry, ParamPoly3ArcLength)
+    {
+        std::mt19937 gen(7);
+        std::uniform_real_distribution<double> xy(-60, 60);
+        std::vector<odr::ParamPoly3> curves;
+        for (int i = 0; i != 50; ++i)
+        {
+            odr::Vec2D p0{ xy(gen), xy(gen) }, c1{ xy(gen), xy(gen) }, c2{ xy(gen), xy(gen) }, p1{ xy(gen), xy(gen) };
+            curves.emplace_back(0, p0, c1, c2, p1);
+        }
+
+        for (const auto& curve : curves)
+        {
+            auto p0 = odr::toGlobal(curve.cubic_bezier.control_points[0], odr::Vec2D{ curve.x0, curve.y0 },
+                odr::Vec2D{ std::cos(curve.hdg0), std::sin(curve.hdg0) });
+            auto p1 = odr::toGlobal(curve.cubic_bezier.control_points[3], odr::Vec2D{ curve.x0, curve.y0 },
+                odr::Vec2D{ std::cos(curve.hdg0), std::sin(curve.hdg0) });
+            EXPECT_LT(odr::euclDistance(curve.get_xy(0), p0), 1e-9);
+            EXPECT_LT(odr::euclDistance(curve.get_xy(curve.length), p1), 1e-9);
+
+            // s is distance travelled: dense chords between samples add up to their s difference
+            for (int i = 0; i != Subdivision; ++i)
+            {
+                double s1 = curve.length * i / Subdivision;
+                double s2 = curve.length * (i + 1) / Subdivision;
+                double chordSum = 0;
+                const int NChord = 2000;
+                for (int j = 0; j != NChord; ++j)
+                {
+                    chordSum += odr::euclDistance(
+                        curve.get_xy(s1 + (s2 - s1) * j / NChord), curve.get_xy(s1 + (s2 - s1) * (j + 1) / NChord));
+                }
+                EXPECT_NEAR(chordSum, s2 - s1, 1e-6 * curve.length) << "Between s=" << s1 << " and " << s2;
+            }
+        }
+
+        // The quintic t(s) table is close enough on its own almost everywhere
+        size_t newtonSegments = 0, segments = 0;
+        for (const auto& curve : curves)
+        {
+            const auto& table = curve.cubic_bezier.newton_table;
+            newtonSegments += std::count(table.begin(), table.end(), true);
+            segments += table.size();
+        }
+        EXPECT_LT(newtonSegments, segments / 20);
+
+        std::vector<double> sVals(1 << 18);
+        std::uniform_real_distribution<double> unit(0, 1);
+        for (auto& s : sVals)
+        {
+            s = unit(gen);
+        }
+        double sum = 0;
+        auto begin = std::chrono::steady_clock::now();
+        for (size_t i = 0; i != sVals.size(); ++i)
+        {
+            const auto& curve = curves[i % curves.size()];
+            auto p = curve.get_xy(sVals[i] * curve.length);
+            sum += p[0] + p[1];
+        }
+        auto ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - begin).count();
+        EXPECT_FALSE(std::isnan(sum));
+        spdlog::info("ParamPoly3::get_xy: {:.1f}ns / eval", ns / sVals.size());
+    }
+
+    TEST(RoadGeometry, RefLineMatch)
+    {
+        // Nearly closed loop then a straight leaving across it: many local minima
+        odr::RefLine refLine("", 0);
+        const double Radius = 20;
+        const double ArcLength = Radius * M_PI * 2 * 0.9;
+        refLine.s0_to_geometry.emplace(0, std::make_unique<odr::Arc>(0, 0, 0, 0, ArcLength, 1 / Radius));
+        auto arcEnd = refLine.s0_to_geometry.at(0)->get_xy(ArcLength);
+        auto arcEndHdg = odr::normalize(refLine.s0_to_geometry.at(0)->get_grad(ArcLength));
+        refLine.s0_to_geometry.emplace(ArcLength,
+            std::make_unique<odr::Line>(ArcLength, arcEnd[0], arcEnd[1], std::atan2(arcEndHdg[1], arcEndHdg[0]), 60));
+        auto lineEnd = refLine.s0_to_geometry.at(ArcLength)->get_xy(ArcLength + 60);
+        // then curls back into the loop, where s is not proportional to curve parameter
+        auto curl = std::make_unique<odr::ParamPoly3>(ArcLength + 60, lineEnd,
+            odr::add(lineEnd, odr::mut(30.0, arcEndHdg)), odr::Vec2D{ 40, 60 }, odr::Vec2D{ 5, 25 });
+        refLine.length = ArcLength + 60 + curl->length;
+        refLine.s0_to_geometry.emplace(ArcLength + 60, std::move(curl));
+
+        std::mt19937 gen(9);
+        std::uniform_real_distribution<double> xy(-35, 35);
+        std::vector<odr::Vec2D> points(500);
+        for (auto& p : points)
+        {
+            p = odr::Vec2D{ xy(gen), xy(gen) + Radius };
+        }
+
+        auto begin = std::chrono::steady_clock::now();
+        auto matched = refLine.match(points);
+        auto matchMicros = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - begin).count();
+        ASSERT_EQ(matched.size(), points.size());
+
+        int nGoldenWrong = 0;
+        for (size_t i = 0; i != points.size(); ++i)
+        {
+            const auto& p = points[i];
+            double bruteDist = std::numeric_limits<double>::infinity();
+            for (double s = 0; s <= refLine.length; s += 0.02)
+            {
+                auto q = refLine.get_xyz(s);
+                bruteDist = std::min(bruteDist, odr::euclDistance(p, odr::Vec2D{ q[0], q[1] }));
+            }
+
+            double s = matched[i][0], t = matched[i][1];
+            auto q = refLine.get_xyz(s);
+            EXPECT_LE(odr::euclDistance(p, odr::Vec2D{ q[0], q[1] }), bruteDist + 1e-6) << p[0] << "," << p[1];
+            if (0 < s && s < refLine.length)
+            {
+                // Off either end, nearest is the end and p is not on its normal
+                auto onT = refLine.get_xyz(s, t);
+                EXPECT_LT(odr::euclDistance(p, odr::Vec2D{ onT[0], onT[1] }), 1e-6) << p[0] << "," << p[1];
+            }
+            EXPECT_NEAR(refLine.match(p[0], p[1]), s, 1e-6) << p[0] << "," << p[1];
+
+            std::function<double(double)> fDist = [&](double s)
+            {
+                auto q = refLine.get_xyz(s);
+                return odr::euclDistance(p, odr::Vec2D{ q[0], q[1] });
+            };
+            double goldenS = odr::golden_section_search<double>(fDist, 0.0, refLine.length, 1e-2);
+            nGoldenWrong += fDist(goldenS) > bruteDist + 0.01;
+        }
+        spdlog::info("Match {} points: {:.0f}us; golden section search misses {}", points.size(), matchMicros, nGoldenWrong);
+
+        // Restricted to the straight part
+        odr::RefLineIndex index(refLine);
+        auto onLine = index.project(odr::Vec2D{ 0, Radius }, ArcLength, ArcLength + 60);
+        EXPECT_GE(onLine[0], ArcLength);
+        EXPECT_LE(onLine[0], ArcLength + 60);
+        auto q = refLine.get_xyz(onLine[0]);
+        EXPECT_NEAR(odr::dot(odr::sub(odr::Vec2D{ 0, Radius }, odr::Vec2D{ q[0], q[1] }), arcEndHdg), 0, 1e-9);
+
+        // Windows missing the ref line end up at the nearer end
+        auto pastEnd = index.project(odr::Vec2D{ 0, Radius }, refLine.length + 1, refLine.length + 5);
+        EXPECT_DOUBLE_EQ(pastEnd[0], refLine.length);
+        auto end = refLine.get_xyz(refLine.length, pastEnd[1]);
+        EXPECT_NEAR(odr::crossProduct(odr::normalize(refLine.get_grad_xy(refLine.length)),
+            odr::sub(odr::Vec2D{ 0, Radius }, odr::Vec2D{ end[0], end[1] })), 0, 1e-9);
+        EXPECT_DOUBLE_EQ(index.project(odr::Vec2D{ 0, Radius }, -5, -1)[0], 0);
+        auto inverted = index.project(odr::Vec2D{ 0, Radius }, ArcLength + 10, ArcLength);
+        EXPECT_DOUBLE_EQ(inverted[0], ArcLength + 10);
+    }
+
+    TEST(RoadGeometry, FitSpiralFromTable)
+    {
+        // Random rays, scale and orientation within the range posAngleCombo accepts
+        std::mt19937 gen(5);
+        std::uniform_real_distribution<double> posAngle(15, 130), turnAngle(5, 110), scale(0.5, 45), xy(-100, 100), hdg(-M_PI, M_PI);
+        std::vector<double> micros;
+        for (int i = 0; i != 500; ++i)
+        {
+            const double side = i % 2 == 0 ? 1 : -1;
+            const double pos = posAngle(gen) * side * M_PI / 180;
+            const double turn = turnAngle(gen) * side * M_PI / 180;
+            const double dist = LM::UnitRadius * scale(gen);
+            odr::Vec2D startPos{ xy(gen), xy(gen) };
+            auto startHdg = odr::rotateCCW(odr::Vec2D{ 1, 0 }, hdg(gen));
+            auto endPos = odr::add(startPos, odr::mut(dist, odr::rotateCCW(startHdg, pos)));
+            auto endHdg = odr::rotateCCW(startHdg, pos + turn);
+
+            auto begin = std::chrono::steady_clock::now();
+            auto fit = LM::FitSpiral(startPos, startHdg, endPos, endHdg);
+            micros.push_back(std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - begin).count());
+
+            ASSERT_NE(fit, nullptr);
+            EXPECT_LT(odr::euclDistance(fit->get_xy(fit->length), endPos), LM::SpiralPosPrecision);
+            EXPECT_LT(std::abs(odr::angle(fit->get_grad(fit->length), endHdg)), LM::SpiralHdgPrecision);
+        }
+        std::sort(micros.begin(), micros.end());
+        spdlog::info("FitSpiral: median {:.1f}us, 95% {:.1f}us", micros[micros.size() / 2], micros[micros.size() * 95 / 100]);
+    }
 }
\ No newline at end of file
@@ -0,0 +1,246 @@
+#include <gtest/gtest.h>
+
+#include "junction.h"
+#include "id_generator.h"
+#include "validation.h"
+#include "OpenDriveMap.h"
+#include "map_snapshot.h"
+#include "map_tiles.h"
+#include "constants.h"
+
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+
+namespace LTest
+{
+    // Roads of a 4-way junction, including its connecting roads
+    static odr::OpenDriveMap BuildJunctionMap(std::vector<std::shared_ptr<LM::Road>>& holder, std::shared_ptr<LM::Junction>& junction)
+    {
+        const double RoadLength = 40;
+        std::vector<LM::ConnectionInfo> connections;
+        for (int i = 0; i != 4; ++i)
+        {
+            LM::LaneProfile cfg(2, 0, 2, 0);
+            auto origin = odr::rotateCCW(odr::Vec2D{ 20, 0 }, M_PI_2 * i);
+            auto refLine = std::make_unique<odr::Line>(0, origin[0], origin[1], M_PI_2 * i, RoadLength);
+            holder.push_back(std::make_shared<LM::Road>(cfg, std::move(refLine)));
+            holder.back()->Generate();
+            connections.push_back(LM::ConnectionInfo{ holder.back(), odr::RoadLink::ContactPoint_Start });
+        }
+        junction = std::make_shared<LM::Junction>();
+        junction->CreateFrom(connections);
+
+        odr::OpenDriveMap map;
+        for (const auto& road : holder)
+        {
+            map.id_to_road.emplace(road->ID(), road->generated);
+        }
+        for (const auto& id_conn : junction->generated.id_to_connection)
+        {
+            auto connRoad = IDGenerator::ForType(IDType::Road)->GetByID<LM::Road>(id_conn.second.connecting_road);
+            map.id_to_road.emplace(connRoad->ID(), connRoad->generated);
+        }
+        map.id_to_junction.emplace(junction->ID(), junction->generated);
+        return map;
+    }
+
+    TEST(Serialization, ParallelLoadMatchesSerial)
+    {
+        std::shared_ptr<LM::Junction> junction;
+        std::vector<std::shared_ptr<LM::Road>> roads;
+        auto original = BuildJunctionMap(roads, junction);
+
+        auto dir = std::filesystem::temp_directory_path();
+        auto originalPath = (dir / "lm_parallel_load_src.xodr").string();
+        auto serialPath = (dir / "lm_parallel_load_serial.xodr").string();
+        auto parallelPath = (dir / "lm_parallel_load_parallel.xodr").string();
+        original.export_file(originalPath);
+
+        odr::OpenDriveMap serialMap, parallelMap;
+        EXPECT_TRUE(serialMap.Load(originalPath, false, true, true, true, false, true, true, 1));
+        EXPECT_TRUE(parallelMap.Load(originalPath, false, true, true, true, false, true, true, 4));
+        EXPECT_EQ(serialMap.id_to_road.size(), original.id_to_road.size());
+        EXPECT_EQ(parallelMap.id_to_road.size(), original.id_to_road.size());
+
+        serialMap.export_file(serialPath);
+        parallelMap.export_file(parallelPath);
+        EXPECT_TRUE(Validation::CompareFiles(serialPath, parallelPath));
+    }
+
+    TEST(Serialization, StreamedExportMatchesDOM)
+    {
+        std::shared_ptr<LM::Junction> junction;
+        std::vector<std::shared_ptr<LM::Road>> roads;
+        auto original = BuildJunctionMap(roads, junction);
+
+        auto dir = std::filesystem::temp_directory_path();
+        auto serialPath = (dir / "lm_export_serial.xodr").string();
+        auto parallelPath = (dir / "lm_export_parallel.xodr").string();
+        auto domPath = (dir / "lm_export_dom.xodr").string();
+        original.export_file(serialPath, 1);
+        original.export_file(parallelPath, 4);
+        EXPECT_TRUE(Validation::CompareFiles(serialPath, parallelPath));
+
+        // Same bytes as the pugixml DOM exporter it replaced
+        Validation::ExportDOM(original, domPath);
+        EXPECT_TRUE(Validation::CompareFiles(serialPath, domPath));
+    }
+
+    TEST(Serialization, StreamedExportMatchesDOMOnSampleMap)
+    {
+        // Sample map of libOpenDRIVE: spirals, arcs, signals (read but not exported) and a junction
+        auto samplePath = std::filesystem::path(__FILE__).parent_path().parent_path() / "libOpenDRIVE-master" / "test.xodr";
+        odr::OpenDriveMap map;
+        map.Load(samplePath.string());
+        ASSERT_FALSE(map.id_to_road.empty());
+
+        // Sample has no objects. Add one, with strings that need escaping.
+        auto& road = map.id_to_road.begin()->second;
+        road.id_to_object.emplace("obj1", odr::RoadObject(road.id, "obj1", 5, -2, 0.1, 1.5, 0, 0.5, 0, 1.2, 0.3, 0, 0,
+            "pole", "a<b & \"c\"", "+", "'sub'", false));
+
+        auto dir = std::filesystem::temp_directory_path();
+        auto serialPath = (dir / "lm_sample_serial.xodr").string();
+        auto parallelPath = (dir / "lm_sample_parallel.xodr").string();
+        auto domPath = (dir / "lm_sample_dom.xodr").string();
+        EXPECT_TRUE(map.export_file(serialPath, 1));
+        EXPECT_TRUE(map.export_file(parallelPath, 4));
+        EXPECT_TRUE(Validation::CompareFiles(serialPath, parallelPath));
+
+        Validation::ExportDOM(map, domPath);
+        EXPECT_TRUE(Validation::CompareFiles(serialPath, domPath));
+
+        std::ifstream ifs(serialPath);
+        std::stringstream buffer;
+        buffer << ifs.rdbuf();
+        for (auto element : { "<spiral", "<arc", "<object ", "<junction " })
+        {
+            EXPECT_NE(buffer.str().find(element), std::string::npos) << element;
+        }
+    }
+
+    TEST(Serialization, ExportReportsFailure)
+    {
+        std::shared_ptr<LM::Junction> junction;
+        std::vector<std::shared_ptr<LM::Road>> roads;
+        auto map = BuildJunctionMap(roads, junction);
+
+        auto dir = std::filesystem::temp_directory_path();
+        auto missingDirPath = (dir / "lm_no_such_dir" / "map.xodr").string();
+        EXPECT_FALSE(map.export_file(missingDirPath));
+        EXPECT_FALSE(std::filesystem::exists(missingDirPath + ".tmp"));
+
+        // Existing file is replaced, no temporary left behind
+        auto path = (dir / "lm_export_replace.xodr").string();
+        std::ofstream(path) << "old";
+        EXPECT_TRUE(map.export_file(path));
+        EXPECT_FALSE(std::filesystem::exists(path + ".tmp"));
+        std::ifstream ifs(path);
+        std::stringstream buffer;
+        buffer << ifs.rdbuf();
+        EXPECT_EQ(buffer.str().rfind("<?xml", 0), 0);
+    }
+
+    TEST(Serialization, IncrementalExportMatchesFull)
+    {
+        std::shared_ptr<LM::Junction> junction;
+        std::vector<std::shared_ptr<LM::Road>> roads;
+        auto map = BuildJunctionMap(roads, junction);
+
+        auto dir = std::filesystem::temp_directory_path();
+        auto incrementalPath = (dir / "lm_export_incremental.xodr").string();
+        auto fullPath = (dir / "lm_export_full.xodr").string();
+
+        odr::XodrFragmentCache cache;
+        map.export_file(incrementalPath, cache);
+        EXPECT_EQ(cache.road_fragments.size(), map.id_to_road.size());
+        EXPECT_EQ(cache.junction_fragments.size(), map.id_to_junction.size());
+
+        // Edit one road, remove another
+        auto editedID = roads[0]->ID();
+        auto removedID = roads[1]->ID();
+        map.id_to_road.at(editedID).name = "edited";
+        map.id_to_road.erase(removedID);
+        cache.dirty_roads.insert(editedID);
+        cache.dirty_roads.insert(removedID);
+
+        map.export_file(incrementalPath, cache);
+        map.export_file(fullPath);
+        EXPECT_TRUE(cache.dirty_roads.empty());
+        EXPECT_EQ(cache.road_fragments.size(), map.id_to_road.size());
+        EXPECT_TRUE(Validation::CompareFiles(incrementalPath, fullPath));
+
+        // Snapshot source hash comes from the cache, matching the file on disk
+        std::ifstream ifs(incrementalPath);
+        std::stringstream buffer;
+        buffer << ifs.rdbuf();
+        EXPECT_EQ(cache.content_hash(), LM::MapSnapshot::SourceHash(buffer.str()));
+
+        // Roads not marked dirty are not re-encoded
+        map.id_to_road.at(roads[2]->ID()).name = "unmarked";
+        map.export_file(incrementalPath, cache);
+        map.export_file(fullPath);
+        EXPECT_FALSE(Validation::CompareFiles(incrementalPath, fullPath));
+    }
+
+    TEST(Serialization, TileIndex)
+    {
+        std::shared_ptr<LM::Junction> junction;
+        std::vector<std::shared_ptr<LM::Road>> roads;
+        auto map = BuildJunctionMap(roads, junction);
+
+        LM::MapTiles tiles;
+        tiles.Build(map);
+        EXPECT_FALSE(tiles.Empty());
+
+        // Connecting roads are not indexed on their own
+        auto nearby = tiles.RoadsAround(LM::MapTiles::TileAt(0, 0), 1);
+        EXPECT_EQ(nearby.size(), roads.size());
+        EXPECT_TRUE(tiles.RoadsAround(LM::MapTiles::TileAt(100 * LM::MapTileSize, 0), 1).empty());
+
+        EXPECT_EQ(tiles.JunctionRoads(junction->ID()).size(), roads.size());
+        for (const auto& road : roads)
+        {
+            EXPECT_EQ(tiles.RoadJunctions(road->ID()), std::set<std::string>{ junction->ID() });
+        }
+
+        auto removedID = roads[0]->ID();
+        map.id_to_road.erase(removedID);
+        tiles.Update(map, { removedID });
+        EXPECT_EQ(tiles.RoadsAround(LM::MapTiles::TileAt(0, 0), 1).count(removedID), 0);
+        EXPECT_EQ(tiles.JunctionRoads(junction->ID()).size(), roads.size() - 1);
+        EXPECT_TRUE(tiles.RoadJunctions(removedID).empty());
+    }
+
+    TEST(Serialization, SnapshotRoundTrip)
+    {
+        std::shared_ptr<LM::Junction> junction;
+        std::vector<std::shared_ptr<LM::Road>> roads;
+        auto original = BuildJunctionMap(roads, junction);
+
+        auto dir = std::filesystem::temp_directory_path();
+        auto originalPath = (dir / "lm_snapshot_src.xodr").string();
+        auto restoredPath = (dir / "lm_snapshot_restored.xodr").string();
+        auto snapshotPath = LM::MapSnapshot::PathFor(originalPath);
+        original.export_file(originalPath);
+
+        const uint64_t sourceHash = 42;
+        EXPECT_TRUE(LM::MapSnapshot::Save(original, snapshotPath, sourceHash, true));
+        EXPECT_FALSE(std::filesystem::exists(snapshotPath + ".tmp"));
+        auto unwritablePath = (dir / "lm_no_such_dir" / "lm_snapshot.lmsnap").string();
+        EXPECT_FALSE(LM::MapSnapshot::Save(original, unwritablePath, sourceHash, true));
+
+        odr::OpenDriveMap restored;
+        bool supported = false;
+        EXPECT_FALSE(LM::MapSnapshot::Load(restored, snapshotPath, sourceHash + 1, supported));
+        EXPECT_TRUE(restored.id_to_road.empty());
+        EXPECT_TRUE(LM::MapSnapshot::Load(restored, snapshotPath, sourceHash, supported));
+        EXPECT_TRUE(supported);
+        EXPECT_EQ(restored.id_to_road.size(), original.id_to_road.size());
+        EXPECT_EQ(restored.id_to_junction.size(), original.id_to_junction.size());
+
+        restored.export_file(restoredPath);
+        EXPECT_TRUE(Validation::CompareFiles(originalPath, restoredPath));
+    }
+}
@@ -0,0 +1,526 @@
+#include <gtest/gtest.h>
+
+#include "dynamic_bvh.h"
+#include "spatial_indexer.h"
+#include "road.h"
+
+#include "Geometries/Line.h"
+#include "Geometries/Arc.h"
+
+#include <CGAL/Simple_cartesian.h>
+#include <CGAL/Surface_mesh.h>
+#include <CGAL/AABB_tree.h>
+#include <CGAL/AABB_traits.h>
+#include <CGAL/AABB_face_graph_triangle_primitive.h>
+
+#include "spdlog/spdlog.h"
+#include <algorithm>
+#include <chrono>
+#include <map>
+#include <random>
+#include <set>
+
+namespace LTest
+{
+    static std::set<uint32_t> BruteForceRayHits(const std::map<uint32_t, LM::DynamicBVH::AABB>& boxes,
+        const odr::Vec3D& origin, const odr::Vec3D& dir, double tMax)
+    {
+        std::set<uint32_t> rtn;
+        for (const auto& idAndBox : boxes)
+        {
+            if (idAndBox.second.IntersectRay(origin, dir, tMax))
+            {
+                rtn.insert(idAndBox.first);
+            }
+        }
+        return rtn;
+    }
+
+    TEST(SpatialIndex, DynamicBVHMatchesBruteForce)
+    {
+        std::mt19937 gen(7);
+        std::uniform_real_distribution<double> xy(-100, 100), z(0, 20), size(0.5, 10);
+
+        LM::DynamicBVH bvh;
+        std::map<uint32_t, LM::DynamicBVH::AABB> boxes;
+        std::map<uint32_t, int> handles;
+        const int NBoxes = 2000;
+        for (uint32_t i = 0; i != NBoxes; ++i)
+        {
+            odr::Vec3D p{ xy(gen), xy(gen), z(gen) };
+            // Flat boxes, like road faces
+            LM::DynamicBVH::AABB box{ p, odr::Vec3D{ p[0] + size(gen), p[1] + size(gen), p[2] } };
+            boxes.emplace(i, box);
+            handles.emplace(i, bvh.Insert(box, i));
+        }
+        // Remove every third, as edits do
+        for (uint32_t i = 0; i < NBoxes; i += 3)
+        {
+            bvh.Remove(handles.at(i));
+            boxes.erase(i);
+        }
+        EXPECT_EQ(bvh.Size(), boxes.size());
+        EXPECT_LT(bvh.Height(), 40);
+
+        for (int q = 0; q != 200; ++q)
+        {
+            odr::Vec3D origin{ xy(gen), xy(gen), 50 };
+            odr::Vec3D dir = q % 2 == 0 ? odr::Vec3D{ 0, 0, -1 } :
+                odr::normalize(odr::Vec3D{ xy(gen) - origin[0], xy(gen) - origin[1], -50 });
+
+            std::set<uint32_t> fromBVH;
+            bvh.RayQuery(origin, dir, 100, [&](uint32_t id, double&) { fromBVH.insert(id); });
+            EXPECT_EQ(fromBVH, BruteForceRayHits(boxes, origin, dir, 100));
+        }
+    }
+
+    TEST(SpatialIndex, MultiBoxQueryMatchesSingleQueries)
+    {
+        std::mt19937 gen(11);
+        std::uniform_real_distribution<double> xy(-100, 100), size(0.5, 10);
+
+        LM::DynamicBVH bvh;
+        std::vector<LM::DynamicBVH::AABB> boxes;
+        for (uint32_t i = 0; i != 2000; ++i)
+        {
+            odr::Vec3D p{ xy(gen), xy(gen), 0 };
+            boxes.push_back(LM::DynamicBVH::AABB{ p, odr::Vec3D{ p[0] + size(gen), p[1] + size(gen), 0 } });
+            bvh.Insert(boxes.back(), i);
+        }
+
+        // Chunks along a corridor, as Road::AllOverlaps queries
+        std::vector<LM::DynamicBVH::AABB> queries;
+        for (int i = 0; i != 50; ++i)
+        {
+            odr::Vec3D p{ -100.0 + 4 * i, -50.0 + 2 * i, -0.1 };
+            queries.push_back(LM::DynamicBVH::AABB{ p, odr::Vec3D{ p[0] + 4, p[1] + 3, 0.1 } });
+        }
+
+        std::set<std::pair<uint32_t, int>> fromBVH, expected;
+        bvh.MultiBoxQuery(queries, [&](uint32_t id, int query) { fromBVH.emplace(id, query); });
+        for (int q = 0; q != queries.size(); ++q)
+        {
+            for (uint32_t i = 0; i != boxes.size(); ++i)
+            {
+                if (boxes[i].Overlaps(queries[q]))
+                {
+                    expected.emplace(i, q);
+                }
+            }
+        }
+        EXPECT_FALSE(expected.empty());
+        EXPECT_EQ(fromBVH, expected);
+    }
+
+    // Triangle and info of an indexed face, kept outside the indexer
+    struct FaceRecord
+    {
+        odr::Vec3D v[3];
+        std::string roadID;
+        int laneIDNormal, laneIDReversed;
+        double sBegin, sEnd;
+        bool magneticArea;
+
+        int GetLaneID() const { return sBegin < sEnd ? laneIDNormal : laneIDReversed; }
+    };
+
+    // Ray parameter where the ray crosses the triangle plane inside its edges, -1 if missed.
+    // Edges are pushed out by tolerance, or pulled in if negative.
+    static double RayHitsTriangle(const odr::Vec3D (&v)[3], const odr::Vec3D& origin, const odr::Vec3D& dir, double tolerance)
+    {
+        const auto normal = odr::crossProduct(odr::sub(v[1], v[0]), odr::sub(v[2], v[0]));
+        const double denom = odr::dot(normal, dir);
+        if (std::abs(denom) < 1e-12)
+        {
+            return -1;
+        }
+        const double t = odr::dot(normal, odr::sub(v[0], origin)) / denom;
+        if (t < 0)
+        {
+            return -1;
+        }
+        const auto p = odr::add(origin, odr::mut(t, dir));
+        for (int i = 0; i != 3; ++i)
+        {
+            const auto edge = odr::sub(v[(i + 1) % 3], v[i]);
+            const auto inward = odr::normalize(odr::crossProduct(normal, edge));
+            if (odr::dot(inward, odr::sub(p, v[i])) < -tolerance)
+            {
+                return -1;
+            }
+        }
+        return t;
+    }
+
+    // Indexes lane quads like SectionGraphics does, and answers the same queries by scanning every face
+    class BruteForceIndex
+    {
+    public:
+        LM::SpatialIndexer indexer;
+        std::map<uint32_t, FaceRecord> faces;
+        std::vector<LM::FaceIndex_t> quads;
+
+        void IndexRoad(const odr::Road& road)
+        {
+            const double QuadLength = 3, MagneticLength = 2;
+            for (const auto& idAndLane : road.s_to_lanesection.begin()->second.id_to_lane)
+            {
+                const auto& lane = idAndLane.second;
+                if (lane.id == 0)
+                {
+                    continue;
+                }
+                for (double s = 0; s < road.length; s += QuadLength)
+                {
+                    Add(LM::SpatialIndexer::Prepare(road, lane, s, std::min(s + QuadLength, road.length)));
+                }
+                Add(LM::SpatialIndexer::Prepare(road, lane, -MagneticLength, 0));
+                Add(LM::SpatialIndexer::Prepare(road, lane, road.length, road.length + MagneticLength));
+            }
+        }
+
+        void UnIndex(std::size_t quadIndex)
+        {
+            indexer.UnIndex(quads[quadIndex]);
+            for (auto faceID : FaceIDs(quads[quadIndex]))
+            {
+                faces.erase(faceID);
+            }
+            quads.erase(quads.begin() + quadIndex);
+        }
+
+        void UpdateFaces(std::size_t quadIndex, const std::string& newRoadID, int mult, double shift)
+        {
+            indexer.UpdateFaces(quads[quadIndex], newRoadID, mult, shift);
+            for (auto faceID : FaceIDs(quads[quadIndex]))
+            {
+                auto& face = faces.at(faceID);
+                face.roadID = newRoadID;
+                face.sBegin = face.sBegin * mult + shift;
+                face.sEnd = face.sEnd * mult + shift;
+            }
+        }
+
+        void VerifyRayCast(const LM::RayCastQuery& ray)
+        {
+            // Hits well inside a face must be found; hits on a face edge may go either way
+            const double EdgeTolerance = 1e-6;
+            double mustHitT = std::numeric_limits<double>::infinity();
+            std::vector<std::pair<double, uint32_t>> mayHit;
+            for (const auto& idAndFace : faces)
+            {
+                if (ray.skip(idAndFace.first))
+                {
+                    continue;
+                }
+                double t = RayHitsTriangle(idAndFace.second.v, ray.origin, ray.direction, -EdgeTolerance);
+                if (t >= 0)
+                {
+                    mustHitT = std::min(mustHitT, t);
+                }
+                t = RayHitsTriangle(idAndFace.second.v, ray.origin, ray.direction, EdgeTolerance);
+                if (t >= 0)
+                {
+                    mayHit.emplace_back(t, idAndFace.first);
+                }
+            }
+
+            auto result = indexer.RayCast(ray);
+            if (!result.hit)
+            {
+                EXPECT_EQ(mustHitT, std::numeric_limits<double>::infinity());
+                return;
+            }
+            const double resultT = odr::euclDistance(ray.origin, result.hitPos) / odr::norm(ray.direction);
+            EXPECT_LE(resultT, mustHitT + 1e-6);
+
+            // Same road, lane and s range as some face crossed at that distance
+            bool matched = false;
+            for (const auto& tAndFace : mayHit)
+            {
+                const auto& face = faces.at(tAndFace.second);
+                matched |= std::abs(tAndFace.first - resultT) < 1e-6 && face.roadID == result.roadID &&
+                    face.GetLaneID() == result.lane &&
+                    result.s > std::min(face.sBegin, face.sEnd) - 0.5 && result.s < std::max(face.sBegin, face.sEnd) + 0.5;
+            }
+            EXPECT_TRUE(matched);
+        }
+
+        void VerifyAllOverlaps(const std::vector<odr::Vec3D>& points, double zRange)
+        {
+            const double EdgeTolerance = 1e-6;
+            auto results = indexer.AllOverlaps(points, zRange);
+            ASSERT_EQ(results.size(), points.size());
+            for (std::size_t i = 0; i != points.size(); ++i)
+            {
+                std::multiset<std::pair<std::string, int>> mustHit, mayHit, actual;
+                const odr::Vec3D rayOrigin{ points[i][0], points[i][1], points[i][2] + zRange };
+                for (const auto& idAndFace : faces)
+                {
+                    const auto& face = idAndFace.second;
+                    if (face.magneticArea)
+                    {
+                        continue;
+                    }
+                    for (double tolerance : { -EdgeTolerance, EdgeTolerance })
+                    {
+                        double t = RayHitsTriangle(face.v, rayOrigin, odr::Vec3D{ 0, 0, -1 }, tolerance);
+                        if (t >= 0 && t <= 2 * zRange)
+                        {
+                            (tolerance < 0 ? mustHit : mayHit).emplace(face.roadID, face.GetLaneID());
+                        }
+                    }
+                }
+                for (const auto& result : results[i])
+                {
+                    actual.emplace(result.roadID, result.lane);
+                }
+                EXPECT_TRUE(std::includes(actual.begin(), actual.end(), mustHit.begin(), mustHit.end()));
+                EXPECT_TRUE(std::includes(mayHit.begin(), mayHit.end(), actual.begin(), actual.end()));
+            }
+        }
+
+        // Centroids of faces, lifted slightly so they are not exactly on the surface
+        std::vector<odr::Vec3D> SamplePoints(std::mt19937& gen, int n) const
+        {
+            std::vector<const FaceRecord*> nonMagnetic;
+            for (const auto& idAndFace : faces)
+            {
+                if (!idAndFace.second.magneticArea)
+                {
+                    nonMagnetic.push_back(&idAndFace.second);
+                }
+            }
+            std::vector<odr::Vec3D> rtn;
+            for (int i = 0; i != n; ++i)
+            {
+                const auto& v = nonMagnetic[gen() % nonMagnetic.size()]->v;
+                auto centroid = odr::mut(1.0 / 3, odr::add(odr::add(v[0], v[1]), v[2]));
+                centroid[2] += 0.002;
+                rtn.push_back(centroid);
+            }
+            return rtn;
+        }
+
+    private:
+        static std::vector<uint32_t> FaceIDs(LM::FaceIndex_t index)
+        {
+            std::vector<uint32_t> rtn;
+            for (uint32_t faceID : { static_cast<uint32_t>(index >> 32), static_cast<uint32_t>(index & 0xffffffff) })
+            {
+                if (faceID != LM::SpatialIndexer::InvalidFace)
+                {
+                    rtn.push_back(faceID);
+                }
+            }
+            return rtn;
+        }
+
+        void Add(const LM::PreparedQuad& quad)
+        {
+            auto index = indexer.Index(quad);
+            quads.push_back(index);
+
+            const odr::Vec3D s1t1{ quad.p1[0], quad.p1[1], quad.h12 };
+            const odr::Vec3D s1t2{ quad.p2[0], quad.p2[1], quad.h12 };
+            const odr::Vec3D s2t1{ quad.p3[0], quad.p3[1], quad.h34 };
+            const odr::Vec3D s2t2{ quad.p4[0], quad.p4[1], quad.h34 };
+            const auto& info = quad.info;
+            uint32_t face1ID = index >> 32, face2ID = index & 0xffffffff;
+            for (auto faceID : { face1ID, face2ID })
+            {
+                if (faceID == LM::SpatialIndexer::InvalidFace)
+                {
+                    continue;
+                }
+                EXPECT_EQ(faces.count(faceID), 0) << "face ID handed out twice";
+                FaceRecord face{ { s1t1, s1t2, s2t1 }, quad.roadID, info.laneIDNormal, info.laneIDReversed,
+                    info.sBegin, info.sEnd, info.magneticArea };
+                if (faceID == face2ID)
+                {
+                    face.v[0] = s2t1;
+                    face.v[1] = s1t2;
+                    face.v[2] = s2t2;
+                }
+                faces.emplace(faceID, face);
+            }
+        }
+    };
+
+    // Straight or curved 2-lane-each-side road at a random height, so that some roads cross over others
+    static std::shared_ptr<LM::Road> RandomElevatedRoad(std::mt19937& gen)
+    {
+        std::uniform_real_distribution<double> xy(-150, 150), hdg(-M_PI, M_PI), length(30, 150),
+            curvature(-1.0 / 40, 1.0 / 40), height(0, 10), slope(-0.05, 0.05);
+        std::unique_ptr<odr::RoadGeometry> geo;
+        if (gen() % 2 == 0)
+        {
+            geo = std::make_unique<odr::Line>(0, xy(gen), xy(gen), hdg(gen), length(gen));
+        }
+        else
+        {
+            geo = std::make_unique<odr::Arc>(0, xy(gen), xy(gen), hdg(gen), length(gen), curvature(gen));
+        }
+        auto road = std::make_shared<LM::Road>(LM::LaneProfile(2, 0, 2, 0), std::move(geo));
+        road->generated.ref_line.elevation_profile.s0_to_poly.emplace(0, odr::Poly3(0, height(gen), slope(gen), 0, 0));
+        return road;
+    }
+
+    // Rays sweeping across the map like a dragged cursor, sometimes skipping a picked quad
+    static std::vector<LM::RayCastQuery> DragRays(std::mt19937& gen, const std::vector<LM::FaceIndex_t>& quads, int n)
+    {
+        std::uniform_real_distribution<double> xy(-160, 160), jitter(-0.5, 0.5);
+        std::vector<LM::RayCastQuery> rtn;
+        odr::Vec3D eye{ 0, -200, 150 };
+        odr::Vec2D target{ xy(gen), xy(gen) };
+        for (int i = 0; i != n; ++i)
+        {
+            if (i % 50 == 0)
+            {
+                target = odr::Vec2D{ xy(gen), xy(gen) };
+            }
+            target[0] += jitter(gen);
+            target[1] += jitter(gen);
+            LM::RayCastQuery ray;
+            ray.origin = eye;
+            ray.direction = odr::normalize(odr::Vec3D{ target[0] - eye[0], target[1] - eye[1], -eye[2] });
+            if (i % 5 == 0 && !quads.empty())
+            {
+                ray.skip = LM::RayCastSkip(std::set<LM::FaceIndex_t>{ quads[gen() % quads.size()] });
+            }
+            rtn.push_back(ray);
+        }
+        return rtn;
+    }
+
+    TEST(SpatialIndex, IndexerMatchesBruteForce)
+    {
+        std::mt19937 gen(23);
+        std::vector<std::shared_ptr<LM::Road>> roads;
+        BruteForceIndex index;
+        for (int i = 0; i != 12; ++i)
+        {
+            roads.push_back(RandomElevatedRoad(gen));
+            index.IndexRoad(roads.back()->generated);
+        }
+        auto verify = [&]()
+        {
+            for (const auto& ray : DragRays(gen, index.quads, 400))
+            {
+                index.VerifyRayCast(ray);
+            }
+            index.VerifyAllOverlaps(index.SamplePoints(gen, 300), 0.01);
+        };
+        verify();
+
+        // Freed face IDs are reused by faces of new roads
+        const uint32_t maxFaceID = index.faces.rbegin()->first;
+        for (std::size_t i = 0; i < index.quads.size(); i += 2)
+        {
+            index.UnIndex(i);
+        }
+        verify();
+        const auto nFacesBefore = index.faces.size();
+        for (int i = 0; i != 3; ++i)
+        {
+            roads.push_back(RandomElevatedRoad(gen));
+            index.IndexRoad(roads.back()->generated);
+        }
+        const auto nRecycled = std::count_if(index.faces.begin(), index.faces.end(),
+            [&](const auto& idAndFace) { return idAndFace.first <= maxFaceID; }) - nFacesBefore;
+        EXPECT_GT(nRecycled, 0);
+        verify();
+
+        // Faces handed to another road, as in road join / split
+        for (std::size_t i = 0; i < index.quads.size(); i += 4)
+        {
+            index.UpdateFaces(i, "moved" + std::to_string(i % 3), -1, 500);
+        }
+        verify();
+    }
+
+    TEST(SpatialIndex, PickBenchmark)
+    {
+        typedef CGAL::Simple_cartesian<double> K;
+        typedef CGAL::Surface_mesh<K::Point_3> Mesh;
+        typedef CGAL::AABB_tree<CGAL::AABB_traits<K, CGAL::AABB_face_graph_triangle_primitive<Mesh>>> Tree;
+
+        std::mt19937 gen(29);
+        std::vector<std::shared_ptr<LM::Road>> roads;
+        std::vector<LM::PreparedQuad> quads;
+        for (int i = 0; i != 200; ++i)
+        {
+            roads.push_back(RandomElevatedRoad(gen));
+            const auto& road = roads.back()->generated;
+            for (const auto& idAndLane : road.s_to_lanesection.begin()->second.id_to_lane)
+            {
+                for (double s = 0; s < road.length && idAndLane.first != 0; s += 3)
+                {
+                    quads.push_back(LM::SpatialIndexer::Prepare(road, idAndLane.second, s, std::min(s + 3, road.length)));
+                }
+            }
+        }
+        auto rays = DragRays(gen, {}, 20000);
+
+        auto micros = [](auto begin) {
+            return std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - begin).count(); };
+        auto percentiles = [](std::vector<double>& ns) {
+            std::sort(ns.begin(), ns.end());
+            return std::make_pair(ns[ns.size() / 2], ns[ns.size() * 99 / 100]); };
+
+        LM::SpatialIndexer indexer;
+        auto begin = std::chrono::steady_clock::now();
+        auto indexerBytes = AllocatedBytesDuring([&]() {
+            for (const auto& quad : quads)
+            {
+                indexer.Index(quad);
+            }
+        });
+        const double indexerBuildMicros = micros(begin);
+
+        Mesh mesh;
+        Tree tree;
+        begin = std::chrono::steady_clock::now();
+        auto cgalBytes = AllocatedBytesDuring([&]() {
+            for (const auto& quad : quads)
+            {
+                auto s1t1 = mesh.add_vertex(K::Point_3(quad.p1[0], quad.p1[1], quad.h12));
+                auto s1t2 = mesh.add_vertex(K::Point_3(quad.p2[0], quad.p2[1], quad.h12));
+                auto s2t1 = mesh.add_vertex(K::Point_3(quad.p3[0], quad.p3[1], quad.h34));
+                auto s2t2 = mesh.add_vertex(K::Point_3(quad.p4[0], quad.p4[1], quad.h34));
+                mesh.add_face(s1t1, s1t2, s2t1);
+                mesh.add_face(s2t1, s1t2, s2t2);
+            }
+            tree.insert(faces(mesh).begin(), faces(mesh).end(), mesh);
+            tree.build();
+        });
+        const double cgalBuildMicros = micros(begin);
+
+        std::vector<double> indexerNS, cgalNS;
+        int nDisagree = 0;
+        for (const auto& ray : rays)
+        {
+            begin = std::chrono::steady_clock::now();
+            auto result = indexer.RayCast(ray);
+            indexerNS.push_back(micros(begin) * 1000);
+
+            begin = std::chrono::steady_clock::now();
+            auto cgalResult = tree.first_intersection(K::Ray_3(K::Point_3(ray.origin[0], ray.origin[1], ray.origin[2]),
+                K::Vector_3(ray.direction[0], ray.direction[1], ray.direction[2])));
+            cgalNS.push_back(micros(begin) * 1000);
+
+            if (result.hit != static_cast<bool>(cgalResult))
+            {
+                ++nDisagree;
+            }
+        }
+        EXPECT_LE(nDisagree, static_cast<int>(rays.size()) / 1000);
+
+        auto indexerPercentiles = percentiles(indexerNS), cgalPercentiles = percentiles(cgalNS);
+        spdlog::info("{} faces. SpatialIndexer: build {:.0f}us, {}KB allocated, {}KB kept, pick median {:.0f}ns 99% {:.0f}ns",
+            mesh.number_of_faces(), indexerBuildMicros, indexerBytes / 1024, indexer.MemoryUsage() / 1024,
+            indexerPercentiles.first, indexerPercentiles.second);
+        spdlog::info("CGAL AABB_tree: build {:.0f}us, {}KB allocated, pick median {:.0f}ns 99% {:.0f}ns",
+            cgalBuildMicros, cgalBytes / 1024, cgalPercentiles.first, cgalPercentiles.second);
+    }
+}
@@ -1,10 +1,16 @@
 #include <gtest/gtest.h>
 
+#include "allocation_test.h"
 #include "lane_profile_test.h"
 #include "elevation_profile_test.h"
 #include "junction_test.h"
+#include "latest_worker_test.h"
+#include "polyline_test.h"
 #include "road_geometry_test.h"
 #include "road_operation_test.h"
+#include "serialization_test.h"
+#include "spatial_index_test.h"
+#include "triangulation_test.h"
 
 namespace LTest
 {
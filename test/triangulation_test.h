@@ -0,0 +1,144 @@
+#include <gtest/gtest.h>
+
+#include "triangulation.h"
+
+#include "spdlog/spdlog.h"
+#include <chrono>
+#include <random>
+
+namespace LTest
+{
+    double SignedArea(const odr::Line3D& boundary)
+    {
+        double area = 0;
+        for (size_t i = 0; i != boundary.size(); ++i)
+        {
+            const auto& a = boundary[i];
+            const auto& b = boundary[(i + 1) % boundary.size()];
+            area += a[0] * b[1] - a[1] * b[0];
+        }
+        return area / 2;
+    }
+
+    bool InsidePolygon(const odr::Line3D& boundary, const odr::Vec2D& p)
+    {
+        bool inside = false;
+        for (size_t i = 0, j = boundary.size() - 1; i != boundary.size(); j = i++)
+        {
+            const auto& a = boundary[i];
+            const auto& b = boundary[j];
+            if ((a[1] > p[1]) != (b[1] > p[1]) &&
+                p[0] < (b[0] - a[0]) * (p[1] - a[1]) / (b[1] - a[1]) + a[0])
+            {
+                inside = !inside;
+            }
+        }
+        return inside;
+    }
+
+    // Triangles are counter-clockwise, lie inside and cover the polygon
+    void VerifyTriangulation(const odr::Line3D& boundary, const std::vector<std::tuple<int, int, int>>& triangles)
+    {
+        double totalArea = 0;
+        for (const auto& tri : triangles)
+        {
+            const auto& a = boundary[std::get<0>(tri)];
+            const auto& b = boundary[std::get<1>(tri)];
+            const auto& c = boundary[std::get<2>(tri)];
+            double area = ((b[0] - a[0]) * (c[1] - a[1]) - (b[1] - a[1]) * (c[0] - a[0])) / 2;
+            EXPECT_GT(area, 0);
+            totalArea += area;
+            odr::Vec2D centroid{ (a[0] + b[0] + c[0]) / 3, (a[1] + b[1] + c[1]) / 3 };
+            EXPECT_TRUE(InsidePolygon(boundary, centroid));
+        }
+        double polygonArea = std::abs(SignedArea(boundary));
+        EXPECT_NEAR(totalArea, polygonArea, polygonArea * 1e-9);
+    }
+
+    odr::Line3D RandomStarPolygon(std::mt19937& rng, int nVertices, bool ccw)
+    {
+        std::uniform_real_distribution<double> radius(5, 50);
+        odr::Line3D rtn;
+        for (int i = 0; i != nVertices; ++i)
+        {
+            double angle = (ccw ? 1 : -1) * M_PI * 2 * i / nVertices;
+            double r = radius(rng);
+            rtn.push_back(odr::Vec3D{ r * std::cos(angle), r * std::sin(angle), 0.01 * i });
+        }
+        return rtn;
+    }
+
+    // Teeth along x, sampled every 1m so that many vertice are collinear
+    odr::Line3D CombPolygon(int nTeeth)
+    {
+        odr::Line3D rtn;
+        for (int i = 0; i != nTeeth; ++i)
+        {
+            for (double y = 0; y < 10; y += 1)
+                rtn.push_back(odr::Vec3D{ i * 4.0, y, 0 });
+            for (double y = 10; y > 2; y -= 1)
+                rtn.push_back(odr::Vec3D{ i * 4.0 + 2, y, 0 });
+        }
+        rtn.push_back(odr::Vec3D{ nTeeth * 4.0, 10, 0 });
+        rtn.push_back(odr::Vec3D{ nTeeth * 4.0, -5, 0 });
+        rtn.push_back(odr::Vec3D{ 0, -5, 0 });
+        return rtn;
+    }
+
+    TEST(Triangulation, EarClippingMatchesCDT)
+    {
+        std::mt19937 rng(11);
+        double earMicros = 0, cdtMicros = 0;
+        for (int iter = 0; iter != 300; ++iter)
+        {
+            auto boundary = RandomStarPolygon(rng, 3 + iter % 120, iter % 2 == 0);
+
+            std::vector<std::tuple<int, int, int>> earTriangles;
+            auto begin = std::chrono::steady_clock::now();
+            bool simple = LM::TriangulateEarClipping(boundary, earTriangles);
+            auto mid = std::chrono::steady_clock::now();
+            auto cdtTriangles = LM::TriangulateCDT(boundary);
+            auto end = std::chrono::steady_clock::now();
+            earMicros += std::chrono::duration<double, std::micro>(mid - begin).count();
+            cdtMicros += std::chrono::duration<double, std::micro>(end - mid).count();
+
+            ASSERT_TRUE(simple);
+            EXPECT_EQ(earTriangles.size(), boundary.size() - 2);
+            EXPECT_EQ(earTriangles.size(), cdtTriangles.size());
+            VerifyTriangulation(boundary, earTriangles);
+            VerifyTriangulation(boundary, cdtTriangles);
+        }
+        spdlog::info("Triangulate 300 polygons: ear clipping {:.0f}us, CDT {:.0f}us", earMicros, cdtMicros);
+    }
+
+    TEST(Triangulation, CollinearAndReflexVertice)
+    {
+        for (int nTeeth : { 1, 5, 30 })
+        {
+            auto boundary = CombPolygon(nTeeth);
+            std::vector<std::tuple<int, int, int>> triangles;
+            ASSERT_TRUE(LM::TriangulateEarClipping(boundary, triangles));
+            VerifyTriangulation(boundary, triangles);
+
+            std::reverse(boundary.begin(), boundary.end());
+            ASSERT_TRUE(LM::TriangulateEarClipping(boundary, triangles));
+            VerifyTriangulation(boundary, triangles);
+        }
+    }
+
+    TEST(Triangulation, DegenerateFallsBackToCDT)
+    {
+        std::vector<odr::Line3D> degenerates = {
+            { { 0, 0, 0 }, { 1, 1, 0 }, { 1, 0, 0 }, { 0, 1, 0 } },             // bow tie
+            { { 0, 0, 0 }, { 2, 0, 0 }, { 2, 0, 0 }, { 2, 2, 0 }, { 0, 2, 0 } }, // repeated vertex
+            { { 0, 0, 0 }, { 1, 0, 0 }, { 2, 0, 0 } },                          // no area
+            { { 0, 0, 0 }, { 2, 0, 0 }, { 1, 0, 0 }, { 1, 2, 0 } },             // edge folds back
+        };
+        for (const auto& boundary : degenerates)
+        {
+            std::vector<std::tuple<int, int, int>> triangles;
+            EXPECT_FALSE(LM::TriangulateEarClipping(boundary, triangles));
+            EXPECT_EQ(LM::Triangulate_2_5d(boundary), LM::TriangulateCDT(boundary));
+        }
+    }
+}
@@ -1,9 +1,10 @@
 #pragma once
 
 #include <string>
+#include <vector>
 
 namespace odr {
-    class Road; class CubicSpline; class Lane;
+    class Road; class CubicSpline; class Lane; class OpenDriveMap;
 }
 namespace LM {
     class Road;
@@ -30,6 +31,13 @@ namespace LTest
 
         static void VerifySingleRoadElevation(const odr::CubicSpline&);
 
+        static std::vector<const odr::Road*> ConnectingRoads(const LM::Junction* junction);
+
+#ifdef G_TEST
+        /*OpenDriveMap::export_file as it was before streaming, building a pugixml DOM. Defined in dom_export.cpp*/
+        static void ExportDOM(const odr::OpenDriveMap& map, const std::string& fpath);
+#endif
+
     private:
 #ifndef G_TEST
         static void RoadIDSetMatch();
@@ -4,6 +4,7 @@
 #include "id_generator.h"
 #include "map_view_gl.h"
 #include "spatial_indexer.h"
+#include "spatial_indexer_dynamic.h"
 
 #include <math.h>
 #include <sstream>
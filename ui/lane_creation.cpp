@@ -20,6 +20,7 @@ LanesCreationSession::LanesCreationSession() :
 
 bool LanesCreationSession::Complete()
 {
+    FlushFits();
     if (extendFromStart.expired() && joinAtEnd.expired())
     {
         // Standalone road
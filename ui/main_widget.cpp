@@ -2,6 +2,7 @@
 // SPDX-License-Identifier: LicenseRef-Qt-Commercial OR BSD-3-Clause
 
 #include <QtWidgets>
+#include <CGAL/exceptions.h>
 
 #include "main_widget.h"
 #include "map_view_gl.h"
@@ -9,6 +10,7 @@
 #include "action_manager.h"
 #include "road_drawing.h"
 #include "change_tracker.h"
+#include "junction.h"
 #include "CreateRoadOptionWidget.h"
 
 extern SectionProfileConfigWidget* g_createRoadOption;
@@ -213,10 +215,29 @@ void MainWidget::OnKeyPress(LM::KeyPressAction evt)
 #endif
 }
 
+void MainWidget::ApplyAsyncResults()
+{
+    if (drawingSession != nullptr && drawingSession->ApplyAsyncResults())
+    {
+        mapViewGL->requestUpdate();
+    }
+}
+
 void MainWidget::confirmEdit()
 {
     LM::ChangeTracker::Instance()->StartRecordEdit();
-    bool cleanState = drawingSession->Complete();
+    bool cleanState;
+    try
+    {
+        cleanState = drawingSession->Complete();
+    }
+    catch (...)
+    {
+        // FinishRecordEdit won't run: end deferral here, or later edits never regenerate junctions.
+        // Regenerating from a half-done edit could throw again, so pending junctions are dropped.
+        LM::AbstractJunction::AbortDeferRegeneration();
+        throw;
+    }
     LM::ChangeTracker::Instance()->FinishRecordEdit(!cleanState);
     quitEdit();
 }
@@ -243,11 +264,22 @@ void MainWidget::Painted()
         auto fps = static_cast<double>(nRepaints) * 1000 / deltaMS;
         auto fpsInt = static_cast<int>(fps);
         auto displayStr = QString::fromStdString(std::to_string(fpsInt)) + tr(" FPS");
+        auto creationSession = dynamic_cast<RoadCreationSession*>(drawingSession);
+        if (creationSession != nullptr && creationSession->FitPreviewLatency().Count() != 0)
+        {
+            displayStr += tr("  Fit p95: %1ms").arg(creationSession->FitPreviewLatency().PercentileMs(0.95));
+        }
         emit FPSChanged(displayStr);
 
         lastUpdateFPSMS = t;
         nRepaints = 0;
     }
+
+    if (drawingSession == nullptr)
+    {
+        // Only while navigating, so that no session holds an evicted road
+        LM::ChangeTracker::Instance()->StreamTiles(odr::Vec2D{ LM::g_CameraPosition[0], LM::g_CameraPosition[1] });
+    }
 }
 
 void MainWidget::Reset()
@@ -48,6 +48,7 @@ public slots:
     void toggleAntialiasing(bool);
     void OnMouseAction(LM::MouseAction);
     void OnKeyPress(LM::KeyPressAction);
+    void ApplyAsyncResults(); // Background work of drawing session finished
 
 private slots:
     void gotoCreateRoadMode(bool);
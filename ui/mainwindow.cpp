@@ -12,6 +12,7 @@
 
 #include "main_widget.h"
 #include "change_tracker.h"
+#include "map_snapshot.h"
 #include "action_manager.h"
 #include "vehicle_manager.h"
 #include "test/validation.h"
@@ -182,7 +183,10 @@ void MainWindow::saveToFile()
     if (s.size() != 0)
     {
         auto loc = s.toStdString();
-        LM::ChangeTracker::Instance()->Save(loc);
+        if (!LM::ChangeTracker::Instance()->Save(loc))
+        {
+            return;
+        }
         if (loadedFileName.empty())
         {
             loadedFileName = loc;
@@ -380,7 +384,11 @@ void MainWindow::testReplay()
         auto saveFolder = LM::DefaultSaveFolder();
         auto originalPath = saveFolder / (std::string("compare_a_") + LM::RunTimestamp() + std::string(".xodr"));
         auto originalPathStr = originalPath.string();
-        LM::ChangeTracker::Instance()->Save(originalPathStr);
+        if (!LM::ChangeTracker::Instance()->Save(originalPathStr, false))
+        {
+            spdlog::error("Action replay test: Skipped, map could not be saved");
+            return;
+        }
 
         reset();
 
@@ -393,9 +401,8 @@ void MainWindow::testReplay()
         {
             auto replayPath = saveFolder / (std::string("compare_b_") + LM::RunTimestamp() + std::string(".xodr"));
             auto replayPathStr = replayPath.string();
-            LM::ChangeTracker::Instance()->Save(replayPathStr);
-
-            if (!LTest::Validation::CompareFiles(originalPathStr, replayPathStr))
+            if (!LM::ChangeTracker::Instance()->Save(replayPathStr, false) ||
+                !LTest::Validation::CompareFiles(originalPathStr, replayPathStr))
             {
                 LM::ActionManager::Instance()->MarkException();
                 spdlog::error("Replay result is different from original map! Check {} for details.", recordPath);
@@ -403,8 +410,11 @@ void MainWindow::testReplay()
             else
             {
                 // On success, clean up temporary saves
-                std::remove(originalPathStr.c_str());
-                std::remove(replayPathStr.c_str());
+                for (const auto& path : { originalPathStr, replayPathStr })
+                {
+                    std::remove(path.c_str());
+                    std::remove(LM::MapSnapshot::PathFor(path).c_str());
+                }
                 spdlog::info("Action replay test: OK");
             }
         }
@@ -412,6 +422,7 @@ void MainWindow::testReplay()
         {
             // cancelled by user
             std::remove(originalPathStr.c_str());
+            std::remove(LM::MapSnapshot::PathFor(originalPathStr).c_str());
             spdlog::info("Action replay test: Cancelled");
         }
     }
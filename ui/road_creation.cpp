@@ -5,11 +5,26 @@
 #include "junction.h"
 #include "constants.h"
 #include "road_overlaps.h"
+#include "main_widget.h"
 
 #include <math.h>
 
 extern SectionProfileConfigWidget* g_createRoadOption;
 
+namespace
+{
+	// On fitting thread: let GUI thread pick up the result
+	void NotifyFitFinished()
+	{
+		QMetaObject::invokeMethod(MainWidget::Instance(), &MainWidget::ApplyAsyncResults, Qt::QueuedConnection);
+	}
+}
+
+RoadCreationSession::RoadCreationSession() :
+	flexFitter(NotifyFitFinished), refitFitter(NotifyFitFinished)
+{
+}
+
 RoadCreationSession::DirectionHandle::DirectionHandle(odr::Vec3D _center, double _angle) :
 	center(_center), angle(_angle)
 {
@@ -261,18 +276,15 @@ bool RoadCreationSession::Update(const LM::MouseAction& act)
 		// Adjust end direction by rotary
 		if (prevHandleDir != currHandleDir)
 		{
-			auto& toRefit = stagedGeometries.back();
+			const auto& toRefit = stagedGeometries.back();
 			auto refitStartPos = toRefit.geo->get_xy(0);
 			auto startHdg = odr::normalize(toRefit.geo->get_grad(0));
 			auto endPos = toRefit.geo->get_end_pos();
 			auto targetHdg = currHandleDir;
 			auto endHdg = odr::Vec2D{ std::cos(targetHdg), std::sin(targetHdg) };
-			auto adjustedFit = LM::ConnectRays(refitStartPos, startHdg, endPos, endHdg);
-
-			toRefit.geo = std::move(adjustedFit);
-
-			UpdateStagedFromGeometries();
+			refitFitter.Submit([=]() { return LM::ConnectRays(refitStartPos, startHdg, endPos, endHdg); });
 		}
+		flexFitter.Cancel();
 		flexBoundaryPreview.reset();
 		flexRefLinePreview.reset();
 	}
@@ -281,6 +293,7 @@ bool RoadCreationSession::Update(const LM::MouseAction& act)
 		if (act.type == QEvent::Type::MouseButtonPress &&
 			act.button == Qt::MouseButton::LeftButton)
 		{
+			FlushFits();
 			if (!startPos.has_value())
 			{
 				startElevation = CursorElevation();
@@ -314,6 +327,7 @@ bool RoadCreationSession::Update(const LM::KeyPressAction& act)
 {
 	if (act.key == Qt::Key_Escape)
 	{
+		FlushFits();
 		if (!stagedGeometries.empty())
 		{
 			// Unstage one
@@ -381,6 +395,7 @@ LM::type_t RoadCreationSession::PreviewLeftOffsetX2() const
 
 bool RoadCreationSession::Complete()
 {
+	FlushFits();
 	if (g_createRoadOption->LeftResult().laneCount + g_createRoadOption->RightResult().laneCount == 0)
 	{
 		spdlog::warn("Cannot create empty road!");
@@ -567,64 +582,124 @@ void RoadCreationSession::UpdateFlexGeometry()
 	odr::Vec2D snappedPos;
 	SnapCursor(snappedPos);
 
-	flexRefLinePreview.reset();
-	flexBoundaryPreview.reset();
-
 	if (startPos.has_value() || !stagedGeometries.empty())
 	{
-		odr::Line3D flexRefLinePath, flexBoundaryPathR, flexBoundaryPathL;
-
 		odr::Vec2D localStartPos, localStartDir;
-		double localStartZ;
 		if (stagedGeometries.empty())
 		{
 			localStartPos = startPos.value();
 			localStartDir = extendFromStart.expired() ? odr::sub(snappedPos, localStartPos) : ExtendFromDir();
-			localStartZ = startElevation;
+			flexStartElevation = startElevation;
 		}
 		else
 		{
 			const auto& geo = stagedGeometries.back().geo;
 			localStartPos = geo->get_xy(geo->length);
 			localStartDir = geo->get_grad(geo->length);
-			localStartZ = stagedGeometries.back().endEleveation;
+			flexStartElevation = stagedGeometries.back().endEleveation;
 		}
 		localStartDir = odr::normalize(localStartDir);
+		flexEndElevation = CursorElevation();
 
 		if (joinAtEnd.expired())
 		{
+			// Cheap enough to do in place
+			flexFitter.Cancel();
 			flexGeo = LM::FitArcOrLine(localStartPos, localStartDir, snappedPos);
+			ShowFlexGeometry();
 		}
 		else
 		{
-			flexGeo = LM::ConnectRays(localStartPos, localStartDir, snappedPos, JoinAtEndDir());
+			// Keep previous flexGeo as preview until the fit arrives
+			auto endDir = JoinAtEndDir();
+			flexFitter.Submit([=]() { return LM::ConnectRays(localStartPos, localStartDir, snappedPos, endDir); });
 		}
-		flexEndElevation = CursorElevation();
+	}
+	else
+	{
+		flexFitter.Cancel();
+		flexGeo.reset();
+		flexRefLinePreview.reset();
+		flexBoundaryPreview.reset();
+	}
+}
 
-		if (flexGeo->length > 0)
-		{
-			auto elevationProfile = LM::CubicSplineGenerator::FromControlPoints(
-				std::map<double, double>{{0, localStartZ}, { flexGeo->length, flexEndElevation }}
-			);
-			double avgGrade = (flexEndElevation - localStartZ) / flexGeo->length;
-			double gradFrac = std::min(1.0, std::abs(avgGrade) / 0.15); // 15% is considered too steep
-			const QColor flatColor = Qt::gray;
-			const QColor steepColor = avgGrade > 0 ? Qt::darkMagenta : Qt::darkCyan;
-			QColor gradColor(flatColor.red() * (1 - gradFrac) + steepColor.red() * gradFrac,
-				flatColor.green() * (1 - gradFrac) + steepColor.green() * gradFrac,
-				flatColor.blue() * (1 - gradFrac) + steepColor.blue() * gradFrac);
-
-			std::vector<std::unique_ptr<odr::RoadGeometry>> allGeo;
-			allGeo.emplace_back(flexGeo->clone());
-			odr::RefLine flexRefLine("", 0);
-			flexRefLine.s0_to_geometry.emplace(0, flexGeo->clone());
-			flexRefLine.length = flexGeo->length;
-			flexRefLine.elevation_profile = elevationProfile;
-			GenerateHintLines(flexRefLine, flexRefLinePath, flexBoundaryPathR, flexBoundaryPathL);
-
-			flexRefLinePreview.emplace(flexRefLinePath, 0.3, Qt::darkGreen);
-			flexBoundaryPreview.emplace(flexBoundaryPathR, flexBoundaryPathL, gradColor);
-		}
+void RoadCreationSession::ShowFlexGeometry()
+{
+	flexRefLinePreview.reset();
+	flexBoundaryPreview.reset();
+
+	if (flexGeo != nullptr && flexGeo->length > 0)
+	{
+		odr::Line3D flexRefLinePath, flexBoundaryPathR, flexBoundaryPathL;
+		const double localStartZ = flexStartElevation;
+		auto elevationProfile = LM::CubicSplineGenerator::FromControlPoints(
+			std::map<double, double>{{0, localStartZ}, { flexGeo->length, flexEndElevation }}
+		);
+		double avgGrade = (flexEndElevation - localStartZ) / flexGeo->length;
+		double gradFrac = std::min(1.0, std::abs(avgGrade) / 0.15); // 15% is considered too steep
+		const QColor flatColor = Qt::gray;
+		const QColor steepColor = avgGrade > 0 ? Qt::darkMagenta : Qt::darkCyan;
+		QColor gradColor(flatColor.red() * (1 - gradFrac) + steepColor.red() * gradFrac,
+			flatColor.green() * (1 - gradFrac) + steepColor.green() * gradFrac,
+			flatColor.blue() * (1 - gradFrac) + steepColor.blue() * gradFrac);
+
+		odr::RefLine flexRefLine("", 0);
+		flexRefLine.s0_to_geometry.emplace(0, flexGeo->clone());
+		flexRefLine.length = flexGeo->length;
+		flexRefLine.elevation_profile = elevationProfile;
+		GenerateHintLines(flexRefLine, flexRefLinePath, flexBoundaryPathR, flexBoundaryPathL);
+
+		flexRefLinePreview.emplace(flexRefLinePath, 0.3, Qt::darkGreen);
+		flexBoundaryPreview.emplace(flexBoundaryPathR, flexBoundaryPathL, gradColor);
+	}
+}
+
+void RoadCreationSession::ApplyFlexFit(FitWorker::Finished& fit)
+{
+	flexGeo = std::move(fit.result);
+	ShowFlexGeometry();
+	fitPreviewLatency.Record(std::chrono::duration<double, std::milli>(
+		std::chrono::steady_clock::now() - fit.submitted).count());
+}
+
+void RoadCreationSession::ApplyRefit(FitWorker::Finished& fit)
+{
+	if (stagedGeometries.empty() || fit.result == nullptr)
+	{
+		return;
+	}
+	stagedGeometries.back().geo = std::move(fit.result);
+	UpdateStagedFromGeometries();
+	fitPreviewLatency.Record(std::chrono::duration<double, std::milli>(
+		std::chrono::steady_clock::now() - fit.submitted).count());
+}
+
+bool RoadCreationSession::ApplyAsyncResults()
+{
+	bool changed = false;
+	if (auto flexFit = flexFitter.TakeLatest())
+	{
+		ApplyFlexFit(*flexFit);
+		changed = true;
+	}
+	if (auto refit = refitFitter.TakeLatest())
+	{
+		ApplyRefit(*refit);
+		changed = true;
+	}
+	return changed;
+}
+
+void RoadCreationSession::FlushFits()
+{
+	if (auto flexFit = flexFitter.WaitLatest())
+	{
+		ApplyFlexFit(*flexFit);
+	}
+	if (auto refit = refitFitter.WaitLatest())
+	{
+		ApplyRefit(*refit);
 	}
 }
 
@@ -125,6 +125,14 @@ bool RoadDestroySession::Complete()
 
     // Check if removal negatively affects any related junction
     target.reset();
+    if (predJunction != nullptr)
+    {
+        predJunction->RegenerateIfPending();
+    }
+    if (succJunction != nullptr)
+    {
+        succJunction->RegenerateIfPending();
+    }
     if (predJunction != nullptr &&
         predJunction->generationError != LM::Junction_NoError
         ||
@@ -241,6 +241,9 @@ void RoadDrawingSession::CustomCursorItem::DrawGroundGrids()
 
 void RoadDrawingSession::UpdateEndMarkings()
 {
+    // Junctions changed by this edit must be regenerated to be seen below
+    LM::AbstractJunction::RegeneratePending();
+
     std::set<std::pair< LM::Road*, odr::RoadLink::ContactPoint>> dueUpdate;
     for (auto id_obj : IDGenerator::ForType(IDType::Junction)->PeekChanges())
     {
@@ -5,6 +5,8 @@
 #include "road_graphics.h"
 
 #include "Transform3D.h"
+#include "latest_worker.h"
+#include "stats.h"
 #include <vector>
 #include <map>
 #include <spdlog/spdlog.h>
@@ -21,6 +23,9 @@ public:
     /*return false to abort change*/
     virtual bool Complete() = 0;
 
+    /*Pick up results of background work. return true if preview changed*/
+    virtual bool ApplyAsyncResults() { return false; }
+
     virtual ~RoadDrawingSession();
 
     void SetHighlightTo(std::shared_ptr<LM::Road>);
@@ -81,11 +86,17 @@ private:
 class RoadCreationSession : public RoadDrawingSession
 {
 public:
+    RoadCreationSession();
+
     virtual bool Update(const LM::MouseAction&) override;
     virtual bool Update(const LM::KeyPressAction&) override;
 
     virtual bool Complete() override;
 
+    virtual bool ApplyAsyncResults() override;
+
+    const LatencyHistogram& FitPreviewLatency() const { return fitPreviewLatency; }
+
 protected:
     // Record extend / join
     virtual SnapResult SnapFirstPointToExisting(odr::Vec2D&);
@@ -105,6 +116,9 @@ protected:
     virtual LM::type_t PreviewRightOffsetX2() const;
     virtual LM::type_t PreviewLeftOffsetX2() const;
 
+    // Wait for the newest fits and apply them, before using flexGeo / stagedGeometries
+    void FlushFits();
+
 private:
     class DirectionHandle
     {
@@ -151,8 +165,19 @@ private:
     void UpdateStagedFromGeometries();
 
     std::unique_ptr<odr::RoadGeometry> flexGeo;
+    double flexStartElevation;
     double flexEndElevation;
 
+    void ShowFlexGeometry();
+
+    // Fitting runs off the GUI thread. Newer input supersedes fits not yet done.
+    typedef LatestOnlyWorker<std::unique_ptr<odr::RoadGeometry>> FitWorker;
+    void ApplyFlexFit(FitWorker::Finished&);
+    void ApplyRefit(FitWorker::Finished&);
+
+    LatencyHistogram fitPreviewLatency{ "Fit preview latency" };
+    FitWorker flexFitter, refitFitter;
+
     std::unique_ptr<DirectionHandle> directionHandle;
 
     std::optional<LM::HintLineGraphics> stagedRefLinePreview;
@@ -8,10 +8,23 @@
 #include "junction.h"
 #include "map_view_gl.h"
 #include "constants.h"
+#include "triangulation.h"
 
 
 namespace LM
 {
+    void GraphicsTessellation::AddQuads(const odr::Line3D& lBorder, const odr::Line3D& rBorder, QColor color)
+    {
+        if (lBorder.size() > 1)
+            primitives.push_back(Primitive{ lBorder, rBorder, {}, color });
+    }
+
+    void GraphicsTessellation::AddPoly(const odr::Line3D& boundary, QColor color)
+    {
+        if (boundary.size() >= 3)
+            primitives.push_back(Primitive{ boundary, {}, Triangulate_2_5d(boundary), color });
+    }
+
     AbstractGraphicsItem::~AbstractGraphicsItem()
     {
         Clear();
@@ -45,6 +58,21 @@ namespace LM
         }
     }
 
+    void AbstractGraphicsItem::Add(const GraphicsTessellation& tessellation)
+    {
+        for (const auto& primitive : tessellation.primitives)
+        {
+            if (primitive.rBorder.empty())
+            {
+                graphicsIndex.push_back(g_mapViewGL->AddPoly(primitive.lBorder, primitive.triangles, primitive.color, objectID));
+            }
+            else
+            {
+                graphicsIndex.push_back(g_mapViewGL->AddQuads(primitive.lBorder, primitive.rBorder, primitive.color, objectID));
+            }
+        }
+    }
+
     void AbstractGraphicsItem::Clear()
     {
         for (auto idx : graphicsIndex)
@@ -98,16 +126,27 @@ namespace LM
         AddPoly(boundary, color, height);
     }
 
-    SectionGraphics::SectionGraphics(std::shared_ptr<LM::Road> road,
+    SectionGraphics::SectionGraphics(const std::string& roadID, const SectionTessellation& tessellation):
+        PermanentGraphics(std::stoi(roadID)), sMin(tessellation.sMin), sMax(tessellation.sMax)
+    {
+        for (const auto& quad : tessellation.spatialQuads)
+        {
+            allSpatialIndice.push_back(SpatialIndexer::Instance()->Index(quad));
+        }
+        Add(tessellation);
+    }
+
+    SectionTessellation SectionGraphics::Tessellate(const LM::Road& road,
         const odr::LaneSection& laneSection,
-        double sBegin, double sEnd): PermanentGraphics(std::stoi(road->ID()))
+        double sBegin, double sEnd)
     {
-        odr::Road& gen = road->generated;
-        auto roadID = std::stoi(road->ID());
+        const odr::Road& gen = road.generated;
+        SectionTessellation rtn;
 
-        bool biDirRoad = gen.rr_profile.HasSide(-1) && gen.rr_profile.HasSide(1);
-        sMin = std::min(sBegin, sEnd);
-        sMax = std::max(sBegin, sEnd);
+        const double sMin = std::min(sBegin, sEnd);
+        const double sMax = std::max(sBegin, sEnd);
+        rtn.sMin = sMin;
+        rtn.sMax = sMax;
 
         for (const auto& id2Lane : laneSection.id_to_lane)
         {
@@ -122,24 +161,24 @@ namespace LM
                 {
                     double segMin = (sMin * (nSubDivisions - d) + sMax * d) / nSubDivisions;
                     double segMax = (sMin * (nSubDivisions - 1 - d) + sMax * (d + 1)) / nSubDivisions;
-                    allSpatialIndice.push_back(SpatialIndexer::Instance()->Index(gen, lane, segMin, segMax));
+                    rtn.spatialQuads.push_back(SpatialIndexer::Prepare(gen, lane, segMin, segMax));
                 }
                 
                 // outline for highlight
                 auto sMid = (sMin + sMax) / 2;
                 double lane_width = std::abs(lane.outer_border.get(sMid) - lane.inner_border.get(sMid));
-                AddQuads(innerBorder, outerBorder, lane.type == "median" ? 
+                rtn.AddQuads(innerBorder, outerBorder, lane.type == "median" ? 
                     (lane_width > LaneWidth + epsilon ? Qt::darkGreen : Qt::yellow) : Qt::darkGray);
 
                 // Draw magnetic snap area
                 const double MagneticSnapDist = 2;
                 if (sMin == 0 && gen.predecessor.type == odr::RoadLink::Type_None)
                 {
-                    allSpatialIndice.push_back(SpatialIndexer::Instance()->Index(gen, lane, -MagneticSnapDist, 0));
+                    rtn.spatialQuads.push_back(SpatialIndexer::Prepare(gen, lane, -MagneticSnapDist, 0));
                 }
-                if (sMax == road->Length() && gen.successor.type == odr::RoadLink::Type_None)
+                if (sMax == road.Length() && gen.successor.type == odr::RoadLink::Type_None)
                 {
-                    allSpatialIndice.push_back(SpatialIndexer::Instance()->Index(gen, lane, sMax, sMax + MagneticSnapDist));
+                    rtn.spatialQuads.push_back(SpatialIndexer::Prepare(gen, lane, sMax, sMax + MagneticSnapDist));
                 }
             }
         }
@@ -198,7 +237,7 @@ namespace LM
                 {
                     Qt::GlobalColor color = colors[i] == "yellow" ? Qt::yellow :
                         (colors[i] == "white" ? Qt::white : Qt::lightGray);
-                    AddQuads(leftLines[i], rightLines[i], color);
+                    rtn.AddQuads(leftLines[i], rightLines[i], color);
                 }
             }
         }
@@ -229,7 +268,7 @@ namespace LM
                         {
                             p[2] += 0.01;
                         }
-                        AddQuads(l1, l2, Qt::white);
+                        rtn.AddQuads(l1, l2, Qt::white);
                     }
                     else if (id_object.second.subtype == "arrow")
                     {
@@ -253,7 +292,7 @@ namespace LM
                                 auto vertexH = gen.ref_line.elevation_profile.get(vertexS);
                                 shape3[i] = odr::Vec3D{ transformed[i].x(), transformed[i].y(), vertexH + 0.02};
                             }
-                            AddPoly(shape3, Qt::white);
+                            rtn.AddPoly(shape3, Qt::white);
                         }
                     }
                     else
@@ -264,6 +303,8 @@ namespace LM
                 }
             }
         }
+
+        return rtn;
     }
 
     SectionGraphics::~SectionGraphics()
@@ -313,16 +354,7 @@ namespace LM
     {
         for (auto index : allSpatialIndice)
         {
-            uint32_t face1ID = index >> 32;
-            uint32_t face2ID = index & 0xffffffff;
-            for (auto faceID : { face1ID , face2ID })
-            {
-                if (faceID == SpatialIndexer::InvalidFace) continue;
-                Quad& face = SpatialIndexer::Instance()->faceInfo.at(faceID);
-                face.roadID = newRoadID;
-                face.sBegin = face.sBegin * mult + shift;
-                face.sEnd = face.sEnd * mult + shift;
-            }
+            SpatialIndexer::Instance()->UpdateFaces(index, newRoadID, mult, shift);
         }
 
         sMin = sMin * mult + shift;
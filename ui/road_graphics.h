@@ -1,6 +1,7 @@
 #pragma once
 #include <qgraphicsitem.h>
 #include <qbrush.h>
+#include <QMatrix4x4>
 #include <map>
 
 #include "road.h"
@@ -13,6 +14,23 @@ namespace LM
         std::vector<QPolygonF> ArrowShape(int arrowType);
     }
 
+    /*Geometry of a graphics item before it goes to GPU.
+    * Built without touching shared state, so it can be done off the GUI thread.
+    */
+    struct GraphicsTessellation
+    {
+        void AddQuads(const odr::Line3D& lBorder, const odr::Line3D& rBorder, QColor color);
+        void AddPoly(const odr::Line3D& boundary, QColor color);
+
+        struct Primitive
+        {
+            odr::Line3D lBorder, rBorder; // Poly: boundary in lBorder, rBorder empty
+            std::vector<std::tuple<int, int, int>> triangles;
+            QColor color;
+        };
+        std::vector<Primitive> primitives;
+    };
+
     // TODO: g_mapViewGL->AddXXX is Only accessable through AbstractGraphicsItem
     class AbstractGraphicsItem
     {
@@ -20,6 +38,7 @@ namespace LM
         virtual void AddQuads(const odr::Line3D& lBorder, const odr::Line3D& rBorder, QColor color);
         virtual void AddLine(const odr::Line3D& border, double width, QColor color);
         virtual void AddPoly(const odr::Line3D& boundary, QColor color, double h = 0);
+        void Add(const GraphicsTessellation& tessellation);
 
         void Clear();
 
@@ -62,10 +81,19 @@ namespace LM
         HintPolyGraphics(const odr::Line3D& boundary, QColor color, double height = 0);
     };
 
+    struct SectionTessellation: public GraphicsTessellation
+    {
+        double sMin, sMax;
+        std::vector<PreparedQuad> spatialQuads;
+    };
+
     class SectionGraphics: protected PermanentGraphics
     {
     public:
-        SectionGraphics(std::shared_ptr<LM::Road> road, const odr::LaneSection& laneSection,
+        SectionGraphics(const std::string& roadID, const SectionTessellation& tessellation);
+
+        // Thread-safe: only reads road
+        static SectionTessellation Tessellate(const LM::Road& road, const odr::LaneSection& laneSection,
             double s_begin, double s_end);
 
         ~SectionGraphics();
@@ -82,8 +110,8 @@ namespace LM
     private:
         static QPainterPath CreateRefLinePath(const odr::Line3D& center);
 
-        const double BrokenLength = 3;
-        const double BrokenGap = 6;
+        static constexpr double BrokenLength = 3;
+        static constexpr double BrokenGap = 6;
     };
 
     class JunctionGraphics: protected PermanentGraphics
@@ -0,0 +1,158 @@
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <optional>
+#include <thread>
+
+#include <spdlog/spdlog.h>
+
+/*Runs jobs on one background thread when only the newest job matters.
+* Submit replaces a job that has not started yet; a job already running finishes,
+* and its result is kept only if no newer result has arrived.
+* onFinish runs on the worker thread after each job.
+*/
+template<typename Result>
+class LatestOnlyWorker
+{
+public:
+    typedef std::function<Result()> Job;
+
+    struct Finished
+    {
+        Result result;
+        uint64_t generation;
+        std::chrono::steady_clock::time_point submitted;
+    };
+
+    LatestOnlyWorker(std::function<void()> aOnFinish = nullptr) :
+        onFinish(aOnFinish), thread(&LatestOnlyWorker::Run, this) {}
+
+    ~LatestOnlyWorker()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            quit = true;
+        }
+        cv.notify_all();
+        thread.join();
+    }
+
+    LatestOnlyWorker(const LatestOnlyWorker&) = delete;
+    LatestOnlyWorker& operator=(const LatestOnlyWorker&) = delete;
+
+    // Returns generation of job
+    uint64_t Submit(Job job)
+    {
+        uint64_t generation;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            generation = ++submitted;
+            pending = std::move(job);
+            pendingSubmitted = std::chrono::steady_clock::now();
+        }
+        cv.notify_all();
+        return generation;
+    }
+
+    // Newest finished result not taken yet. Can be older than the newest Submit.
+    std::optional<Finished> TakeLatest()
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        return Take();
+    }
+
+    // Blocks until the newest Submit finishes. nullopt if its result was already taken or cancelled.
+    std::optional<Finished> WaitLatest()
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        cv.wait(lock, [this]() { return done >= submitted || cancelled >= submitted; });
+        if (finished.has_value() && finished->generation != submitted)
+        {
+            finished.reset();
+        }
+        return Take();
+    }
+
+    // Drop job waiting to start and results not taken, including the one now running
+    void Cancel()
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        pending = nullptr;
+        finished.reset();
+        cancelled = submitted;
+        cv.notify_all();
+    }
+
+private:
+    std::optional<Finished> Take()
+    {
+        auto rtn = std::move(finished);
+        finished.reset();
+        return rtn;
+    }
+
+    void Run()
+    {
+        while (true)
+        {
+            Job job;
+            uint64_t generation;
+            std::chrono::steady_clock::time_point jobSubmitted;
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                cv.wait(lock, [this]() { return quit || pending != nullptr; });
+                if (quit)
+                {
+                    return;
+                }
+                job = std::move(pending);
+                pending = nullptr;
+                generation = submitted;
+                jobSubmitted = pendingSubmitted;
+            }
+
+            std::optional<Result> result;
+            try
+            {
+                result.emplace(job());
+            }
+            catch (std::exception& e)
+            {
+                spdlog::warn("Background job failed: {}", e.what());
+            }
+
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                bool newest = !finished.has_value() || finished->generation < generation;
+                if (result.has_value() && generation > cancelled && newest)
+                {
+                    finished.emplace(Finished{ std::move(*result), generation, jobSubmitted });
+                }
+                done = generation;
+            }
+            cv.notify_all();
+            if (onFinish)
+            {
+                onFinish();
+            }
+        }
+    }
+
+    std::mutex mutex;
+    std::condition_variable cv;
+
+    Job pending;
+    std::chrono::steady_clock::time_point pendingSubmitted;
+    uint64_t submitted = 0; // Generation of newest Submit
+    uint64_t done = 0;      // Generation of last job that ran
+    uint64_t cancelled = 0; // Results up to this generation are dropped
+    std::optional<Finished> finished;
+    bool quit = false;
+
+    std::function<void()> onFinish;
+    std::thread thread; // Last, so that it starts after other members
+};
@@ -1,5 +1,6 @@
 #include "stats.h"
 #include <spdlog/spdlog.h>
+#include <algorithm>
 
 Stats::Stats(std::string aName): name(aName)
 {
@@ -35,3 +36,58 @@ Stats* Stats::Instance(std::string name)
     return it->second;
 }
 
+
+LatencyHistogram::LatencyHistogram(std::string aName): name(aName) {}
+
+LatencyHistogram::~LatencyHistogram()
+{
+    if (count != 0)
+    {
+        spdlog::trace("{}", ToString());
+    }
+}
+
+void LatencyHistogram::Record(double ms)
+{
+    int bucket = 0;
+    for (double bound = 0.25; bucket != NBuckets - 1 && ms > bound; bound *= 2)
+    {
+        bucket++;
+    }
+    buckets[bucket]++;
+    count++;
+    maxMs = std::max(maxMs, ms);
+
+    if (count % ReportInterval == 0)
+    {
+        spdlog::debug("{}", ToString());
+    }
+}
+
+double LatencyHistogram::PercentileMs(double fraction) const
+{
+    const double target = fraction * count;
+    int seen = 0;
+    double bound = 0.25;
+    for (int i = 0; i != NBuckets - 1; ++i, bound *= 2)
+    {
+        seen += buckets[i];
+        if (seen >= target)
+        {
+            return std::min(bound, maxMs);
+        }
+    }
+    return maxMs;
+}
+
+std::string LatencyHistogram::ToString() const
+{
+    auto rtn = fmt::format("{} ({} samples, max {:.2f}ms):", name, count, maxMs);
+    double bound = 0.25;
+    for (int i = 0; i != NBuckets - 1; ++i, bound *= 2)
+    {
+        rtn += fmt::format(" <={}ms:{}", bound, buckets[i]);
+    }
+    rtn += fmt::format(" >{}ms:{}", bound / 2, buckets.back());
+    return rtn;
+}
@@ -2,6 +2,7 @@
 
 #include <string>
 #include <map>
+#include <array>
 
 class Stats
 {
@@ -21,4 +22,32 @@ private:
 
     int count = 0;
     std::string name;
-};
\ No newline at end of file
+};
+
+// Counts samples in power-of-two millisecond buckets; logs a summary every ReportInterval samples
+class LatencyHistogram
+{
+public:
+    LatencyHistogram(std::string name);
+
+    ~LatencyHistogram();
+
+    void Record(double ms);
+
+    std::string ToString() const;
+
+    int Count() const { return count; }
+
+    // Upper bound of the bucket reaching the given fraction of samples, capped by the max sample
+    double PercentileMs(double fraction) const;
+
+private:
+    // Upper bounds 0.25, 0.5, ..., 64ms; last bucket is overflow
+    static const int NBuckets = 10;
+    static const int ReportInterval = 1000;
+
+    std::array<int, NBuckets> buckets{};
+    int count = 0;
+    double maxMs = 0;
+    std::string name;
+};
@@ -10,6 +10,94 @@ typedef CGAL::Constrained_Delaunay_triangulation_2<K> CDT;
 typedef CGAL::Polygon_2<K> Polygon_2;
 
 #include <spdlog/spdlog.h>
+
+#include <algorithm>
+
+namespace
+{
+    // Twice the signed area of abc in xy, positive if counter-clockwise
+    inline double cross(const odr::Vec3D& a, const odr::Vec3D& b, const odr::Vec3D& c)
+    {
+        return (b[0] - a[0]) * (c[1] - a[1]) - (b[1] - a[1]) * (c[0] - a[0]);
+    }
+
+    // Closed segments ab and cd share any point
+    bool segmentsTouch(const odr::Vec3D& a, const odr::Vec3D& b, const odr::Vec3D& c, const odr::Vec3D& d)
+    {
+        double c1 = cross(a, b, c), c2 = cross(a, b, d);
+        double c3 = cross(c, d, a), c4 = cross(c, d, b);
+        if (c1 * c2 < 0 && c3 * c4 < 0)
+        {
+            return true;
+        }
+        auto onSegment = [](const odr::Vec3D& p, const odr::Vec3D& q, const odr::Vec3D& r)
+        {
+            return std::min(p[0], q[0]) <= r[0] && r[0] <= std::max(p[0], q[0]) &&
+                std::min(p[1], q[1]) <= r[1] && r[1] <= std::max(p[1], q[1]);
+        };
+        return (c1 == 0 && onSegment(a, b, c)) || (c2 == 0 && onSegment(a, b, d)) ||
+            (c3 == 0 && onSegment(c, d, a)) || (c4 == 0 && onSegment(c, d, b));
+    }
+
+    // No two edges meet except neighbors at their shared vertex. Edges swept along x.
+    bool isSimple(const odr::Line3D& boundary)
+    {
+        const int n = boundary.size();
+        std::vector<int> edges(n);
+        for (int i = 0; i != n; ++i)
+        {
+            edges[i] = i;
+        }
+        auto minX = [&](int e) { return std::min(boundary[e][0], boundary[(e + 1) % n][0]); };
+        auto maxX = [&](int e) { return std::max(boundary[e][0], boundary[(e + 1) % n][0]); };
+        std::sort(edges.begin(), edges.end(), [&](int a, int b) { return minX(a) < minX(b); });
+
+        std::vector<int> active;
+        for (int e : edges)
+        {
+            const auto& a = boundary[e];
+            const auto& b = boundary[(e + 1) % n];
+            if (a[0] == b[0] && a[1] == b[1])
+            {
+                return false;
+            }
+            for (size_t i = 0; i < active.size();)
+            {
+                int other = active[i];
+                if (maxX(other) < minX(e))
+                {
+                    active[i] = active.back();
+                    active.pop_back();
+                    continue;
+                }
+                ++i;
+
+                const auto& c = boundary[other];
+                const auto& d = boundary[(other + 1) % n];
+                if ((e + 1) % n == other || (other + 1) % n == e)
+                {
+                    // Neighbors only share one vertex, unless folding back onto each other
+                    const auto& shared = (e + 1) % n == other ? b : a;
+                    const auto& farE = (e + 1) % n == other ? a : b;
+                    const auto& farOther = (e + 1) % n == other ? d : c;
+                    if (cross(farE, shared, farOther) == 0 &&
+                        (farE[0] - shared[0]) * (farOther[0] - shared[0]) + (farE[1] - shared[1]) * (farOther[1] - shared[1]) > 0)
+                    {
+                        return false;
+                    }
+                    continue;
+                }
+                if (segmentsTouch(a, b, c, d))
+                {
+                    return false;
+                }
+            }
+            active.push_back(e);
+        }
+        return true;
+    }
+}
+
 namespace LM
 {
     bool RayLiesInside(const Polygon_2& poly, const bool ccw, int from, int to)
@@ -32,7 +120,134 @@ namespace LM
         return ccw == (aToB < aToC);
     }
 
+    bool TriangulateEarClipping(const odr::Line3D& boundary, std::vector<std::tuple<int, int, int>>& out)
+    {
+        out.clear();
+        const int n = boundary.size();
+        if (n < 3 || (n == 3 && cross(boundary[0], boundary[1], boundary[2]) == 0))
+        {
+            return false;
+        }
+
+        double area = 0;
+        for (int i = 0; i != n; ++i)
+        {
+            const auto& a = boundary[i];
+            const auto& b = boundary[(i + 1) % n];
+            area += a[0] * b[1] - a[1] * b[0];
+        }
+        if (area == 0 || !isSimple(boundary))
+        {
+            return false;
+        }
+
+        // Walk counter-clockwise through a linked ring of boundary indice
+        std::vector<int> prev(n), next(n);
+        for (int i = 0; i != n; ++i)
+        {
+            int fwd = (i + 1) % n;
+            int bwd = (i + n - 1) % n;
+            prev[i] = area > 0 ? bwd : fwd;
+            next[i] = area > 0 ? fwd : bwd;
+        }
+        auto corner = [&](int v) { return cross(boundary[prev[v]], boundary[v], boundary[next[v]]); };
+
+        // Only non-convex vertice can block an ear
+        std::vector<char> reflex(n);
+        for (int i = 0; i != n; ++i)
+        {
+            reflex[i] = corner(i) <= 0;
+        }
+
+        auto isEar = [&](int v)
+        {
+            if (reflex[v])
+            {
+                return false;
+            }
+            const auto& a = boundary[prev[v]];
+            const auto& b = boundary[v];
+            const auto& c = boundary[next[v]];
+            for (int r = next[next[v]]; r != prev[v]; r = next[r])
+            {
+                if (reflex[r] && cross(a, b, boundary[r]) >= 0 &&
+                    cross(b, c, boundary[r]) >= 0 && cross(c, a, boundary[r]) >= 0)
+                {
+                    return false;
+                }
+            }
+            return true;
+        };
+
+        auto unlink = [&](int v)
+        {
+            next[prev[v]] = next[v];
+            prev[next[v]] = prev[v];
+            reflex[prev[v]] = corner(prev[v]) <= 0;
+            reflex[next[v]] = corner(next[v]) <= 0;
+        };
+
+        out.reserve(n - 2);
+        int remaining = n;
+        int v = 0;
+        int sinceLastClip = 0;
+        while (remaining > 3)
+        {
+            if (isEar(v))
+            {
+                out.push_back(std::make_tuple(prev[v], v, next[v]));
+                int after = next[v];
+                unlink(v);
+                remaining--;
+                v = after;
+                sinceLastClip = 0;
+                continue;
+            }
+
+            v = next[v];
+            if (++sinceLastClip <= remaining)
+            {
+                continue;
+            }
+
+            // No ear left: drop a straight vertex, which adds no area
+            int straight = -1;
+            for (int i = 0, u = v; i != remaining; ++i, u = next[u])
+            {
+                if (corner(u) == 0)
+                {
+                    straight = u;
+                    break;
+                }
+            }
+            if (straight == -1)
+            {
+                out.clear();
+                return false;
+            }
+            v = next[straight];
+            unlink(straight);
+            remaining--;
+            sinceLastClip = 0;
+        }
+        if (corner(v) > 0)
+        {
+            out.push_back(std::make_tuple(prev[v], v, next[v]));
+        }
+        return true;
+    }
+
     std::vector<std::tuple<int, int, int>> Triangulate_2_5d(const odr::Line3D& boundary)
+    {
+        std::vector<std::tuple<int, int, int>> rtn;
+        if (TriangulateEarClipping(boundary, rtn))
+        {
+            return rtn;
+        }
+        return TriangulateCDT(boundary);
+    }
+
+    std::vector<std::tuple<int, int, int>> TriangulateCDT(const odr::Line3D& boundary)
     {
         std::vector<std::tuple<int, int, int>> rtn;
 
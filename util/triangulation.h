@@ -4,5 +4,11 @@
 
 namespace LM
 {
+    // Ear clipping when boundary is a simple polygon, Constrained Delaunay otherwise
     std::vector<std::tuple<int, int, int>> Triangulate_2_5d(const odr::Line3D& boundary);
-}
\ No newline at end of file
+
+    // Counter-clockwise triangles in xy. False if boundary is degenerate or self-intersecting.
+    bool TriangulateEarClipping(const odr::Line3D& boundary, std::vector<std::tuple<int, int, int>>& out);
+
+    std::vector<std::tuple<int, int, int>> TriangulateCDT(const odr::Line3D& boundary);
+}
@@ -8,7 +8,14 @@
 #include "preference.h"
 #include "util.h"
 #include "spatial_indexer.h"
-
+#include "map_snapshot.h"
+#include "constants.h"
+#include "road_graphics.h"
+#include "map_view_gl.h"
+#include "Utils.hpp"
+
+#include <fstream>
+#include <sstream>
 #include <spdlog/spdlog.h>
 
 extern UserPreference g_preference;
@@ -28,14 +35,57 @@ namespace LM
 
     void ChangeTracker::PostLoadActions()
     {
+        tiles.Clear();
+        streamedTile.reset();
+        pinnedRoads.clear();
+        pinnedJunctions.clear();
+        fringeRoads.clear();
+        if (odrMap.id_to_road.size() >= TiledLoadingMinRoads)
+        {
+            LoadTiled();
+        }
+        else
+        {
+            LoadAll();
+        }
+
+        while (!redoStack.empty())
+        {
+            redoStack.pop();
+        }
+        while (!undoStack.empty())
+        {
+            undoStack.pop();
+        }
+
+        PostChangeActions();
+    }
+
+    void ChangeTracker::LoadAll()
+    {
+        std::vector<std::shared_ptr<LM::Road>> loadedRoads;
+        loadedRoads.reserve(odrMap.id_to_road.size());
+        for (const auto& id2Road : odrMap.id_to_road)
+        {
+            loadedRoads.push_back(std::make_shared<LM::Road>(id2Road.second));
+        }
+
+        // Tessellate on all cores, then send to GPU and spatial index in one batch
+        std::vector<std::map<double, SectionTessellation>> tessellations(loadedRoads.size());
+        odr::parallel_for(loadedRoads.size(), odr::get_worker_count(loadedRoads.size(), 0),
+            [&](const std::size_t i, const std::size_t) { tessellations[i] = loadedRoads[i]->TessellateAllSections(); });
+
+        g_mapViewGL->BeginBatch();
+
         // Temporarily hold shared_ptr to Connecting road until they get owned by junction
         std::vector<std::shared_ptr<LM::Road>> connectingRoadHolder;
         std::cout << "Generating road graphics ";
-        for (const auto& id2Road : TQDM(odrMap.id_to_road))
+        for (auto i : TQDM(range(loadedRoads.size())))
         {
-            auto rrRoad = std::make_shared<LM::Road>(id2Road.second);
-            rrRoad->GenerateAllSectionGraphics();
-            if (id2Road.second.junction == "-1")
+            auto& rrRoad = loadedRoads[i];
+            rrRoad->GenerateAllSectionGraphics(tessellations[i]);
+            tessellations[i].clear();
+            if (rrRoad->generated.junction == "-1")
             {
                 World::Instance()->allRoads.insert(rrRoad);
             }
@@ -82,23 +132,13 @@ namespace LM
         {
             idAndjunc.second->GenerateGraphics();
         }
-
-        while (!redoStack.empty())
-        {
-            redoStack.pop();
-        }
-        while (!undoStack.empty())
-        {
-            undoStack.pop();
-        }
-
-        PostChangeActions();
+        g_mapViewGL->EndBatch();
     }
 
     void ChangeTracker::PostChangeActions()
     {
-        SpatialIndexer::Instance()->RebuildTree();
-        if (g_preference.alwaysVerify)
+        // Validation needs every road loaded
+        if (g_preference.alwaysVerify && tiles.Empty())
             LTest::Validation::ValidateMap();
     }
 
@@ -106,10 +146,14 @@ namespace LM
     {
         IDGenerator::ForType(IDType::Road)->ClearChangeList();
         IDGenerator::ForType(IDType::Junction)->ClearChangeList();
+        AbstractJunction::BeginDeferRegeneration();
     }
 
     void ChangeTracker::FinishRecordEdit(bool abort)
     {
+        // Each junction touched by the edit is regenerated once, before changes are collected
+        AbstractJunction::EndDeferRegeneration();
+
         auto roadChanges = IDGenerator::ForType(IDType::Road)->ConsumeChanges();
         auto junctionChanges = IDGenerator::ForType(IDType::Junction)->ConsumeChanges();
         if (roadChanges.empty() && junctionChanges.empty())
@@ -123,6 +167,7 @@ namespace LM
         {
             std::string id = std::to_string(change.first);
             void* ptr = change.second;
+            saveCache.dirty_roads.insert(id);
 
             RoadChange roadChange;
             auto oldIt = odrMap.id_to_road.find(id);
@@ -148,6 +193,7 @@ namespace LM
         {
             std::string id = std::to_string(change.first);
             void* ptr = change.second;
+            saveCache.dirty_junctions.insert(id);
 
             JunctionChange junctionChange;
             auto oldIt = odrMap.id_to_junction.find(id);
@@ -169,6 +215,7 @@ namespace LM
             recordEntry.junctionChanges.push_back(junctionChange);
         }
         
+        TrackTiledChange(recordEntry);
         if (abort)
         {
             RestoreChange(recordEntry);
@@ -187,6 +234,7 @@ namespace LM
 
     void ChangeTracker::Clear()
     {
+        FlushSnapshot();
         Road::ClearingMap = true;
         SpatialIndexer::Instance()->Clear();
         World::Instance()->allRoads.clear();
@@ -194,17 +242,73 @@ namespace LM
         IDGenerator::Reset();
         odrMap.id_to_road.clear();
         odrMap.id_to_junction.clear();
-        SpatialIndexer::Instance()->RebuildTree();
+        saveCache.clear();
+        tiles.Clear();
+        streamedTile.reset();
+        pinnedRoads.clear();
+        pinnedJunctions.clear();
+        fringeRoads.clear();
+    }
+
+    bool ChangeTracker::Save(std::string path, bool snapshot)
+    {
+        if (!snapshot)
+        {
+            FlushSnapshot();
+        }
+        // Export below resets dirty entries, after which a snapshot still pending can't tell if it is valid
+        snapshotPending.clear();
+        if (!odrMap.export_file(path, saveCache))
+        {
+            spdlog::error("Could not save {}", path);
+            return false;
+        }
+        if (snapshot)
+        {
+            // Snapshot re-serializes the whole map, so it is left out of the save itself
+            snapshotPending = path;
+        }
+        return true;
     }
 
-    void ChangeTracker::Save(std::string path)
+    void ChangeTracker::FlushSnapshot()
     {
-        odrMap.export_file(path);
+        if (snapshotPending.empty())
+        {
+            return;
+        }
+        if (saveCache.dirty_roads.empty() && saveCache.dirty_junctions.empty())
+        {
+            MapSnapshot::Save(odrMap, MapSnapshot::PathFor(snapshotPending), saveCache.content_hash(), true);
+        }
+        else
+        {
+            spdlog::info("Map edited since {} was saved, snapshot skipped", snapshotPending);
+        }
+        snapshotPending.clear();
     }
 
     bool ChangeTracker::Load(std::string path)
     {
-        if (!odrMap.Load(path))
+        FlushSnapshot();
+        std::ifstream ifs(path);
+        std::stringstream buffer;
+        buffer << ifs.rdbuf();
+        const auto content = buffer.str();
+        const auto sourceHash = MapSnapshot::SourceHash(content);
+        const auto snapshotPath = MapSnapshot::PathFor(path);
+        saveCache.clear();
+
+        bool supported;
+        if (!MapSnapshot::Load(odrMap, snapshotPath, sourceHash, supported))
+        {
+            supported = odrMap.LoadString(content);
+            if (supported)
+            {
+                MapSnapshot::Save(odrMap, snapshotPath, sourceHash, supported);
+            }
+        }
+        if (!supported)
         {
             return false;
         }
@@ -214,6 +318,8 @@ namespace LM
 
     bool ChangeTracker::LoadStr(std::string content)
     {
+        FlushSnapshot();
+        saveCache.clear();
         if (!odrMap.LoadString(content))
         {
             return false;
@@ -283,6 +389,7 @@ namespace LM
             if (change.after.has_value())
             {
                 odrMap.id_to_road.erase(change.after->id);
+                saveCache.dirty_roads.insert(change.after->id);
 
                 auto& odrRoad = change.after.get();
                 if (odrRoad.junction == "-1")
@@ -320,6 +427,7 @@ namespace LM
             if (change.after.has_value())
             {
                 odrMap.id_to_junction.erase(change.after->id);
+                saveCache.dirty_junctions.insert(change.after->id);
 
                 auto& odrJunction = change.after.get();
                 auto createdID = odrJunction.id;
@@ -364,6 +472,7 @@ namespace LM
             {
                 assert(odrMap.id_to_road.find(change.before->id) == odrMap.id_to_road.end());
                 odrMap.id_to_road.emplace(change.before->id, change.before.get());
+                saveCache.dirty_roads.insert(change.before->id);
 
                 spdlog::trace("Undo::Restore Road {}", change.before->id);
                 auto odrRoad = change.before.get();
@@ -385,6 +494,7 @@ namespace LM
             {
                 assert(odrMap.id_to_junction.find(change.before->id) == odrMap.id_to_junction.end());
                 odrMap.id_to_junction.emplace(change.before->id, change.before.get());
+                saveCache.dirty_junctions.insert(change.before->id);
                 const auto& odrJunction = change.before.get();
                 std::shared_ptr<LM::AbstractJunction> rrJunc;
                 if (odrJunction.type == odr::JunctionType::Common)
@@ -454,6 +564,7 @@ namespace LM
             junc->GenerateGraphics();
         }
 
+        TrackTiledChange(change);
         PostChangeActions();
     }
 
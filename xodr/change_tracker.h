@@ -1,8 +1,10 @@
 #pragma once
 
 #include "OpenDriveMap.h"
+#include "map_tiles.h"
 #include <boost/optional.hpp>
 
+#include <set>
 #include <string>
 #include <stack>
 #include <vector>
@@ -24,22 +26,36 @@ namespace LM
         bool Redo();
 
         void Clear();
-        void Save(std::string path);
+        /*snapshot: write a snapshot next to path on the next FlushSnapshot. Off for temporary saves.
+        * False if the file could not be written; no snapshot is scheduled then*/
+        bool Save(std::string path, bool snapshot = true);
+        /*Writes snapshot of the last saved file, unless map was edited since. Clear() calls it too*/
+        void FlushSnapshot();
         bool Load(std::string path);
         bool LoadStr(std::string path);
 
         const odr::OpenDriveMap& Map();
+
+        /*Large maps only: materialize tiles around camera, evict far ones. No-op during an edit.*/
+        void StreamTiles(const odr::Vec2D& cameraPos);
     private:
         ChangeTracker() = default;
 
         void PostLoadActions();
 
+        void LoadAll();
+
         void PostChangeActions();
 
         static ChangeTracker* instance;
 
         odr::OpenDriveMap odrMap;
 
+        // Serialized roads / junctions from last Save; entries touched since are marked dirty
+        odr::XodrFragmentCache saveCache;
+        // Last saved path whose snapshot is not written yet
+        std::string snapshotPending;
+
         struct RoadChange
         {
             boost::optional<odr::Road> before;
@@ -62,5 +78,17 @@ namespace LM
         std::stack<MapChange> redoStack;
 
         void RestoreChange(const MapChange& change);
+
+        // Tiled loading, defined in change_tracker_tiles.cpp
+        MapTiles tiles;
+        boost::optional<MapTiles::TileKey> streamedTile;
+        // Referenced by undo / redo, never evicted
+        std::set<std::string> pinnedRoads, pinnedJunctions;
+        // Loaded because a junction needs them, but one end stays unloaded: not editable
+        std::set<std::string> fringeRoads;
+
+        void LoadTiled();
+
+        void TrackTiledChange(const MapChange& change);
     };
 }
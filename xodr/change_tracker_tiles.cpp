@@ -0,0 +1,338 @@
+#include "change_tracker.h"
+#include "id_generator.h"
+#include "road.h"
+#include "junction.h"
+#include "world.h"
+#include "constants.h"
+#include "map_view_gl.h"
+
+#include <spdlog/spdlog.h>
+
+namespace LM
+{
+    namespace
+    {
+        std::vector<std::string> ConnectingRoadIDs(const odr::Junction& junction)
+        {
+            std::vector<std::string> rtn;
+            if (junction.type == odr::JunctionType::Common)
+            {
+                for (const auto& id2Connection : junction.id_to_connection)
+                {
+                    rtn.push_back(id2Connection.second.connecting_road);
+                }
+            }
+            return rtn;
+        }
+
+        std::set<std::string> AttachedJunctionIDs(const Road& road)
+        {
+            std::set<std::string> rtn;
+            if (road.predecessorJunction != nullptr)
+            {
+                rtn.insert(road.predecessorJunction->ID());
+            }
+            if (road.successorJunction != nullptr)
+            {
+                rtn.insert(road.successorJunction->ID());
+            }
+            return rtn;
+        }
+    }
+
+    void ChangeTracker::LoadTiled()
+    {
+        tiles.Build(odrMap);
+        spdlog::info("Large map with {} roads: only {}m tiles around camera are loaded", odrMap.id_to_road.size(), MapTileSize);
+
+        for (const auto& id2Road : odrMap.id_to_road)
+        {
+            IDGenerator::ForType(IDType::Road)->ReserveID(id2Road.first);
+        }
+        for (const auto& id2Junction : odrMap.id_to_junction)
+        {
+            IDGenerator::ForType(IDType::Junction)->ReserveID(id2Junction.first);
+        }
+
+        StreamTiles(odr::Vec2D{ g_CameraPosition[0], g_CameraPosition[1] });
+    }
+
+    void ChangeTracker::StreamTiles(const odr::Vec2D& cameraPos)
+    {
+        if (tiles.Empty())
+        {
+            return;
+        }
+        auto centerTile = MapTiles::TileAt(cameraPos[0], cameraPos[1]);
+        if (streamedTile == centerTile)
+        {
+            return;
+        }
+        if (!IDGenerator::ForType(IDType::Road)->PeekChanges().empty() ||
+            !IDGenerator::ForType(IDType::Junction)->PeekChanges().empty())
+        {
+            // Edit in progress
+            return;
+        }
+        streamedTile = centerTile;
+
+        // Wanted: roads around camera and their junctions, plus every road of those junctions
+        std::set<std::string> coreRoads = tiles.RoadsAround(centerTile, MapTileLoadRadius);
+        for (const auto& pinned : pinnedRoads)
+        {
+            auto roadIt = odrMap.id_to_road.find(pinned);
+            if (roadIt != odrMap.id_to_road.end() && roadIt->second.junction == "-1")
+            {
+                coreRoads.insert(pinned);
+            }
+        }
+
+        std::set<std::string> wantedJunctions;
+        for (const auto& pinned : pinnedJunctions)
+        {
+            // Junction without any road left can't be materialized
+            if (odrMap.id_to_junction.find(pinned) != odrMap.id_to_junction.end() &&
+                !tiles.JunctionRoads(pinned).empty())
+            {
+                wantedJunctions.insert(pinned);
+            }
+        }
+        for (const auto& roadID : coreRoads)
+        {
+            const auto& roadJunctions = tiles.RoadJunctions(roadID);
+            wantedJunctions.insert(roadJunctions.begin(), roadJunctions.end());
+        }
+
+        // road ID -> junctions to attach
+        std::map<std::string, std::set<std::string>> wantedRoads;
+        for (const auto& roadID : coreRoads)
+        {
+            wantedRoads[roadID];
+        }
+        for (const auto& junctionID : wantedJunctions)
+        {
+            for (const auto& roadID : tiles.JunctionRoads(junctionID))
+            {
+                wantedRoads[roadID];
+            }
+        }
+        std::set<std::string> wantedFringe;
+        for (auto& road2Junctions : wantedRoads)
+        {
+            for (const auto& junctionID : tiles.RoadJunctions(road2Junctions.first))
+            {
+                if (wantedJunctions.find(junctionID) != wantedJunctions.end())
+                {
+                    road2Junctions.second.insert(junctionID);
+                }
+                else
+                {
+                    wantedFringe.insert(road2Junctions.first);
+                }
+            }
+        }
+
+        // Evict what is loaded differently than wanted
+        std::set<std::string> evictRoads, loadedJunctions, evictJunctions;
+        {
+            std::vector<std::shared_ptr<Road>> toEvict;
+            for (const auto& road : World::Instance()->allRoads)
+            {
+                auto attached = AttachedJunctionIDs(*road);
+                loadedJunctions.insert(attached.begin(), attached.end());
+
+                auto wantedIt = wantedRoads.find(road->ID());
+                bool isFringe = fringeRoads.find(road->ID()) != fringeRoads.end();
+                bool wantFringe = wantedFringe.find(road->ID()) != wantedFringe.end();
+                if (wantedIt == wantedRoads.end() || wantedIt->second != attached || isFringe != wantFringe)
+                {
+                    toEvict.push_back(road);
+                }
+            }
+            for (const auto& junctionID : loadedJunctions)
+            {
+                if (wantedJunctions.find(junctionID) == wantedJunctions.end())
+                {
+                    evictJunctions.insert(junctionID);
+                }
+            }
+
+            for (const auto& junctionID : evictJunctions)
+            {
+                for (const auto& connID : ConnectingRoadIDs(odrMap.id_to_junction.at(junctionID)))
+                {
+                    auto connRoad = IDGenerator::ForType(IDType::Road)->GetByID<Road>(connID);
+                    if (connRoad != nullptr)
+                    {
+                        connRoad->ClearSectionGraphics();
+                    }
+                }
+            }
+            for (auto& road : toEvict)
+            {
+                road->ClearSectionGraphics();
+            }
+
+            Road::ClearingMap = true;
+            for (auto& road : toEvict)
+            {
+                evictRoads.insert(road->ID());
+                for (auto junction : { road->predecessorJunction, road->successorJunction })
+                {
+                    if (junction != nullptr && evictJunctions.find(junction->ID()) == evictJunctions.end())
+                    {
+                        junction->DetachNoRegenerate(road);
+                    }
+                }
+                World::Instance()->allRoads.erase(road);
+            }
+            toEvict.clear();
+            Road::ClearingMap = false;
+        }
+
+        for (const auto& roadID : evictRoads)
+        {
+            fringeRoads.erase(roadID);
+            IDGenerator::ForType(IDType::Road)->ReserveID(roadID);
+        }
+        for (const auto& junctionID : evictJunctions)
+        {
+            if (IDGenerator::ForType(IDType::Junction)->GetByID<AbstractJunction>(junctionID) != nullptr)
+            {
+                spdlog::error("Junction {} is still referenced after eviction", junctionID);
+                continue;
+            }
+            for (const auto& connID : ConnectingRoadIDs(odrMap.id_to_junction.at(junctionID)))
+            {
+                IDGenerator::ForType(IDType::Road)->ReserveID(connID);
+            }
+            IDGenerator::ForType(IDType::Junction)->ReserveID(junctionID);
+            loadedJunctions.erase(junctionID);
+        }
+
+        // Materialize what is wanted but not loaded
+        std::vector<std::shared_ptr<Road>> connectingRoadHolder;
+        std::map<std::string, std::shared_ptr<AbstractJunction>> id2RRJunction;
+        for (const auto& junctionID : wantedJunctions)
+        {
+            if (loadedJunctions.find(junctionID) != loadedJunctions.end())
+            {
+                continue;
+            }
+            const auto& odrJunction = odrMap.id_to_junction.at(junctionID);
+            for (const auto& connID : ConnectingRoadIDs(odrJunction))
+            {
+                auto connRoad = std::make_shared<Road>(odrMap.id_to_road.at(connID));
+                connRoad->GenerateAllSectionGraphics();
+                connectingRoadHolder.push_back(connRoad);
+            }
+
+            std::shared_ptr<AbstractJunction> rrJunc;
+            if (odrJunction.type == odr::JunctionType::Common)
+            {
+                rrJunc = std::make_shared<Junction>(odrJunction);
+            }
+            else
+            {
+                rrJunc = std::make_shared<DirectJunction>(odrJunction);
+            }
+            id2RRJunction.emplace(junctionID, rrJunc);
+        }
+
+        for (const auto& road2Junctions : wantedRoads)
+        {
+            if (IDGenerator::ForType(IDType::Road)->GetByID<Road>(road2Junctions.first) != nullptr)
+            {
+                continue;
+            }
+            auto rrRoad = std::make_shared<Road>(odrMap.id_to_road.at(road2Junctions.first));
+            rrRoad->GenerateAllSectionGraphics();
+            World::Instance()->allRoads.insert(rrRoad);
+
+            for (const auto& junctionID : road2Junctions.second)
+            {
+                auto junctionIt = id2RRJunction.find(junctionID);
+                auto rrJunction = junctionIt != id2RRJunction.end() ? junctionIt->second :
+                    IDGenerator::ForType(IDType::Junction)->GetByID<AbstractJunction>(junctionID)->shared_from_this();
+                if (rrRoad->generated.successor.type == odr::RoadLink::Type_Junction &&
+                    rrRoad->generated.successor.id == junctionID)
+                {
+                    rrJunction->AttachNoRegenerate(ConnectionInfo{ rrRoad, odr::RoadLink::ContactPoint_End });
+                }
+                if (rrRoad->generated.predecessor.type == odr::RoadLink::Type_Junction &&
+                    rrRoad->generated.predecessor.id == junctionID)
+                {
+                    rrJunction->AttachNoRegenerate(ConnectionInfo{ rrRoad, odr::RoadLink::ContactPoint_Start });
+                }
+            }
+
+            if (wantedFringe.find(road2Junctions.first) != wantedFringe.end())
+            {
+                rrRoad->UnIndexSectionGraphics();
+                fringeRoads.insert(road2Junctions.first);
+            }
+        }
+
+        for (auto& idAndjunc : id2RRJunction)
+        {
+            idAndjunc.second->GenerateGraphics();
+        }
+
+        spdlog::trace("Tile ({},{}) streamed: {} roads evicted, {} roads / {} junctions loaded",
+            centerTile.first, centerTile.second, evictRoads.size(), World::Instance()->allRoads.size(), wantedJunctions.size());
+
+        // Loading is not an edit
+        IDGenerator::ForType(IDType::Road)->ClearChangeList();
+        IDGenerator::ForType(IDType::Junction)->ClearChangeList();
+        PostChangeActions();
+    }
+
+    void ChangeTracker::TrackTiledChange(const MapChange& change)
+    {
+        if (tiles.Empty())
+        {
+            return;
+        }
+
+        std::set<std::string> changedRoads;
+        for (const auto& roadChange : change.roadChanges)
+        {
+            for (const auto* version : { &roadChange.before, &roadChange.after })
+            {
+                if (!version->has_value())
+                {
+                    continue;
+                }
+                const auto& odrRoad = version->get();
+                changedRoads.insert(odrRoad.id);
+                fringeRoads.erase(odrRoad.id);
+                for (const auto* link : { &odrRoad.predecessor, &odrRoad.successor })
+                {
+                    if (link->type == odr::RoadLink::Type_Junction && link->id != "-1")
+                    {
+                        pinnedJunctions.insert(link->id);
+                    }
+                }
+                if (odrRoad.junction != "-1")
+                {
+                    pinnedJunctions.insert(odrRoad.junction);
+                }
+            }
+        }
+        for (const auto& junctionChange : change.junctionChanges)
+        {
+            for (const auto* version : { &junctionChange.before, &junctionChange.after })
+            {
+                if (version->has_value())
+                {
+                    pinnedJunctions.insert(version->get().id);
+                }
+            }
+        }
+
+        pinnedRoads.insert(changedRoads.begin(), changedRoads.end());
+        tiles.Update(odrMap, changedRoads);
+        // Re-evaluate at next StreamTiles
+        streamedTile.reset();
+    }
+}
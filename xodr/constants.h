@@ -34,6 +34,12 @@ namespace LM
     const uint32_t MaxRoadID = 10240;
     const uint32_t MaxJunctionID = MaxObjectID - MaxRoadID;
 
+    // Maps with more roads are loaded tile by tile around the camera
+    const size_t TiledLoadingMinRoads = 2000;
+    const double MapTileSize = 500;
+    // Tiles within this many tiles of the camera tile are materialized
+    const int MapTileLoadRadius = 1;
+
     const uint32_t MaxRoadVertices = 1 << 24;
     const uint32_t MaxTemporaryVertices = 1 << 18;
     const uint32_t MaxInstancesPerType = 1 << 10;
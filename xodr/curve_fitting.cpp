@@ -1,4 +1,5 @@
 #include "curve_fitting.h"
+#include "spiral_fit_table.h"
 
 #include <map>
 #include <chrono>
@@ -16,6 +17,7 @@
 
 
 #ifdef G_TEST
+#include <fstream>
 #include <gtest/gtest.h>
 #endif
 
@@ -106,91 +108,133 @@ namespace LM
             true);
     }
 
-    template<typename F, typename T>
-    bool FindZeroCrossing(F function, T& x0, double tol = 7e-5)
+    namespace
     {
-        // Determine search direction
-        double step = 0.005;
-        
-        T y0 = function(x0);
-        if (std::abs(y0) < tol)
+        // 16-point Gauss-Legendre on [-1, 1]; nodes are +-GaussNodes[i]
+        const double GaussNodes[8] =
         {
-            return true;
-        }
-        if (std::isnan(y0)) return false;
-
-        // Search for boundary
-        T yPlus = function(x0 + step);
-        if (std::isnan(yPlus)) return false;
-        int stepDir = (y0 > 0 == y0 > yPlus) ? 1 : -1;
-
-        T x1 = x0 + step * stepDir;
-        T y1;
-        
-        bool boundryFound = false;
-        for (int i = 0; i != 500; ++i)
+            0.98940093499164994, 0.9445750230732326, 0.86563120238783176, 0.755404408355003,
+            0.61787624440264377, 0.45801677765722737, 0.28160355077925892, 0.095012509837637441
+        };
+        const double GaussWeights[8] =
+        {
+            0.027152459411754058, 0.062253523938647776, 0.095158511682492897, 0.12462897125553395,
+            0.14959598881657682, 0.16915651939500256, 0.18260341504492361, 0.18945061045506847
+        };
+
+        struct ClothoidEnd
+        {
+            odr::Vec2D pos;
+            odr::Vec2D dPos_dCDot;
+            odr::Vec2D dPos_dLength;
+        };
+
+        /*End of clothoid from origin towards +x, turning totalTurn over length at curvature rate cDot,
+        * so that begin curvature is totalTurn / length - cDot * length / 2.
+        * Position and its analytic derivatives are Fresnel-type integrals of heading theta(s), evaluated by quadrature:
+        * unlike odrSpiral they stay exact as cDot approaches 0.
+        */
+        ClothoidEnd EvalClothoidEnd(double totalTurn, double cDot, double length)
         {
-            y1 = function(x1);
-            if (std::isnan(y1)) return false;
-            if (y1 > 0 != y0 > 0)
+            const double k0 = totalTurn / length - cDot * length / 2;
+            const double dK0_dLength = -totalTurn / (length * length) - cDot / 2;
+
+            ClothoidEnd rtn{};
+            for (int i = 0; i != 16; ++i)
             {
-                boundryFound = true;
-                break;
+                const double node = i < 8 ? -GaussNodes[i] : GaussNodes[i - 8];
+                const double w = GaussWeights[i % 8] * length / 2;
+                const double s = (node + 1) * length / 2;
+                const double theta = k0 * s + cDot * s * s / 2;
+                const double cosT = std::cos(theta), sinT = std::sin(theta);
+                const double dTheta_dCDot = s * (s - length) / 2;
+                const double dTheta_dLength = s * dK0_dLength;
+
+                rtn.pos[0] += w * cosT;
+                rtn.pos[1] += w * sinT;
+                rtn.dPos_dCDot[0] -= w * sinT * dTheta_dCDot;
+                rtn.dPos_dCDot[1] += w * cosT * dTheta_dCDot;
+                rtn.dPos_dLength[0] -= w * sinT * dTheta_dLength;
+                rtn.dPos_dLength[1] += w * cosT * dTheta_dLength;
             }
-            step *= 1.02;
-            x1 += step * stepDir;
+            // Moving upper bound of integral, where heading is totalTurn
+            rtn.dPos_dLength[0] += std::cos(totalTurn);
+            rtn.dPos_dLength[1] += std::sin(totalTurn);
+            return rtn;
         }
 
-        if (!boundryFound)
+        /*Damped Newton on (curvature rate, length) so that clothoid turning totalTurn ends at endPos.
+        * End heading holds by construction, leaving a 2x2 system. fit carries initial guess in and solution out.
+        */
+        bool SolveUnitClothoid(const odr::Vec2D& endPos, double totalTurn, FitResult& fit, double posPrecision,
+            int maxIterations, int& complexityStat, const int complexityLimit)
         {
-            spdlog::warn("Exceed max loop while Find other bound");
-            return false;
-        }
+            double length = fit.length;
+            double cDot = (fit.endCrv - fit.beginCrv) / fit.length;
+            auto end = EvalClothoidEnd(totalTurn, cDot, length);
+            auto err = odr::sub(end.pos, endPos);
+            complexityStat++;
 
-        // Narrow down root
-        for (int i = 0; i != 80; ++i)
-        {
-            T xM = (x0 + x1) / 2;
-            T yM = function(xM);
-            if (std::isnan(yM)) return false;
-            if (std::abs(yM) < tol)
+            for (int iter = 0; iter != maxIterations; ++iter)
             {
-                x0 = xM;
-                return true;
-            }
-            if (y0 > 0 == yM > 0)
-            {
-                x0 = xM;
-                y0 = yM;
-            }
-            else
-            {
-                x1 = xM;
-                y1 = yM;
-            }
-        }
+                if (odr::norm(err) < posPrecision)
+                {
+                    fit.beginCrv = totalTurn / length - cDot * length / 2;
+                    fit.endCrv = fit.beginCrv + cDot * length;
+                    fit.length = length;
+                    return true;
+                }
 
-        spdlog::warn("Exceed max loop! x0={} x1={}", x0, x1);
-        return false;
-    }
+                const double det = end.dPos_dCDot[0] * end.dPos_dLength[1] - end.dPos_dLength[0] * end.dPos_dCDot[1];
+                if (std::abs(det) < 1e-14)
+                {
+                    break;
+                }
+                const double stepCDot = (end.dPos_dLength[0] * err[1] - end.dPos_dLength[1] * err[0]) / det;
+                const double stepLength = (end.dPos_dCDot[1] * err[0] - end.dPos_dCDot[0] * err[1]) / det;
 
-    struct FitResult
-    {
-        double beginCrv;
-        double endCrv;
-        double length;
+                // Halve step until error drops
+                bool improved = false;
+                double scale = 1;
+                for (int halving = 0; halving != 10 && !improved; ++halving, scale /= 2)
+                {
+                    const double nextLength = length + scale * stepLength;
+                    if (nextLength <= 0)
+                    {
+                        continue;
+                    }
+                    const double nextCDot = cDot + scale * stepCDot;
+                    auto nextEnd = EvalClothoidEnd(totalTurn, nextCDot, nextLength);
+                    auto nextErr = odr::sub(nextEnd.pos, endPos);
+                    complexityStat++;
+                    if (odr::norm(nextErr) < odr::norm(err))
+                    {
+                        length = nextLength;
+                        cDot = nextCDot;
+                        end = nextEnd;
+                        err = nextErr;
+                        improved = true;
+                    }
+                }
+                if (!improved || (complexityLimit != 0 && complexityStat >= complexityLimit))
+                {
+                    break;
+                }
+            }
+            return false;
+        }
 
-        template<class Archive>
-        void serialize(Archive& archive)
+        std::unique_ptr<odr::RoadGeometry> MakeUnitSpiral(const FitResult& fit)
         {
-            archive(beginCrv, endCrv, length);
+            if (fit.beginCrv == fit.endCrv)
+            {
+                return std::make_unique<odr::Arc>(0, 0, 0, 0, fit.length, fit.beginCrv);
+            }
+            return std::make_unique<odr::Spiral>(0, 0, 0, 0, fit.length, fit.beginCrv, fit.endCrv);
         }
-    };
 
-    namespace
-    {
         std::unique_ptr<odr::RoadGeometry> FitUnitSpiral(
-            const double endPosAngle, const double endHdgAngle, double posPrecision, double hdgPrecision,
+            const double endPosAngle, const double endHdgAngle, double posPrecision,
             int& complexityStat, const int complexityLimit)
         {
             const odr::Vec2D startPos{ 0, 0 };
@@ -211,127 +255,41 @@ namespace LM
                 return baseArcOrLine;
             }
 
-            const double startAngle = std::atan2(startHdg[1], startHdg[0]);
+            // Bend the arc into spiral. Small angle approximation of the curvature rate as initial guess.
+            const double totalTurn = endPosAngle + odr::angle(endPos, endHdg);
             const double arcLen = baseArc->length;
-            const double baseCrv = baseArc->curvature;
-
-            double startMul = angleErr > 0 ? 0.99 : 1.01;
-            double endMul;
-            double spiralLen = baseArc->length;
-
-            // Bend the arc int spire
-
-            auto endHdgErrorFunc = [=, &endMul, &spiralLen, &complexityStat](double startMul)
-            {
-                // Fit endMul so that spire pass through endPos
-                endMul = 2 - startMul; // Initial guess
-
-                auto endPosErrorFunc = [=, &spiralLen, &complexityStat](double endMulVar)
-                {
-                    auto spiralTest = odr::Spiral(0, startPos[0], startPos[1], startAngle, arcLen, baseCrv * startMul, baseCrv * endMulVar);
-
-                    if (!FindZeroCrossing([&spiralTest, endPos, &complexityStat, complexityLimit](double s) {
-                        complexityStat++;
-                        if (complexityStat == complexityLimit)
-                        {
-                            return std::nan("2");
-                        }
-                        return spiralTest.get_signed_error(endPos, s);
-                        }, spiralLen, posPrecision))
-                    {
-                        spdlog::warn("Inner: Cannot find closest S!");
-                        return std::nan("1");
-                    }
-
-                        double closeS = spiralLen;
-                        auto closeP = spiralTest.get_xy(closeS);
-                        auto pToTarget = odr::sub(endPos, closeP);
-                        auto grad = odr::normalize(spiralTest.get_grad(closeS));
-                        auto tan = odr::Vec2D{ grad[1], -grad[0] };
-                        auto err = odr::dot(pToTarget, tan);
-                        complexityStat++;
-                        if (complexityStat == complexityLimit)
-                        {
-                            return std::nan("2");
-                        }
-                        return err; // Signed distance for Newton
-                };
-
-                bool posFitSuccess = FindZeroCrossing(endPosErrorFunc, endMul, posPrecision);
-
-                if (!posFitSuccess)
-                {
-                    spdlog::warn("Cannot approx spiral to end pos ({}, {})", endPosAngle / M_PI * 180, endHdgAngle / M_PI * 180);
-                    return std::nan("0"); // Mark solution invalid; Exit outer loop immediately
-                }
-
-                auto spiralTest = odr::Spiral(0, startPos[0], startPos[1], startAngle, arcLen, baseCrv * startMul, baseCrv * endMul);
-
-                if (!FindZeroCrossing([&spiralTest, endPos, &complexityStat, complexityLimit](double s) {
-                    complexityStat++;
-                    if (complexityStat == complexityLimit)
-                    {
-                        return std::nan("2");
-                    }
-                    return spiralTest.get_signed_error(endPos, s);
-                    }, spiralLen, posPrecision))
-                {
-                    spdlog::warn("Outer: Cannot find closest S!");
-                    return std::nan("1");
-                }
-
-                    double closeS = spiralLen;
-                    auto candAngle = spiralTest.get_grad(closeS);
-                    auto candErr = odr::angle(endHdg, candAngle);
-                    return candErr;
-            };
-
-            // Fit startMul so that spire pass through endPos at endHdg
-            bool dirFitSuccess = FindZeroCrossing(endHdgErrorFunc, startMul, hdgPrecision);
+            const double cDot = 6 * (totalTurn - 2 * endPosAngle) / (arcLen * arcLen);
+            const double startCrv = totalTurn / arcLen - cDot * arcLen / 2;
+            FitResult fit{ startCrv, startCrv + cDot * arcLen, arcLen };
 
-            if (dirFitSuccess && endMul != 0)
+            if (!SolveUnitClothoid(endPos, totalTurn, fit, posPrecision, 50, complexityStat, complexityLimit))
             {
-                auto startCrv = baseCrv * startMul;
-                auto endCrvNL = baseCrv * endMul;
-                auto resultNoLength = odr::Spiral(0, startPos[0], startPos[1], startAngle, arcLen, startCrv, endCrvNL);
-
-                if (!FindZeroCrossing([&resultNoLength, endPos](double s) {
-                    return resultNoLength.get_signed_error(endPos, s);
-                    },
-                    spiralLen, posPrecision))
-                {
-                    spdlog::warn("Result: Cannot find closest S!");
-                    return nullptr;
-                }
-
-                    auto cDot = (endCrvNL - startCrv) / arcLen;
-                    double length = spiralLen;
-                    auto endCrv = startCrv + cDot * length;
-                    auto result = std::make_unique<odr::Spiral>(0, startPos[0], startPos[1], startAngle,
-                        length, startCrv, endCrv);
+                spdlog::warn("Cannot approx spiral to end pos ({}, {})", endPosAngle / M_PI * 180, endHdgAngle / M_PI * 180);
+                return nullptr;
+            }
 
-                    auto endP = result->get_xy(length);
-                    auto endH = result->get_grad(length);
-                    auto pError = odr::euclDistance(endP, endPos);
-                    auto hError = odr::angle(endH, endHdg);
+            auto result = MakeUnitSpiral(fit);
+            auto endP = result->get_xy(fit.length);
+            auto endH = result->get_grad(fit.length);
+            auto pError = odr::euclDistance(endP, endPos);
+            auto hError = odr::angle(endH, endHdg);
 
-                    spdlog::trace("[ANS] start mul = {}, end mul = {}, len = {} => pErr = {}, hErr = {}",
-                        startMul, endMul, length, pError, hError);
+            spdlog::trace("[ANS] start crv = {}, end crv = {}, len = {} => pErr = {}, hErr = {}",
+                fit.beginCrv, fit.endCrv, fit.length, pError, hError);
 
 // Don't need self-check in normal run, as stepwise verification will cover this.
 #ifdef G_TEST
-                    if (pError > SpiralPosPrecision || std::abs(hError) > SpiralHdgPrecision)
-                    {
-                        spdlog::error("[Fail check] {},{}", pError, hError);
-                        return nullptr;
-                    }
-#endif
-                    return result;
+            if (pError > SpiralPosPrecision || std::abs(hError) > SpiralHdgPrecision)
+            {
+                spdlog::error("[Fail check] {},{}", pError, hError);
+                return nullptr;
             }
-            return nullptr;
+#endif
+            return result;
         }
     }
 
+
     const std::map<int, std::pair<int, int>> posAngleCombo =
     {
         {5, {5, 60}},
@@ -370,6 +328,63 @@ namespace LM
 
     constexpr double degToRad = M_PI / 180;
 
+    namespace
+    {
+        // Interpolate SpiralFitTable, then a few Newton iterations. nullptr if not converged.
+        std::unique_ptr<odr::RoadGeometry> LookupUnitSpiral(
+            const double endPosAngle, const double endHdgAngle, double posPrecision)
+        {
+            const odr::Vec2D startPos{ 0, 0 };
+            const odr::Vec2D startHdg{ 1, 0 };
+            const odr::Vec2D endPos = odr::mut(UnitRadius, odr::Vec2D{ std::cos(endPosAngle), std::sin(endPosAngle) });
+            const odr::Vec2D endHdg{ std::cos(endHdgAngle), std::sin(endHdgAngle) };
+
+            auto baseArcOrLine = FitArcOrLine(startPos, startHdg, endPos);
+            auto baseArc = dynamic_cast<odr::Arc*>(baseArcOrLine.get());
+            if (baseArc == nullptr)
+                return nullptr;
+            if (std::abs(odr::angle(endHdg, baseArc->get_grad(baseArc->length))) < 1e-4)
+            {
+                return baseArcOrLine;
+            }
+
+            // Bilinear interpolation between the 4 table entries around input
+            const double turnAngle = odr::angle(endPos, endHdg);
+            const double posIndex = (endPosAngle / degToRad - SpiralFitTable::PosAngleBegin) / SpiralFitTable::AngleStep;
+            const double turnIndex = (turnAngle / degToRad - SpiralFitTable::TurnAngleBegin) / SpiralFitTable::AngleStep;
+            const int i0 = std::min(std::max(static_cast<int>(std::floor(posIndex)), 0), SpiralFitTable::NPosAngle - 2);
+            const int j0 = std::min(std::max(static_cast<int>(std::floor(turnIndex)), 0), SpiralFitTable::NTurnAngle - 2);
+            const double u = posIndex - i0, v = turnIndex - j0;
+            if (u < 0 || u > 1 || v < 0 || v > 1)
+            {
+                return nullptr;
+            }
+
+            auto lerpEntry = [&](double FitResult::* field)
+            {
+                const auto& rowLo = SpiralFitTable::Entries[i0];
+                const auto& rowHi = SpiralFitTable::Entries[i0 + 1];
+                return (1 - u) * ((1 - v) * rowLo[j0].*field + v * rowLo[j0 + 1].*field) +
+                    u * ((1 - v) * rowHi[j0].*field + v * rowHi[j0 + 1].*field);
+            };
+            FitResult fit{ lerpEntry(&FitResult::beginCrv), lerpEntry(&FitResult::endCrv), lerpEntry(&FitResult::length) };
+            if (std::isnan(fit.beginCrv) || std::isnan(fit.endCrv) || std::isnan(fit.length))
+            {
+                return nullptr;
+            }
+
+            // End heading is exact after solving, so only position precision is checked
+            int complexity = 0;
+            if (!SolveUnitClothoid(endPos, endPosAngle + turnAngle, fit, posPrecision, 8, complexity, 0))
+            {
+                spdlog::trace("[Table] Not converged at ({}, {})", endPosAngle / degToRad, endHdgAngle / degToRad);
+                return nullptr;
+            }
+            spdlog::trace("[Table] {} evaluations", complexity);
+            return MakeUnitSpiral(fit);
+        }
+    }
+
     std::unique_ptr<odr::RoadGeometry> FitSpiral(const odr::Vec2D& startPos, const odr::Vec2D& startHdg,
         const odr::Vec2D& endPos, const odr::Vec2D& endHdg)
     {
@@ -414,9 +429,14 @@ namespace LM
             return nullptr;
         }
 
-        // Do the fitting, but constrain complexity to avoid UI freeze
-        int complexityStat = 0;
-        auto fitResult = FitUnitSpiral(localPAngle, localA, SpiralPosPrecision * 0.7 / lengthBoost, SpiralHdgPrecision * 0.7, complexityStat, 400000);
+        const double posPrecision = SpiralPosPrecision * 0.7 / lengthBoost;
+        auto fitResult = LookupUnitSpiral(localPAngle, localA, posPrecision);
+        if (fitResult == nullptr)
+        {
+            // Do the fitting, but constrain complexity to avoid UI freeze
+            int complexityStat = 0;
+            fitResult = FitUnitSpiral(localPAngle, localA, posPrecision, complexityStat, 400000);
+        }
         if (fitResult != nullptr)
         {
             auto globalA = std::atan2(startHdg[1], startHdg[0]);
@@ -500,6 +520,26 @@ namespace LM
     }
 
 #ifdef G_TEST
+    namespace
+    {
+        bool ToFitResult(const odr::RoadGeometry* fitGeo, FitResult& res)
+        {
+            auto fitArc = dynamic_cast<const odr::Arc*>(fitGeo);
+            auto fitSpiral = dynamic_cast<const odr::Spiral*>(fitGeo);
+            if (fitArc != nullptr)
+            {
+                res = FitResult{ fitArc->curvature, fitArc->curvature, fitArc->length };
+                return true;
+            }
+            if (fitSpiral != nullptr)
+            {
+                res = FitResult{ fitSpiral->curv_start, fitSpiral->curv_end, fitSpiral->length };
+                return true;
+            }
+            return false;
+        }
+    }
+
     void TestSpiralFitting()
     {
         std::vector<double> timeStats;
@@ -520,7 +560,7 @@ namespace LM
                 auto t_start = high_resolution_clock::now();
                 auto fitGeo = LM::FitUnitSpiral(
                     posAngle * degToRad, hdgAngle * degToRad,
-                    SpiralPosPrecision * 0.7 / MaximumLengthBoost, SpiralHdgPrecision * 0.7 / MaximumLengthBoost, complexity);
+                    SpiralPosPrecision * 0.7 / MaximumLengthBoost, complexity);
                 auto t_end = high_resolution_clock::now();
                 auto duration = duration_cast<microseconds>(t_end - t_start).count();
                 timeStats.push_back(static_cast<double>(duration) / 1000000);
@@ -533,21 +573,18 @@ namespace LM
                 }
 
                 FitResult res;
-                auto fitArc = dynamic_cast<odr::Arc*>(fitGeo.get());
-                auto fitSpiral = dynamic_cast<odr::Spiral*>(fitGeo.get());
-                if (fitArc != nullptr)
-                {
-                    res = FitResult{ fitArc->curvature, fitArc->curvature, fitArc->length };
-                }
-                else if (fitSpiral != nullptr)
-                {
-                    res = FitResult{ fitSpiral->curv_start, fitSpiral->curv_end, fitSpiral->length };
-                }
-                else
+                if (!ToFitResult(fitGeo.get(), res))
                 {
                     FAIL();
                 }
                 hdgToRes.emplace(hdg, res);
+
+                // Shipped table must agree with solver
+                const auto& tableRes = SpiralFitTable::Entries[(posAngle - SpiralFitTable::PosAngleBegin) / SpiralFitTable::AngleStep]
+                    [(hdg - SpiralFitTable::TurnAngleBegin) / SpiralFitTable::AngleStep];
+                EXPECT_NEAR(res.beginCrv, tableRes.beginCrv, 1e-5) << "Table out of date at angle " << posAngle << " hdg " << hdg;
+                EXPECT_NEAR(res.endCrv, tableRes.endCrv, 1e-5) << "Table out of date at angle " << posAngle << " hdg " << hdg;
+                EXPECT_NEAR(res.length, tableRes.length, 1e-4) << "Table out of date at angle " << posAngle << " hdg " << hdg;
             }
         }
         std::sort(timeStats.begin(), timeStats.end());
@@ -558,5 +595,69 @@ namespace LM
             timeStats[percentile],
             complexityStats[percentile]);
     }
+
+    void GenerateSpiralFitTable(const std::string& path)
+    {
+        std::ofstream out(path);
+        ASSERT_TRUE(out.good()) << "Cannot write " << path;
+        out << R"(#pragma once
+
+#include "curve_fitting.h"
+
+#include <limits>
+
+namespace LM
+{
+    /*FitUnitSpiral solutions sampled offline on the posAngleCombo grid, at the precision of TestSpiralFitting.
+    * Entries[i][j]: end pos angle PosAngleBegin + i * AngleStep, turn angle TurnAngleBegin + j * AngleStep (degrees).
+    * Cells outside posAngleCombo are NaN. TestSpiralFitting checks the table against the solver.
+    * Generated by GenerateSpiralFitTable; to regenerate, run from this directory:
+    *   LaneMakerTest --gtest_also_run_disabled_tests --gtest_filter=RoadGeometry.DISABLED_GenerateSpiralFitTable
+    */
+    namespace SpiralFitTable
+    {
+)";
+        out << fmt::format("        const int AngleStep = {};\n", SpiralFitTable::AngleStep);
+        out << fmt::format("        const int PosAngleBegin = {};\n", SpiralFitTable::PosAngleBegin);
+        out << fmt::format("        const int TurnAngleBegin = {};\n", SpiralFitTable::TurnAngleBegin);
+        out << fmt::format("        const int NPosAngle = {};\n", SpiralFitTable::NPosAngle);
+        out << fmt::format("        const int NTurnAngle = {};\n", SpiralFitTable::NTurnAngle);
+        out << R"(
+        constexpr double NA = std::numeric_limits<double>::quiet_NaN();
+
+        const FitResult Entries[NPosAngle][NTurnAngle] =
+        {
+)";
+        for (int i = 0; i != SpiralFitTable::NPosAngle; ++i)
+        {
+            const int posAngle = SpiralFitTable::PosAngleBegin + i * SpiralFitTable::AngleStep;
+            auto turnRange = posAngleCombo.find(posAngle);
+            out << fmt::format("            // pos angle {}\n            {{\n", posAngle);
+            for (int j = 0; j != SpiralFitTable::NTurnAngle; ++j)
+            {
+                const int turnAngle = SpiralFitTable::TurnAngleBegin + j * SpiralFitTable::AngleStep;
+                std::string cell = "{ NA, NA, NA }";
+                if (turnRange != posAngleCombo.end() &&
+                    turnRange->second.first <= turnAngle && turnAngle <= turnRange->second.second)
+                {
+                    int complexity = 0;
+                    auto fitGeo = LM::FitUnitSpiral(
+                        posAngle * degToRad, (posAngle + turnAngle) * degToRad,
+                        SpiralPosPrecision * 0.7 / MaximumLengthBoost, complexity);
+                    FitResult res;
+                    ASSERT_TRUE(ToFitResult(fitGeo.get(), res)) << "No ans at angle " << posAngle << " hdg " << turnAngle;
+                    cell = fmt::format("{{ {:.10g}, {:.10g}, {:.10g} }}", res.beginCrv, res.endCrv, res.length);
+                }
+                out << (j % 3 == 0 ? "                " : " ") << cell << ",";
+                if (j % 3 == 2 || j == SpiralFitTable::NTurnAngle - 1)
+                {
+                    out << "\n";
+                }
+            }
+            out << "            },\n";
+        }
+        out << "        };\n    }\n}\n";
+        spdlog::info("Spiral fit table written to {}", path);
+    }
 #endif
 }
\ No newline at end of file
@@ -11,6 +11,19 @@ namespace LM
     std::unique_ptr<odr::RoadGeometry> FitParamPoly(const odr::Vec2D& startPos, const odr::Vec2D& startHdg,
         const odr::Vec2D& endPos, const odr::Vec2D& endHdg);
 
+    struct FitResult
+    {
+        double beginCrv;
+        double endCrv;
+        double length;
+
+        template<class Archive>
+        void serialize(Archive& archive)
+        {
+            archive(beginCrv, endCrv, length);
+        }
+    };
+
     namespace
     {
         /*Algorithm designed for this precesion for R < 500*/
@@ -21,7 +34,7 @@ namespace LM
 
         std::unique_ptr<odr::RoadGeometry> FitUnitSpiral(
             const double endPosAngle, const double endHdgAngle,
-            double posPrecision, double hdgPrecision,
+            double posPrecision,
             int& complexityStat, const int complexityLimit = 0);
     }
 
@@ -31,6 +44,9 @@ namespace LM
 
 #ifdef G_TEST
     void TestSpiralFitting();
+
+    // Writes spiral_fit_table.h from FitUnitSpiral solutions
+    void GenerateSpiralFitTable(const std::string& path);
 #endif
 
     std::unique_ptr<odr::RoadGeometry> FitArcOrLine(const odr::Vec2D& startPos,
@@ -96,12 +96,25 @@ void IDGenerator::TakeID(std::string sid, void* object)
     {
         assigned.resize(id + 1, false);
     }
-    assert(!assigned[id]);
+    assert(!assigned[id] || reserved.find(id) != reserved.end());
     assert(assignTo.find(id) == assignTo.end());
+    reserved.erase(id);
     assigned[id] = true;
     assignTo.emplace(id, object);
 }
 
+void IDGenerator::ReserveID(const std::string& sid)
+{
+    auto id = static_cast<size_t>(std::atoi(sid.c_str()));
+    if (assigned.size() <= id)
+    {
+        assigned.resize(id + 1, false);
+    }
+    assert(assignTo.find(id) == assignTo.end());
+    assigned[id] = true;
+    reserved.insert(id);
+}
+
 void IDGenerator::ClearChangeList()
 {
     changeList.clear();
@@ -111,5 +124,6 @@ void IDGenerator::reset()
 {
     assigned.clear();
     assignTo.clear();
+    reserved.clear();
     changeList.clear();
 }
\ No newline at end of file
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <map>
+#include <set>
 #include <string>
 #include <vector>
 #include <memory>
@@ -34,6 +35,7 @@ public:
     void NotifyChange(const std::string&);  // Added to changeList
     bool FreeID(const std::string&);  // Added to changeList
     void TakeID(std::string id, void* object); // Maintain ID from serialized
+    void ReserveID(const std::string& id); // Keep ID from being generated while its object is not loaded
 
     template <class T>
     T* GetByID(std::string sid)
@@ -60,6 +62,7 @@ private:
 
     std::vector<bool> assigned;
     std::map<size_t, void*> assignTo;
+    std::set<size_t> reserved;
 
     std::map<size_t, void*> changeList; // Changes since last time ConsumeChanges() was called
 };
@@ -45,6 +45,9 @@ namespace LM
         connRoad->GenerateOrUpdateSectionGraphicsBetween(0.0, connRoad->Length());
 #endif
 
+        // Rebuilt from live roads below, which covers any pending change
+        regenPending = false;
+
         std::vector<ConnectionInfo> newConnections = { conn };
         for (auto existing : formedFrom)
         {
@@ -111,9 +114,26 @@ namespace LM
         }
         else if (needReGen && updatedInfoList.size() > 1)
         {
-            spdlog::trace("Junction {} regen from {} roads", ID(), updatedInfoList.size());
+            regenerationCounter.requested++;
             formedFrom.clear();
-            CreateFrom(updatedInfoList);
+            auto self = weak_from_this();
+            if (deferRegeneration && !self.expired())
+            {
+                // Next notification compares against these, so a road changing back and forth stays pending only once
+                formedFrom.insert(updatedInfoList.cbegin(), updatedInfoList.cend());
+                if (!regenPending)
+                {
+                    regenPending = true;
+                    pendingRegeneration.push_back(self);
+                }
+            }
+            else
+            {
+                spdlog::trace("Junction {} regen from {} roads", ID(), updatedInfoList.size());
+                regenPending = false;
+                regenerationCounter.performed++;
+                CreateFrom(updatedInfoList);
+            }
         }
         else if (updatedInfoList.size() == 1)
         {
@@ -138,6 +158,101 @@ namespace LM
         }
     }
 
+    bool AbstractJunction::deferRegeneration = false;
+
+    std::vector<std::weak_ptr<AbstractJunction>> AbstractJunction::pendingRegeneration;
+
+    AbstractJunction::RegenerationCounter AbstractJunction::regenerationCounter;
+
+    void AbstractJunction::BeginDeferRegeneration()
+    {
+        deferRegeneration = true;
+    }
+
+    void AbstractJunction::EndDeferRegeneration()
+    {
+        try
+        {
+            RegeneratePending();
+        }
+        catch (...)
+        {
+            deferRegeneration = false;
+            throw;
+        }
+        deferRegeneration = false;
+    }
+
+    void AbstractJunction::AbortDeferRegeneration()
+    {
+        DropPending();
+        deferRegeneration = false;
+    }
+
+    void AbstractJunction::RegeneratePending()
+    {
+        try
+        {
+            // Regeneration may notify other junctions, which append to the list
+            for (size_t i = 0; i != pendingRegeneration.size(); ++i)
+            {
+                auto junction = pendingRegeneration[i].lock();
+                if (junction != nullptr)
+                {
+                    junction->RegenerateIfPending();
+                }
+            }
+        }
+        catch (...)
+        {
+            DropPending();
+            throw;
+        }
+        pendingRegeneration.clear();
+        spdlog::trace("Junction regen: {} requested, {} performed",
+            regenerationCounter.requested, regenerationCounter.performed);
+    }
+
+    void AbstractJunction::DropPending()
+    {
+        // A junction left marked but off the list would never be queued again
+        for (const auto& pending : pendingRegeneration)
+        {
+            auto junction = pending.lock();
+            if (junction != nullptr)
+            {
+                junction->regenPending = false;
+            }
+        }
+        pendingRegeneration.clear();
+    }
+
+    void AbstractJunction::RegenerateIfPending()
+    {
+        if (!regenPending)
+        {
+            return;
+        }
+        regenPending = false;
+
+        std::vector<ConnectionInfo> updatedInfoList;
+        for (const auto& record : formedFrom)
+        {
+            auto recordedRoad = record.road.lock();
+            if (recordedRoad != nullptr)
+            {
+                updatedInfoList.push_back(ConnectionInfo(recordedRoad, record.contact, record.skipProviderLanes));
+            }
+        }
+        if (updatedInfoList.size() > 1)
+        {
+            spdlog::trace("Junction {} regen from {} roads", ID(), updatedInfoList.size());
+            formedFrom.clear();
+            regenerationCounter.performed++;
+            CreateFrom(updatedInfoList);
+        }
+    }
+
     void AbstractJunction::AttachNoRegenerate(ConnectionInfo conn)
     {
         formedFrom.insert(conn);
@@ -386,7 +501,7 @@ namespace LM
         odr::Line2D rasterizedBoundary;
         for (auto segment : generated.boundary)
         {
-            auto road = IDGenerator::ForType(IDType::Road)->GetByID<Road>(segment.road)->generated;
+            const auto& road = IDGenerator::ForType(IDType::Road)->GetByID<Road>(segment.road)->generated;
             if (segment.type == odr::BoundarySegmentType::Lane)
             {
                 int nPoints = std::ceil(std::abs(segment.sBegin - segment.sEnd) / Resolution);
@@ -462,14 +577,23 @@ namespace LM
 
     void Junction::GenerateSignalPhase()
     {
-        std::map<std::pair<std::string, std::string>, bool> conflictResultBuffer;
         std::vector<std::shared_ptr<Road>> pendingAssign;
+        std::vector<const odr::Road*> conflictSlots;
+        std::map<const Road*, size_t> roadToSlot;
 
         for (auto road : connectingRoads)
         {
             pendingAssign.push_back(road);
+            roadToSlot.emplace(road.get(), conflictSlots.size());
+            conflictSlots.push_back(&road->generated);
         }
 
+        const ConflictMatrix conflicts = connRoadsConflictMatrix(conflictSlots);
+        auto inConflict = [&](const std::shared_ptr<Road>& roadA, const std::shared_ptr<Road>& roadB)
+        {
+            return conflicts.Conflict(roadToSlot.at(roadA.get()), roadToSlot.at(roadB.get()));
+        };
+
         std::sort(pendingAssign.begin(), pendingAssign.end(),
             [](const std::shared_ptr<Road>& roadA, const std::shared_ptr<Road>& roadB)
             {
@@ -527,7 +651,7 @@ namespace LM
                 bool hasConflict = false;
                 for (auto existingMember: group)
                 {
-                    if (connRoadsConflictBuffered(candidate->generated, existingMember->generated, conflictResultBuffer))
+                    if (inConflict(candidate, existingMember))
                     {
                         hasConflict = true;
                         break;
@@ -555,7 +679,7 @@ namespace LM
                     bool hasConflict = false;
                     for (auto existingMember : expandedGroup[i])
                     {
-                        if (connRoadsConflictBuffered(candidate->generated, existingMember->generated, conflictResultBuffer))
+                        if (inConflict(candidate, existingMember))
                         {
                             hasConflict = true;
                             break;
@@ -765,7 +889,7 @@ namespace LM
             {
                 throw;
             }
-            auto touchingSection = interfaceProvider->generated.get_lanesection(sectionS);
+            const auto& touchingSection = interfaceProvider->generated.get_lanesection(sectionS);
 
             bool recovered = false;
             for (auto idAndConn : generated.id_to_connection)
@@ -779,7 +903,7 @@ namespace LM
                     }
 
                     int interfaceProvideSide = idAndConn.second.lane_links.begin()->from < 0 ? -1 : 1;
-                    int innerMostLane = touchingSection.get_sorted_driving_lanes(interfaceProvideSide).begin()->id;
+                    int innerMostLane = touchingSection.get_driving_lane(interfaceProvideSide, false)->id;
                     conn.skipProviderLanes = std::abs(innerMostLinkedABS - std::abs(innerMostLane));
                     recovered = true;
                     break;
@@ -141,8 +141,37 @@ namespace LM
     // Only used to unlink the last (only) road when all rest
     void clearLinkage(std::string junctionID, std::string regularRoad);
 
-    bool connRoadsConflictBuffered(const odr::Road& roadA, const odr::Road& roadB,
-        std::map<std::pair<std::string, std::string>, bool>& buffer);
+    bool connRoadsConflict(const odr::Road& roadA, const odr::Road& roadB);
+
+    // Symmetric conflict bits of connecting roads, indexed by slot in the list they were built from
+    class ConflictMatrix
+    {
+    public:
+        ConflictMatrix(size_t aSize) : size(aSize), rowWords((aSize + 63) / 64), bits(aSize * rowWords, 0) {}
+
+        bool Conflict(size_t i, size_t j) const
+        {
+            return (bits[i * rowWords + j / 64] >> (j % 64)) & 1;
+        }
+
+        void SetConflict(size_t i, size_t j)
+        {
+            bits[i * rowWords + j / 64] |= uint64_t(1) << (j % 64);
+            bits[j * rowWords + i / 64] |= uint64_t(1) << (i % 64);
+        }
+
+        size_t Size() const { return size; }
+
+    private:
+        size_t size;
+        size_t rowWords;
+        std::vector<uint64_t> bits;
+    };
+
+    /*Same result as connRoadsConflict on every pair.
+    * Pairs whose border boxes are apart skip borderIntersect; the rest run on all cores.
+    */
+    ConflictMatrix connRoadsConflictMatrix(const std::vector<const odr::Road*>& roads);
 
     struct ChangeInConnecting
     {
@@ -173,6 +202,22 @@ namespace LM
         void NotifyPotentialChange(); /*Call this when connected roads get deleted or modified*/
         void NotifyPotentialChange(const ChangeInConnecting&);
 
+        /*While deferred, a change found by NotifyPotentialChange only updates formedFrom and marks the junction pending.
+        * RegeneratePending rebuilds each pending junction once, however many changes it was notified of.
+        */
+        static void BeginDeferRegeneration();
+        static void EndDeferRegeneration(); /*Also regenerates pending. Deferral ends even if that throws*/
+        static void AbortDeferRegeneration(); /*Ends deferral of a failed edit: pending junctions are dropped, not regenerated*/
+        static void RegeneratePending(); /*Pending list is emptied even if a regeneration throws*/
+        void RegenerateIfPending(); /*Call before reading generationError while deferred*/
+
+        struct RegenerationCounter
+        {
+            size_t requested = 0; // Changes found by NotifyPotentialChange
+            size_t performed = 0;
+        };
+        static RegenerationCounter regenerationCounter;
+
         virtual void AttachNoRegenerate(ConnectionInfo);
         void DetachNoRegenerate(std::shared_ptr<Road>);
 
@@ -207,6 +252,15 @@ namespace LM
 #ifndef G_TEST
         std::unique_ptr<JunctionGraphics> junctionGraphics;
 #endif
+
+    private:
+        bool regenPending = false;
+
+        // Unmarks and forgets pending junctions
+        static void DropPending();
+
+        static bool deferRegeneration;
+        static std::vector<std::weak_ptr<AbstractJunction>> pendingRegeneration;
     };
 
     // TODO: inherit same class as Road to manage ID
@@ -271,42 +271,74 @@ namespace LM
             }
         }
 
-        // Compute ref lines
+        // Ref lines and lanes of connecting roads are built on all cores.
+        // IDs and linkage are assigned serially in turningGroups order, same as a serial build.
+        std::vector<const std::pair<const std::pair<RoadEndpoint, RoadEndpoint>, TurningGroup>*> turnings;
         for (const auto& turningKv : turningGroups)
         {
-            TurningGroup turningGroup = turningKv.second;
-
-            odr::Vec2D incomingRight{ turningGroup.fromForward[1], -turningGroup.fromForward[0] };
-            double incomingCenterS =
-                LM::LaneWidth * turningGroup.fromLaneIDBase +
-                LM::LaneWidth * turningGroup.nLanes / 2;
-            odr::Vec2D incomingCenter = odr::add(
-                turningGroup.fromOrigin,
-                odr::mut(incomingCenterS, incomingRight));
-
-            // Assume outgoing always start from leftmost lane for now
-            odr::Vec2D outgoingRight{ turningGroup.toForward[1], -turningGroup.toForward[0] };
-            double outgoingCenetrS =
-                LM::LaneWidth * turningGroup.toLaneIDBase +
-                LM::LaneWidth * turningGroup.nLanes / 2;
-            odr::Vec2D outgoingCenter = odr::add(
-                turningGroup.toOrigin,
-                odr::mut(outgoingCenetrS, outgoingRight));
-
-            auto connectingRefLine = ConnectRays(
-                incomingCenter, turningGroup.fromForward,
-                outgoingCenter, turningGroup.toForward);
-
-            if (connectingRefLine == nullptr)
+            turnings.push_back(&turningKv);
+        }
+
+        std::vector<std::unique_ptr<odr::RoadGeometry>> connectingRefLines(turnings.size());
+        odr::parallel_for(turnings.size(), odr::get_worker_count(turnings.size(), 0),
+            [&](const std::size_t i, const std::size_t)
+            {
+                const TurningGroup& turningGroup = turnings[i]->second;
+
+                odr::Vec2D incomingRight{ turningGroup.fromForward[1], -turningGroup.fromForward[0] };
+                double incomingCenterS =
+                    LM::LaneWidth * turningGroup.fromLaneIDBase +
+                    LM::LaneWidth * turningGroup.nLanes / 2;
+                odr::Vec2D incomingCenter = odr::add(
+                    turningGroup.fromOrigin,
+                    odr::mut(incomingCenterS, incomingRight));
+
+                // Assume outgoing always start from leftmost lane for now
+                odr::Vec2D outgoingRight{ turningGroup.toForward[1], -turningGroup.toForward[0] };
+                double outgoingCenetrS =
+                    LM::LaneWidth * turningGroup.toLaneIDBase +
+                    LM::LaneWidth * turningGroup.nLanes / 2;
+                odr::Vec2D outgoingCenter = odr::add(
+                    turningGroup.toOrigin,
+                    odr::mut(outgoingCenetrS, outgoingRight));
+
+                connectingRefLines[i] = ConnectRays(
+                    incomingCenter, turningGroup.fromForward,
+                    outgoingCenter, turningGroup.toForward);
+            });
+
+        std::vector<std::shared_ptr<Road>> builtConnectings(turnings.size());
+        for (size_t i = 0; i != turnings.size(); ++i)
+        {
+            if (connectingRefLines[i] == nullptr)
             {
                 errorCode |= Junction_ConnectionInvalidShape;
                 continue;
             }
 
+            const TurningGroup& turningGroup = turnings[i]->second;
             LM::LaneProfile connectingProfile(0, 0, turningGroup.nLanes, turningGroup.nLanes);
+            builtConnectings[i] = std::make_shared<Road>(connectingProfile, std::move(connectingRefLines[i]), false);
+        }
 
-            auto connecting = std::make_shared<Road>(connectingProfile, std::move(connectingRefLine));
-            connecting->Generate();
+        odr::parallel_for(turnings.size(), odr::get_worker_count(turnings.size(), 0),
+            [&](const std::size_t i, const std::size_t)
+            {
+                if (builtConnectings[i] != nullptr)
+                {
+                    builtConnectings[i]->GenerateLanes();
+                }
+            });
+
+        for (size_t turningIndex = 0; turningIndex != turnings.size(); ++turningIndex)
+        {
+            auto& connecting = builtConnectings[turningIndex];
+            if (connecting == nullptr)
+            {
+                continue;
+            }
+            const auto& turningKv = *turnings[turningIndex];
+            const TurningGroup& turningGroup = turningKv.second;
 
             // Assign linkage
             odr::Road& connRoad = connecting->generated;
@@ -617,21 +649,23 @@ namespace LM
         }
     }
 
-    bool connRoadsConflict(const odr::Road& roadA, const odr::Road& roadB)
+    // True if lane links alone decide whether roadA and roadB conflict
+    bool laneLinksDecideConflict(const odr::Road& roadA, const odr::Road& roadB, bool& outConflict)
     {
         // If two connecting roads go into the same road end point
         if (roadA.successor.id == roadB.successor.id &&
             roadA.successor.contact_point == roadB.successor.contact_point)
         {
             std::set<int> roadASuccessors;
-            for (auto laneA : roadA.s_to_lanesection.rbegin()->second.id_to_lane)
+            for (const auto& laneA : roadA.s_to_lanesection.rbegin()->second.id_to_lane)
             {
                 roadASuccessors.emplace(laneA.second.successor);
             }
-            for (auto laneB : roadB.s_to_lanesection.rbegin()->second.id_to_lane)
+            for (const auto& laneB : roadB.s_to_lanesection.rbegin()->second.id_to_lane)
             {
                 if (roadASuccessors.find(laneB.second.successor) != roadASuccessors.end())
                 {
+                    outConflict = true;
                     return true;
                 }
             }
@@ -642,36 +676,79 @@ namespace LM
         if (roadA.predecessor.id == roadB.predecessor.id)
         {
             std::set<int> roadAPredecessors;
-            for (auto laneA : roadA.s_to_lanesection.begin()->second.id_to_lane)
+            for (const auto& laneA : roadA.s_to_lanesection.begin()->second.id_to_lane)
             {
                 roadAPredecessors.emplace(laneA.second.predecessor);
             }
-            for (auto laneB : roadB.s_to_lanesection.begin()->second.id_to_lane)
+            for (const auto& laneB : roadB.s_to_lanesection.begin()->second.id_to_lane)
             {
                 if (roadAPredecessors.find(laneB.second.predecessor) != roadAPredecessors.end())
                 {
-                    return false;
+                    outConflict = false;
+                    return true;
                 }
             }
         }
-        
+        return false;
+    }
+
+    bool connRoadsConflict(const odr::Road& roadA, const odr::Road& roadB)
+    {
+        bool conflict;
+        if (laneLinksDecideConflict(roadA, roadB, conflict))
+        {
+            return conflict;
+        }
+
         double outSA, outSB;
         return borderIntersect(roadA, -1, roadB, -1, outSA, outSB);
     }
 
-    bool connRoadsConflictBuffered(const odr::Road& roadA, const odr::Road& roadB, std::map<std::pair<std::string, std::string>, bool>& conflictResultBuffer)
+    ConflictMatrix connRoadsConflictMatrix(const std::vector<const odr::Road*>& roads)
     {
-        bool conflict;
-        if (conflictResultBuffer.find(std::make_pair(roadA.id, roadB.id)) == conflictResultBuffer.end())
+        ConflictMatrix rtn(roads.size());
+
+        std::vector<BorderBox> borderBoxes(roads.size());
+        odr::parallel_for(roads.size(), odr::get_worker_count(roads.size(), 0),
+            [&](const std::size_t i, const std::size_t) { borderBoxes[i] = borderBoundingBox(*roads[i], -1); });
+
+        std::vector<std::pair<size_t, size_t>> pendingIntersect;
+        for (size_t i = 0; i != roads.size(); ++i)
         {
-            conflict = connRoadsConflict(roadA, roadB);
-            conflictResultBuffer.emplace(std::make_pair(roadA.id, roadB.id), conflict);
-            conflictResultBuffer.emplace(std::make_pair(roadB.id, roadA.id), conflict);
+            for (size_t j = i + 1; j != roads.size(); ++j)
+            {
+                bool conflict;
+                if (laneLinksDecideConflict(*roads[i], *roads[j], conflict))
+                {
+                    if (conflict)
+                    {
+                        rtn.SetConflict(i, j);
+                    }
+                }
+                else if (borderBoxes[i].Overlaps(borderBoxes[j]))
+                {
+                    pendingIntersect.emplace_back(i, j);
+                }
+            }
         }
-        else
+
+        // Bits share words, so workers write one byte per pair
+        std::vector<char> intersects(pendingIntersect.size(), 0);
+        odr::parallel_for(pendingIntersect.size(), odr::get_worker_count(pendingIntersect.size(), 0),
+            [&](const std::size_t k, const std::size_t)
+            {
+                double outSA, outSB;
+                const auto& pair = pendingIntersect[k];
+                intersects[k] = borderIntersect(*roads[pair.first], -1, *roads[pair.second], -1, outSA, outSB);
+            });
+
+        for (size_t k = 0; k != pendingIntersect.size(); ++k)
         {
-            conflict = conflictResultBuffer.at(std::make_pair(roadA.id, roadB.id));
+            if (intersects[k])
+            {
+                rtn.SetConflict(pendingIntersect[k].first, pendingIntersect[k].second);
+            }
         }
-        return conflict;
+        return rtn;
     }
 }
@@ -0,0 +1,660 @@
+#include "map_snapshot.h"
+
+#include "Geometries/Arc.h"
+#include "Geometries/Line.h"
+#include "Geometries/ParamPoly3.h"
+#include "Geometries/Spiral.h"
+
+#include <cereal/archives/binary.hpp>
+#include <cereal/types/string.hpp>
+
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <type_traits>
+#include <spdlog/spdlog.h>
+
+namespace LM
+{
+    namespace
+    {
+        const char     SnapshotMagic[] = "LMSNAP";
+        const uint32_t SnapshotVersion = 1;
+
+        // Placeholders for element types without default constructor; every field gets overwritten by Read()
+        template<class T>
+        T Blank()
+        {
+            return T();
+        }
+        template<>
+        odr::Road Blank<odr::Road>()
+        {
+            return odr::Road("", 0, "");
+        }
+        template<>
+        odr::Junction Blank<odr::Junction>()
+        {
+            return odr::Junction("", "", odr::JunctionType::Common);
+        }
+        template<>
+        odr::JunctionConnection Blank<odr::JunctionConnection>()
+        {
+            return odr::JunctionConnection("", "", "", odr::JunctionConnection::ContactPoint_None);
+        }
+        template<>
+        odr::JunctionLaneLink Blank<odr::JunctionLaneLink>()
+        {
+            return odr::JunctionLaneLink(0, 0);
+        }
+        template<>
+        odr::JunctionPriority Blank<odr::JunctionPriority>()
+        {
+            return odr::JunctionPriority("", "");
+        }
+        template<>
+        odr::JunctionController Blank<odr::JunctionController>()
+        {
+            return odr::JunctionController("", "", 0);
+        }
+        template<>
+        odr::Lane Blank<odr::Lane>()
+        {
+            return odr::Lane("", 0, 0, false, "");
+        }
+        template<>
+        odr::HeightOffset Blank<odr::HeightOffset>()
+        {
+            return odr::HeightOffset(0, 0);
+        }
+        template<>
+        odr::RoadMarkGroup Blank<odr::RoadMarkGroup>()
+        {
+            return odr::RoadMarkGroup("", 0, 0, 0, 0, 0, "", "", "", "", "");
+        }
+        template<>
+        odr::RoadMarksLine Blank<odr::RoadMarksLine>()
+        {
+            return odr::RoadMarksLine("", 0, 0, 0, 0, 0, 0, 0, 0, "", "");
+        }
+        template<>
+        odr::RoadNeighbor Blank<odr::RoadNeighbor>()
+        {
+            return odr::RoadNeighbor("", "", "");
+        }
+        template<>
+        odr::SpeedRecord Blank<odr::SpeedRecord>()
+        {
+            return odr::SpeedRecord("", "");
+        }
+        template<>
+        odr::RoadObject Blank<odr::RoadObject>()
+        {
+            return odr::RoadObject("", "", 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, "", "", "", "", false);
+        }
+        template<>
+        odr::RoadObjectRepeat Blank<odr::RoadObjectRepeat>()
+        {
+            return odr::RoadObjectRepeat(0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0);
+        }
+        template<>
+        odr::RoadObjectOutline Blank<odr::RoadObjectOutline>()
+        {
+            return odr::RoadObjectOutline(0, "", "", true, true);
+        }
+        template<>
+        odr::RoadObjectCorner Blank<odr::RoadObjectCorner>()
+        {
+            return odr::RoadObjectCorner(0, odr::Vec3D{0, 0, 0}, 0, odr::RoadObjectCorner::Type_Road);
+        }
+        template<>
+        odr::RoadSignal Blank<odr::RoadSignal>()
+        {
+            return odr::RoadSignal("", "", "", 0, 0, false, 0, 0, 0, 0, 0, 0, 0, "", "", "", "", "", "");
+        }
+        template<>
+        odr::LaneValidityRecord Blank<odr::LaneValidityRecord>()
+        {
+            return odr::LaneValidityRecord(0, 0);
+        }
+    }
+
+    // Nested in MapSnapshot to share its friendship with LaneProfile
+    struct MapSnapshot::Archiver
+    {
+        using OArchive = cereal::BinaryOutputArchive;
+        using IArchive = cereal::BinaryInputArchive;
+
+        template<class T>
+        static typename std::enable_if<std::is_arithmetic<T>::value || std::is_enum<T>::value>::type Write(OArchive& ar, const T& v)
+        {
+            ar(v);
+        }
+        template<class T>
+        static typename std::enable_if<std::is_arithmetic<T>::value || std::is_enum<T>::value>::type Read(IArchive& ar, T& v)
+        {
+            ar(v);
+        }
+
+        static void Write(OArchive& ar, const std::string& v) { ar(v); }
+        static void Read(IArchive& ar, std::string& v) { ar(v); }
+
+        template<class A, class B>
+        static void Write(OArchive& ar, const std::pair<A, B>& v)
+        {
+            Write(ar, v.first);
+            Write(ar, v.second);
+        }
+        template<class A, class B>
+        static void Read(IArchive& ar, std::pair<A, B>& v)
+        {
+            Read(ar, v.first);
+            Read(ar, v.second);
+        }
+
+        template<class T, std::size_t N>
+        static void Write(OArchive& ar, const std::array<T, N>& v)
+        {
+            for (const auto& e : v)
+                Write(ar, e);
+        }
+        template<class T, std::size_t N>
+        static void Read(IArchive& ar, std::array<T, N>& v)
+        {
+            for (auto& e : v)
+                Read(ar, e);
+        }
+
+        template<class K, class V, class C>
+        static void Write(OArchive& ar, const std::map<K, V, C>& m)
+        {
+            ar(cereal::make_size_tag(static_cast<cereal::size_type>(m.size())));
+            for (const auto& kv : m)
+            {
+                Write(ar, kv.first);
+                Write(ar, kv.second);
+            }
+        }
+        template<class K, class V, class C>
+        static void Read(IArchive& ar, std::map<K, V, C>& m)
+        {
+            cereal::size_type n;
+            ar(cereal::make_size_tag(n));
+            m.clear();
+            for (cereal::size_type i = 0; i < n; i++)
+            {
+                K k = Blank<K>();
+                Read(ar, k);
+                V v = Blank<V>();
+                Read(ar, v);
+                m.emplace(std::move(k), std::move(v));
+            }
+        }
+
+        template<class T, class C>
+        static void Write(OArchive& ar, const std::set<T, C>& s)
+        {
+            ar(cereal::make_size_tag(static_cast<cereal::size_type>(s.size())));
+            for (const auto& e : s)
+                Write(ar, e);
+        }
+        template<class T, class C>
+        static void Read(IArchive& ar, std::set<T, C>& s)
+        {
+            cereal::size_type n;
+            ar(cereal::make_size_tag(n));
+            s.clear();
+            for (cereal::size_type i = 0; i < n; i++)
+            {
+                T e = Blank<T>();
+                Read(ar, e);
+                s.insert(std::move(e));
+            }
+        }
+
+        template<class T>
+        static void Write(OArchive& ar, const std::vector<T>& vec)
+        {
+            ar(cereal::make_size_tag(static_cast<cereal::size_type>(vec.size())));
+            for (const auto& e : vec)
+                Write(ar, e);
+        }
+        template<class T>
+        static void Read(IArchive& ar, std::vector<T>& vec)
+        {
+            cereal::size_type n;
+            ar(cereal::make_size_tag(n));
+            vec.clear();
+            vec.reserve(n);
+            for (cereal::size_type i = 0; i < n; i++)
+            {
+                T e = Blank<T>();
+                Read(ar, e);
+                vec.push_back(std::move(e));
+            }
+        }
+
+        // Geometry & splines
+        static void Write(OArchive& ar, const odr::Poly3& p) { ar(p.a, p.b, p.c, p.d, p.raw_a, p.raw_b, p.raw_c, p.raw_d); }
+        static void Read(IArchive& ar, odr::Poly3& p) { ar(p.a, p.b, p.c, p.d, p.raw_a, p.raw_b, p.raw_c, p.raw_d); }
+
+        static void Write(OArchive& ar, const odr::CubicSpline& spline) { Write(ar, spline.s0_to_poly); }
+        static void Read(IArchive& ar, odr::CubicSpline& spline) { Read(ar, spline.s0_to_poly); }
+
+        static void Write(OArchive& ar, const odr::Crossfall& crossfall)
+        {
+            Write(ar, static_cast<const odr::CubicSpline&>(crossfall));
+            Write(ar, crossfall.sides);
+        }
+        static void Read(IArchive& ar, odr::Crossfall& crossfall)
+        {
+            Read(ar, static_cast<odr::CubicSpline&>(crossfall));
+            Read(ar, crossfall.sides);
+        }
+
+        // Geometries are rebuilt through their constructors, same as parsing the exported xodr
+        static void Write(OArchive& ar, const std::unique_ptr<odr::RoadGeometry>& geometry)
+        {
+            ar(geometry->type, geometry->s0, geometry->x0, geometry->y0, geometry->hdg0, geometry->length);
+            switch (geometry->type)
+            {
+            case odr::GeometryType_Arc:
+                ar(static_cast<const odr::Arc*>(geometry.get())->curvature);
+                break;
+            case odr::GeometryType_Spiral:
+            {
+                auto spiral = static_cast<const odr::Spiral*>(geometry.get());
+                ar(spiral->curv_start, spiral->curv_end);
+                break;
+            }
+            case odr::GeometryType_ParamPoly3:
+            {
+                auto poly = static_cast<const odr::ParamPoly3*>(geometry.get());
+                ar(poly->aU, poly->bU, poly->cU, poly->dU, poly->aV, poly->bV, poly->cV, poly->dV, poly->pRange_normalized);
+                break;
+            }
+            default:
+                break;
+            }
+        }
+        static void Read(IArchive& ar, std::unique_ptr<odr::RoadGeometry>& geometry)
+        {
+            odr::GeometryType type;
+            double       s0, x0, y0, hdg0, length;
+            ar(type, s0, x0, y0, hdg0, length);
+            switch (type)
+            {
+            case odr::GeometryType_Line:
+                geometry = std::make_unique<odr::Line>(s0, x0, y0, hdg0, length);
+                break;
+            case odr::GeometryType_Arc:
+            {
+                double curvature;
+                ar(curvature);
+                geometry = std::make_unique<odr::Arc>(s0, x0, y0, hdg0, length, curvature);
+                break;
+            }
+            case odr::GeometryType_Spiral:
+            {
+                double curv_start, curv_end;
+                ar(curv_start, curv_end);
+                geometry = std::make_unique<odr::Spiral>(s0, x0, y0, hdg0, length, curv_start, curv_end);
+                break;
+            }
+            case odr::GeometryType_ParamPoly3:
+            {
+                double aU, bU, cU, dU, aV, bV, cV, dV;
+                bool   pRange_normalized;
+                ar(aU, bU, cU, dU, aV, bV, cV, dV, pRange_normalized);
+                geometry = std::make_unique<odr::ParamPoly3>(s0, x0, y0, hdg0, length, aU, bU, cU, dU, aV, bV, cV, dV, pRange_normalized);
+                break;
+            }
+            default:
+                throw std::runtime_error("MapSnapshot: unknown geometry type");
+            }
+        }
+
+        static void Write(OArchive& ar, const odr::RefLine& ref_line)
+        {
+            ar(ref_line.road_id, ref_line.length);
+            Write(ar, ref_line.elevation_profile);
+            Write(ar, ref_line.s0_to_geometry);
+        }
+        static void Read(IArchive& ar, odr::RefLine& ref_line)
+        {
+            ar(ref_line.road_id, ref_line.length);
+            Read(ar, ref_line.elevation_profile);
+            Read(ar, ref_line.s0_to_geometry);
+        }
+
+        // Lanes
+        static void Write(OArchive& ar, const odr::HeightOffset& h) { ar(h.inner, h.outer); }
+        static void Read(IArchive& ar, odr::HeightOffset& h) { ar(h.inner, h.outer); }
+
+        static void Write(OArchive& ar, const odr::RoadMarksLine& l)
+        {
+            ar(l.road_id, l.lanesection_s0, l.lane_id, l.group_s0, l.width, l.length, l.space, l.t_offset, l.s_offset, l.name, l.rule);
+        }
+        static void Read(IArchive& ar, odr::RoadMarksLine& l)
+        {
+            ar(l.road_id, l.lanesection_s0, l.lane_id, l.group_s0, l.width, l.length, l.space, l.t_offset, l.s_offset, l.name, l.rule);
+        }
+
+        static void Write(OArchive& ar, const odr::RoadMarkGroup& g)
+        {
+            ar(g.road_id, g.lanesection_s0, g.lane_id, g.width, g.height, g.s_offset, g.type, g.weight, g.color, g.material, g.lane_change);
+            Write(ar, g.roadmark_lines);
+        }
+        static void Read(IArchive& ar, odr::RoadMarkGroup& g)
+        {
+            ar(g.road_id, g.lanesection_s0, g.lane_id, g.width, g.height, g.s_offset, g.type, g.weight, g.color, g.material, g.lane_change);
+            Read(ar, g.roadmark_lines);
+        }
+
+        static void Write(OArchive& ar, const odr::Lane& lane)
+        {
+            ar(lane.key.road_id, lane.key.lanesection_s0, lane.key.lane_id);
+            ar(lane.id, lane.level, lane.predecessor, lane.successor, lane.type);
+            Write(ar, lane.lane_width);
+            Write(ar, lane.outer_border);
+            Write(ar, lane.inner_border);
+            Write(ar, lane.s_to_height_offset);
+            Write(ar, lane.roadmark_groups);
+        }
+        static void Read(IArchive& ar, odr::Lane& lane)
+        {
+            ar(lane.key.road_id, lane.key.lanesection_s0, lane.key.lane_id);
+            ar(lane.id, lane.level, lane.predecessor, lane.successor, lane.type);
+            Read(ar, lane.lane_width);
+            Read(ar, lane.outer_border);
+            Read(ar, lane.inner_border);
+            Read(ar, lane.s_to_height_offset);
+            Read(ar, lane.roadmark_groups);
+        }
+
+        static void Write(OArchive& ar, const odr::LaneSection& section)
+        {
+            ar(section.road_id, section.s0);
+            Write(ar, section.id_to_lane);
+        }
+        static void Read(IArchive& ar, odr::LaneSection& section)
+        {
+            ar(section.road_id, section.s0);
+            Read(ar, section.id_to_lane);
+        }
+
+        // Objects & signals
+        static void Write(OArchive& ar, const odr::LaneValidityRecord& v) { ar(v.from_lane, v.to_lane); }
+        static void Read(IArchive& ar, odr::LaneValidityRecord& v) { ar(v.from_lane, v.to_lane); }
+
+        static void Write(OArchive& ar, const odr::RoadObjectRepeat& r)
+        {
+            ar(r.s0, r.length, r.distance, r.t_start, r.t_end, r.width_start, r.width_end, r.height_start, r.height_end, r.z_offset_start, r.z_offset_end);
+        }
+        static void Read(IArchive& ar, odr::RoadObjectRepeat& r)
+        {
+            ar(r.s0, r.length, r.distance, r.t_start, r.t_end, r.width_start, r.width_end, r.height_start, r.height_end, r.z_offset_start, r.z_offset_end);
+        }
+
+        static void Write(OArchive& ar, const odr::RoadObjectCorner& c)
+        {
+            ar(c.id, c.height, c.type);
+            Write(ar, c.pt);
+        }
+        static void Read(IArchive& ar, odr::RoadObjectCorner& c)
+        {
+            ar(c.id, c.height, c.type);
+            Read(ar, c.pt);
+        }
+
+        static void Write(OArchive& ar, const odr::RoadObjectOutline& o)
+        {
+            ar(o.id, o.fill_type, o.lane_type, o.outer, o.closed);
+            Write(ar, o.outline);
+        }
+        static void Read(IArchive& ar, odr::RoadObjectOutline& o)
+        {
+            ar(o.id, o.fill_type, o.lane_type, o.outer, o.closed);
+            Read(ar, o.outline);
+        }
+
+        static void Write(OArchive& ar, const odr::RoadObject& o)
+        {
+            ar(o.road_id, o.id, o.type, o.name, o.orientation, o.subtype);
+            ar(o.s0, o.t0, o.z0, o.length, o.valid_length, o.width, o.radius, o.height, o.hdg, o.pitch, o.roll, o.is_dynamic);
+            Write(ar, o.repeats);
+            Write(ar, o.outlines);
+            Write(ar, o.lane_validities);
+        }
+        static void Read(IArchive& ar, odr::RoadObject& o)
+        {
+            ar(o.road_id, o.id, o.type, o.name, o.orientation, o.subtype);
+            ar(o.s0, o.t0, o.z0, o.length, o.valid_length, o.width, o.radius, o.height, o.hdg, o.pitch, o.roll, o.is_dynamic);
+            Read(ar, o.repeats);
+            Read(ar, o.outlines);
+            Read(ar, o.lane_validities);
+        }
+
+        static void Write(OArchive& ar, const odr::RoadSignal& s)
+        {
+            ar(s.road_id, s.id, s.name, s.s0, s.t0, s.is_dynamic, s.zOffset, s.value, s.height, s.width, s.hOffset, s.pitch, s.roll);
+            ar(s.orientation, s.country, s.type, s.subtype, s.unit, s.text);
+            Write(ar, s.lane_validities);
+        }
+        static void Read(IArchive& ar, odr::RoadSignal& s)
+        {
+            ar(s.road_id, s.id, s.name, s.s0, s.t0, s.is_dynamic, s.zOffset, s.value, s.height, s.width, s.hOffset, s.pitch, s.roll);
+            ar(s.orientation, s.country, s.type, s.subtype, s.unit, s.text);
+            Read(ar, s.lane_validities);
+        }
+
+        // Road
+        static void Write(OArchive& ar, const LanePlan& plan) { ar(plan.offsetx2, plan.laneCount); }
+        static void Read(IArchive& ar, LanePlan& plan) { ar(plan.offsetx2, plan.laneCount); }
+
+        static void Write(OArchive& ar, const LaneProfile& profile)
+        {
+            Write(ar, profile.leftPlans);
+            Write(ar, profile.rightPlans);
+        }
+        static void Read(IArchive& ar, LaneProfile& profile)
+        {
+            Read(ar, profile.leftPlans);
+            Read(ar, profile.rightPlans);
+        }
+
+        static void Write(OArchive& ar, const odr::RoadLink& link) { ar(link.id, link.type, link.contact_point); }
+        static void Read(IArchive& ar, odr::RoadLink& link) { ar(link.id, link.type, link.contact_point); }
+
+        static void Write(OArchive& ar, const odr::RoadNeighbor& n) { ar(n.id, n.side, n.direction); }
+        static void Read(IArchive& ar, odr::RoadNeighbor& n) { ar(n.id, n.side, n.direction); }
+
+        static void Write(OArchive& ar, const odr::SpeedRecord& r) { ar(r.max, r.unit); }
+        static void Read(IArchive& ar, odr::SpeedRecord& r) { ar(r.max, r.unit); }
+
+        static void Write(OArchive& ar, const odr::Road& road)
+        {
+            ar(road.length, road.id, road.junction, road.name, road.left_hand_traffic);
+            Write(ar, road.predecessor);
+            Write(ar, road.successor);
+            Write(ar, road.neighbors);
+            Write(ar, road.lane_offset);
+            Write(ar, road.superelevation);
+            Write(ar, road.crossfall);
+            Write(ar, road.ref_line);
+            Write(ar, road.s_to_lanesection);
+            Write(ar, road.s_to_type);
+            Write(ar, road.s_to_speed);
+            Write(ar, road.id_to_object);
+            Write(ar, road.id_to_signal);
+            Write(ar, road.rr_profile);
+            Write(ar, road.boundaryHide);
+        }
+        static void Read(IArchive& ar, odr::Road& road)
+        {
+            ar(road.length, road.id, road.junction, road.name, road.left_hand_traffic);
+            Read(ar, road.predecessor);
+            Read(ar, road.successor);
+            Read(ar, road.neighbors);
+            Read(ar, road.lane_offset);
+            Read(ar, road.superelevation);
+            Read(ar, road.crossfall);
+            Read(ar, road.ref_line);
+            Read(ar, road.s_to_lanesection);
+            Read(ar, road.s_to_type);
+            Read(ar, road.s_to_speed);
+            Read(ar, road.id_to_object);
+            Read(ar, road.id_to_signal);
+            Read(ar, road.rr_profile);
+            Read(ar, road.boundaryHide);
+        }
+
+        // Junction
+        static void Write(OArchive& ar, const odr::JunctionLaneLink& l) { ar(l.from, l.to, l.overlapZone); }
+        static void Read(IArchive& ar, odr::JunctionLaneLink& l) { ar(l.from, l.to, l.overlapZone); }
+
+        static void Write(OArchive& ar, const odr::JunctionConnection& c)
+        {
+            ar(c.id, c.incoming_road, c.connecting_road, c.contact_point, c.interface_provider_contact);
+            Write(ar, c.lane_links);
+            Write(ar, c.signalPhases);
+        }
+        static void Read(IArchive& ar, odr::JunctionConnection& c)
+        {
+            ar(c.id, c.incoming_road, c.connecting_road, c.contact_point, c.interface_provider_contact);
+            Read(ar, c.lane_links);
+            Read(ar, c.signalPhases);
+        }
+
+        static void Write(OArchive& ar, const odr::JunctionPriority& p) { ar(p.high, p.low); }
+        static void Read(IArchive& ar, odr::JunctionPriority& p) { ar(p.high, p.low); }
+
+        static void Write(OArchive& ar, const odr::JunctionController& c) { ar(c.id, c.type, c.sequence); }
+        static void Read(IArchive& ar, odr::JunctionController& c) { ar(c.id, c.type, c.sequence); }
+
+        static void Write(OArchive& ar, const odr::BoundarySegment& b) { ar(b.road, b.side, b.sBegin, b.sEnd, b.type); }
+        static void Read(IArchive& ar, odr::BoundarySegment& b) { ar(b.road, b.side, b.sBegin, b.sEnd, b.type); }
+
+        static void Write(OArchive& ar, const odr::Junction& junction)
+        {
+            ar(junction.name, junction.id, junction.type);
+            Write(ar, junction.id_to_connection);
+            Write(ar, junction.id_to_controller);
+            Write(ar, junction.priorities);
+            Write(ar, junction.boundary);
+        }
+        static void Read(IArchive& ar, odr::Junction& junction)
+        {
+            ar(junction.name, junction.id, junction.type);
+            Read(ar, junction.id_to_connection);
+            Read(ar, junction.id_to_controller);
+            Read(ar, junction.priorities);
+            Read(ar, junction.boundary);
+        }
+    };
+
+    std::string MapSnapshot::PathFor(const std::string& xodrPath)
+    {
+        return xodrPath + ".lmsnap";
+    }
+
+    uint64_t MapSnapshot::SourceHash(const std::string& xodrContent)
+    {
+        // FNV-1a: stable across platforms and runs, unlike std::hash
+        uint64_t hash = 14695981039346656037ull;
+        for (const char c : xodrContent)
+        {
+            hash ^= static_cast<unsigned char>(c);
+            hash *= 1099511628211ull;
+        }
+        return hash;
+    }
+
+    bool MapSnapshot::Save(const odr::OpenDriveMap& map, const std::string& path, uint64_t sourceHash, bool supported)
+    {
+        // Written aside then renamed, so an interrupted save never leaves a truncated snapshot behind
+        const auto tmpPath = path + ".tmp";
+        {
+            std::ofstream outFile(tmpPath, std::ios::binary);
+            if (!outFile)
+            {
+                spdlog::warn("Snapshot {} not writable", tmpPath);
+                return false;
+            }
+
+            try
+            {
+                cereal::BinaryOutputArchive ar(outFile);
+                ar(std::string(SnapshotMagic), SnapshotVersion, sourceHash, supported);
+                ar(map.proj4, map.x_offs, map.y_offs);
+                Archiver::Write(ar, map.id_to_road);
+                Archiver::Write(ar, map.id_to_junction);
+            }
+            catch (const std::exception& e)
+            {
+                spdlog::warn("Snapshot {} not saved: {}", path, e.what());
+                outFile.close();
+                std::remove(tmpPath.c_str());
+                return false;
+            }
+
+            outFile.close();
+            if (!outFile)
+            {
+                spdlog::warn("Snapshot {} not saved: write failed", path);
+                std::remove(tmpPath.c_str());
+                return false;
+            }
+        }
+
+        std::error_code ec;
+        std::filesystem::rename(tmpPath, path, ec);
+        if (ec)
+        {
+            spdlog::warn("Snapshot {} not saved: {}", path, ec.message());
+            std::remove(tmpPath.c_str());
+            return false;
+        }
+        return true;
+    }
+
+    bool MapSnapshot::Load(odr::OpenDriveMap& map, const std::string& path, uint64_t sourceHash, bool& supported)
+    {
+        map.id_to_road.clear();
+        map.id_to_junction.clear();
+
+        std::ifstream inFile(path, std::ios::binary);
+        if (!inFile)
+        {
+            return false;
+        }
+
+        try
+        {
+            cereal::BinaryInputArchive ar(inFile);
+            std::string magic;
+            uint32_t version;
+            uint64_t snapshotHash;
+            ar(magic, version, snapshotHash, supported);
+            if (magic != SnapshotMagic || version != SnapshotVersion || snapshotHash != sourceHash)
+            {
+                spdlog::info("Snapshot {} is outdated", path);
+                return false;
+            }
+
+            map.xml_doc.reset();
+            ar(map.proj4, map.x_offs, map.y_offs);
+            Archiver::Read(ar, map.id_to_road);
+            Archiver::Read(ar, map.id_to_junction);
+        }
+        catch (const std::exception& e)
+        {
+            spdlog::warn("Snapshot {} unreadable: {}", path, e.what());
+            map.id_to_road.clear();
+            map.id_to_junction.clear();
+            return false;
+        }
+        return true;
+    }
+}
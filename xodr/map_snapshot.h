@@ -0,0 +1,28 @@
+#pragma once
+
+#include "OpenDriveMap.h"
+
+#include <cstdint>
+#include <string>
+
+namespace LM
+{
+    // Versioned binary copy of a parsed odr::OpenDriveMap, stored next to its .xodr.
+    // A snapshot is only accepted if it was built from a source of identical hash.
+    class MapSnapshot
+    {
+    public:
+        static std::string PathFor(const std::string& xodrPath);
+
+        static uint64_t SourceHash(const std::string& xodrContent);
+
+        /*Best effort: returns false and leaves any previous snapshot in place on failure*/
+        static bool Save(const odr::OpenDriveMap&, const std::string& path, uint64_t sourceHash, bool supported);
+
+        /*Returns false if snapshot is missing, outdated or unreadable; map is left empty in that case*/
+        static bool Load(odr::OpenDriveMap&, const std::string& path, uint64_t sourceHash, bool& supported);
+
+    private:
+        struct Archiver;
+    };
+}
@@ -0,0 +1,161 @@
+#include "map_tiles.h"
+#include "constants.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace LM
+{
+    namespace
+    {
+        const std::set<std::string> NoIDs;
+    }
+
+    void MapTiles::Build(const odr::OpenDriveMap& map)
+    {
+        Clear();
+        for (const auto& id2Road : map.id_to_road)
+        {
+            add(id2Road.second);
+        }
+    }
+
+    void MapTiles::Update(const odr::OpenDriveMap& map, const std::set<std::string>& roadIDs)
+    {
+        for (const auto& id : roadIDs)
+        {
+            remove(id);
+            auto roadIt = map.id_to_road.find(id);
+            if (roadIt != map.id_to_road.end())
+            {
+                add(roadIt->second);
+            }
+        }
+    }
+
+    void MapTiles::Clear()
+    {
+        tileToRoads.clear();
+        roadToTiles.clear();
+        junctionToRoads.clear();
+        roadToJunctions.clear();
+    }
+
+    bool MapTiles::Empty() const
+    {
+        return roadToTiles.empty();
+    }
+
+    MapTiles::TileKey MapTiles::TileAt(double x, double y)
+    {
+        return TileKey(static_cast<int>(std::floor(x / MapTileSize)), static_cast<int>(std::floor(y / MapTileSize)));
+    }
+
+    std::set<std::string> MapTiles::RoadsAround(TileKey center, int radius) const
+    {
+        std::set<std::string> rtn;
+        for (int x = center.first - radius; x <= center.first + radius; ++x)
+        {
+            for (int y = center.second - radius; y <= center.second + radius; ++y)
+            {
+                auto tileIt = tileToRoads.find(TileKey(x, y));
+                if (tileIt != tileToRoads.end())
+                {
+                    rtn.insert(tileIt->second.begin(), tileIt->second.end());
+                }
+            }
+        }
+        return rtn;
+    }
+
+    const std::set<std::string>& MapTiles::JunctionRoads(const std::string& junctionID) const
+    {
+        auto it = junctionToRoads.find(junctionID);
+        return it == junctionToRoads.end() ? NoIDs : it->second;
+    }
+
+    const std::set<std::string>& MapTiles::RoadJunctions(const std::string& roadID) const
+    {
+        auto it = roadToJunctions.find(roadID);
+        return it == roadToJunctions.end() ? NoIDs : it->second;
+    }
+
+    void MapTiles::add(const odr::Road& road)
+    {
+        if (road.junction != "-1")
+        {
+            // Connecting roads come and go with their junction
+            return;
+        }
+
+        double minX = std::numeric_limits<double>::max(), minY = minX;
+        double maxX = std::numeric_limits<double>::lowest(), maxY = maxX;
+        for (double s : road.ref_line.approximate_linear(0.5, 0, road.ref_line.length))
+        {
+            auto p = road.ref_line.get_xyz(s);
+            minX = std::min(minX, p[0]);
+            minY = std::min(minY, p[1]);
+            maxX = std::max(maxX, p[0]);
+            maxY = std::max(maxY, p[1]);
+        }
+        if (minX > maxX)
+        {
+            return;
+        }
+
+        auto minTile = TileAt(minX, minY);
+        auto maxTile = TileAt(maxX, maxY);
+        auto& tiles = roadToTiles[road.id];
+        for (int x = minTile.first; x <= maxTile.first; ++x)
+        {
+            for (int y = minTile.second; y <= maxTile.second; ++y)
+            {
+                tiles.emplace_back(x, y);
+                tileToRoads[TileKey(x, y)].insert(road.id);
+            }
+        }
+
+        for (const auto& link : { road.predecessor, road.successor })
+        {
+            if (link.type == odr::RoadLink::Type_Junction && link.id != "-1")
+            {
+                roadToJunctions[road.id].insert(link.id);
+                junctionToRoads[link.id].insert(road.id);
+            }
+        }
+    }
+
+    void MapTiles::remove(const std::string& roadID)
+    {
+        auto tilesIt = roadToTiles.find(roadID);
+        if (tilesIt != roadToTiles.end())
+        {
+            for (const auto& tile : tilesIt->second)
+            {
+                auto tileIt = tileToRoads.find(tile);
+                tileIt->second.erase(roadID);
+                if (tileIt->second.empty())
+                {
+                    tileToRoads.erase(tileIt);
+                }
+            }
+            roadToTiles.erase(tilesIt);
+        }
+
+        auto junctionsIt = roadToJunctions.find(roadID);
+        if (junctionsIt != roadToJunctions.end())
+        {
+            for (const auto& junctionID : junctionsIt->second)
+            {
+                auto junctionIt = junctionToRoads.find(junctionID);
+                junctionIt->second.erase(roadID);
+                if (junctionIt->second.empty())
+                {
+                    junctionToRoads.erase(junctionIt);
+                }
+            }
+            roadToJunctions.erase(junctionsIt);
+        }
+    }
+}
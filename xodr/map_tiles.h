@@ -0,0 +1,50 @@
+#pragma once
+
+#include "OpenDriveMap.h"
+
+#include <map>
+#include <set>
+#include <string>
+#include <vector>
+
+namespace LM
+{
+    // Partitions the non-connecting roads of a map into square tiles by ref line bounding box,
+    // and keeps the road <-> junction adjacency needed to load a tile together with its junctions.
+    class MapTiles
+    {
+    public:
+        typedef std::pair<int, int> TileKey;
+
+        void Build(const odr::OpenDriveMap& map);
+
+        /*Re-reads given roads from map; roads no longer in map are dropped*/
+        void Update(const odr::OpenDriveMap& map, const std::set<std::string>& roadIDs);
+
+        void Clear();
+
+        bool Empty() const;
+
+        static TileKey TileAt(double x, double y);
+
+        /*Roads touching any tile within radius (in tiles) of center*/
+        std::set<std::string> RoadsAround(TileKey center, int radius) const;
+
+        /*Non-connecting roads linked to junction*/
+        const std::set<std::string>& JunctionRoads(const std::string& junctionID) const;
+
+        /*Junctions at either end of road*/
+        const std::set<std::string>& RoadJunctions(const std::string& roadID) const;
+
+    private:
+        void add(const odr::Road& road);
+
+        void remove(const std::string& roadID);
+
+        std::map<TileKey, std::set<std::string>> tileToRoads;
+        std::map<std::string, std::vector<TileKey>> roadToTiles;
+
+        std::map<std::string, std::set<std::string>> junctionToRoads;
+        std::map<std::string, std::set<std::string>> roadToJunctions;
+    };
+}
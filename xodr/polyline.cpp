@@ -1,171 +1,263 @@
 #include "polyline.h"
 
-#include <CGAL/Exact_predicates_exact_constructions_kernel.h>
-#include <CGAL/Arr_non_caching_segment_traits_2.h>
-#include <CGAL/Arrangement_with_history_2.h>
-#include <spdlog/spdlog.h>
-
-typedef CGAL::Exact_predicates_exact_constructions_kernel Kernel;
-typedef CGAL::Arr_non_caching_segment_traits_2<Kernel>  Traits_2;
-typedef Traits_2::Point_2                               Point;
-typedef Traits_2::X_monotone_curve_2                    Segment;
-typedef CGAL::Arrangement_with_history_2<Traits_2>      Arrangement;
-typedef Arrangement::Halfedge_around_vertex_circulator  Halfedge_circulator;
-typedef Kernel::FT                                      FT;
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <vector>
 
-namespace LM
+namespace
 {
-    std::string Serialize(Point p)
+    struct BorderSegment
     {
-        std::string rtn = p.exact().x().get_str();
-        rtn += p.exact().y().get_str();
-        return rtn;
+        odr::Vec2D p1, p2;
+        double s1, s2;
+        double minX, maxX, minY, maxY;
+        bool onA;
+    };
+
+    struct BorderSample
+    {
+        double x, y, s;
+
+        bool operator<(const BorderSample& other) const
+        {
+            return x < other.x || (x == other.x && y < other.y);
+        }
+    };
+
+    // a + b == sum + err exactly
+    inline void twoSum(double a, double b, double& sum, double& err)
+    {
+        sum = a + b;
+        double bVirtual = sum - a;
+        double aVirtual = sum - bVirtual;
+        err = (a - aVirtual) + (b - bVirtual);
     }
 
-    std::string Serialize(Segment s)
+    // a - b == diff + err exactly
+    inline void twoDiff(double a, double b, double& diff, double& err)
     {
-        std::string rtn = Serialize(s.start());
-        rtn += Serialize(s.end());
-        return rtn;
+        diff = a - b;
+        double bVirtual = a - diff;
+        double aVirtual = diff + bVirtual;
+        err = (a - aVirtual) + (bVirtual - b);
     }
 
-    std::map<std::string, double> addToArrangement(Arrangement& arrangement, const odr::Road& road, const int side,
-        const odr::RoadLink::ContactPoint searchBegin, const double SearchLimit)
+    /*Sign of (ax - cx) * (by - cy) - (ay - cy) * (bx - cx) without rounding.
+    * Expands every difference and product into exact double pairs,
+    * then grows a nonoverlapping expansion whose largest nonzero component carries the sign.
+    */
+    double orient2dExact(const odr::Vec2D& a, const odr::Vec2D& b, const odr::Vec2D& c)
+    {
+        double acx[2], acy[2], bcx[2], bcy[2];
+        twoDiff(a[0], c[0], acx[0], acx[1]);
+        twoDiff(a[1], c[1], acy[0], acy[1]);
+        twoDiff(b[0], c[0], bcx[0], bcx[1]);
+        twoDiff(b[1], c[1], bcy[0], bcy[1]);
+
+        double expansion[16];
+        int nComponent = 0;
+        auto grow = [&](double term)
+        {
+            for (int i = 0; i != nComponent; ++i)
+            {
+                twoSum(term, expansion[i], term, expansion[i]);
+            }
+            expansion[nComponent++] = term;
+        };
+        auto growProduct = [&](double u, double v, double sign)
+        {
+            double product = u * v;
+            grow(sign * product);
+            grow(sign * std::fma(u, v, -product));
+        };
+
+        for (int i = 0; i != 2; ++i)
+        {
+            for (int j = 0; j != 2; ++j)
+            {
+                growProduct(acx[i], bcy[j], 1);
+                growProduct(acy[i], bcx[j], -1);
+            }
+        }
+
+        for (int i = nComponent - 1; i >= 0; --i)
+        {
+            if (expansion[i] != 0)
+            {
+                return expansion[i];
+            }
+        }
+        return 0;
+    }
+
+    // Positive if c is left of a->b. Float value when its sign is certain, otherwise exact sign.
+    double orient2d(const odr::Vec2D& a, const odr::Vec2D& b, const odr::Vec2D& c)
+    {
+        const double Epsilon = std::numeric_limits<double>::epsilon() / 2;
+        const double ErrorBound = (3.0 + 16.0 * Epsilon) * Epsilon;
+
+        double detLeft = (a[0] - c[0]) * (b[1] - c[1]);
+        double detRight = (a[1] - c[1]) * (b[0] - c[0]);
+        double det = detLeft - detRight;
+        if (std::abs(det) >= ErrorBound * (std::abs(detLeft) + std::abs(detRight)))
+        {
+            return det;
+        }
+        return orient2dExact(a, b, c);
+    }
+
+    inline int signOf(double v)
+    {
+        return (v > 0) - (v < 0);
+    }
+
+    // Samples every Resolution from searchBegin, as far as SearchLimit
+    void sampleBorder(const odr::Road& road, const int side,
+        const odr::RoadLink::ContactPoint searchBegin, const double SearchLimit, const bool onA,
+        std::vector<BorderSegment>& segments, std::vector<BorderSample>& samples)
     {
         const double Resolution = 1.0;
 
-        std::map<std::string, double> pointToS;
         double searchBeginS = searchBegin == odr::RoadLink::ContactPoint_End ? road.length : 0;
         double searchStep = searchBegin == odr::RoadLink::ContactPoint_End ? -Resolution : Resolution;
 
+        odr::Vec2D p1 = road.get_boundary_xy(side, searchBeginS);
         for (double s1 = searchBeginS, s2 = searchBeginS + searchStep;
             0 <= s1 && s1 <= road.length && 0 <= s2 && s2 <= road.length &&
             std::abs(s1 - searchBeginS) < SearchLimit &&
             std::abs(s2 - searchBeginS) < SearchLimit
             ; s1 += searchStep, s2 += searchStep)
         {
-            auto p1 = road.get_boundary_xy(side, s1);
             auto p2 = road.get_boundary_xy(side, s2);
-            Point point1(p1[0], p1[1]);
-            Point point2(p2[0], p2[1]);
-            Segment segment(point1, point2);
-            pointToS.emplace(Serialize(point1), s1);
-            pointToS.emplace(Serialize(point2), s2);
-            CGAL::insert(arrangement, segment);
+            if (samples.empty() || samples.back().s != s1)
+            {
+                samples.push_back(BorderSample{ p1[0], p1[1], s1 });
+            }
+            samples.push_back(BorderSample{ p2[0], p2[1], s2 });
+            segments.push_back(BorderSegment{ p1, p2, s1, s2,
+                std::min(p1[0], p2[0]), std::max(p1[0], p2[0]),
+                std::min(p1[1], p2[1]), std::max(p1[1], p2[1]), onA });
+            p1 = p2;
+        }
+    }
+
+    // Where a and b meet, as fraction along each. False if apart or collinear.
+    bool segmentsIntersect(const BorderSegment& a, const BorderSegment& b, double& outTA, double& outTB)
+    {
+        double oB1 = orient2d(a.p1, a.p2, b.p1);
+        double oB2 = orient2d(a.p1, a.p2, b.p2);
+        if (signOf(oB1) * signOf(oB2) > 0)
+        {
+            return false;
+        }
+        double oA1 = orient2d(b.p1, b.p2, a.p1);
+        double oA2 = orient2d(b.p1, b.p2, a.p2);
+        if (signOf(oA1) * signOf(oA2) > 0)
+        {
+            return false;
+        }
+        if (oA1 == 0 && oA2 == 0)
+        {
+            return false;
         }
 
-        return pointToS;
+        outTA = std::clamp(oA1 / (oA1 - oA2), 0.0, 1.0);
+        outTB = std::clamp(oB1 / (oB1 - oB2), 0.0, 1.0);
+        return true;
     }
+}
 
+namespace LM
+{
     bool borderIntersect(const odr::Road& roadA, const int sideA,
         const odr::Road& roadB, const int sideB, double& outSA, double& outSB,
         const odr::RoadLink::ContactPoint searchBeginA,
         const odr::RoadLink::ContactPoint searchBeginB,
         const double SearchLimit)
     {
-        Arrangement arrangement;
-        std::map<std::string, double> pointAToS = addToArrangement(arrangement, roadA, sideA, searchBeginA, SearchLimit);
-        std::map<std::string, double> pointBToS = addToArrangement(arrangement, roadB, sideB, searchBeginB, SearchLimit);
+        std::vector<BorderSegment> segments;
+        std::vector<BorderSample> samplesA, samplesB;
+        sampleBorder(roadA, sideA, searchBeginA, SearchLimit, true, segments, samplesA);
+        sampleBorder(roadB, sideB, searchBeginB, SearchLimit, false, segments, samplesB);
 
-        outSA = searchBeginA == odr::RoadLink::ContactPoint_End ? -1e9 : 1e9;
-        outSB = searchBeginB == odr::RoadLink::ContactPoint_End ? -1e9 : 1e9;
-        bool iFound = false;
-        // special case A: sample vertice overlap
-        for (auto key : pointAToS)
+        const bool reverseA = searchBeginA == odr::RoadLink::ContactPoint_End;
+        const bool reverseB = searchBeginB == odr::RoadLink::ContactPoint_End;
+        outSA = reverseA ? -1e9 : 1e9;
+        outSB = reverseB ? -1e9 : 1e9;
+
+        // special case: sample vertice overlap. Take the one reached first along A.
+        std::sort(samplesB.begin(), samplesB.end());
+        for (const auto& sampleA : samplesA)
         {
-            if (pointBToS.find(key.first) != pointBToS.end())
-            {
-                iFound = true;
-                auto candSA = key.second;
-                auto candSB = pointBToS.at(key.first);
-                outSA = searchBeginA == odr::RoadLink::ContactPoint_End ? std::max(outSA, candSA) : std::min(outSA, candSA);
-                outSB = searchBeginB == odr::RoadLink::ContactPoint_End ? std::max(outSB, candSB) : std::min(outSB, candSB);
-            }
-            if (iFound)
+            auto sampleB = std::lower_bound(samplesB.begin(), samplesB.end(), sampleA);
+            if (sampleB != samplesB.end() && sampleB->x == sampleA.x && sampleB->y == sampleA.y)
             {
+                outSA = sampleA.s;
+                outSB = sampleB->s;
                 return true;
             }
         }
 
-        for (auto vIt = arrangement.vertices_begin(); vIt != arrangement.vertices_end(); ++vIt)
-        {
-            if (vIt->degree() <= 2)
-            {
-                continue;
-            }
-            std::vector<double> sMarksA, sMarksB;
-            std::vector<double> heLengthA, heLengthB;
-
-            auto vSer = Serialize(vIt->point());
-            if (pointAToS.find(vSer) != pointAToS.end())
-            {
-                // special case B
-                sMarksA.push_back(pointAToS.at(vSer));
-                heLengthA.push_back(0);
-            }
-            if (pointBToS.find(vSer) != pointBToS.end())
-            {
-                // special case B
-                sMarksB.push_back(pointBToS.at(vSer));
-                heLengthB.push_back(0);
-            }
+        // Sweep along x. Only pairs from different roads whose boxes overlap are tested.
+        std::sort(segments.begin(), segments.end(),
+            [](const BorderSegment& a, const BorderSegment& b) { return a.minX < b.minX; });
 
-            // Normal case
-            Halfedge_circulator start = vIt->incident_halfedges();
-            Halfedge_circulator circulator = start;
-            do
+        bool iFound = false;
+        std::vector<const BorderSegment*> activeA, activeB;
+        for (const auto& segment : segments)
+        {
+            auto& opposite = segment.onA ? activeB : activeA;
+            for (size_t i = 0; i < opposite.size();)
             {
-                FT squared_length = CGAL::squared_distance(circulator->source()->point(), circulator->target()->point());
-                double heLength = std::sqrt(CGAL::to_double(squared_length));
-
-                if (vIt != circulator->source())
+                const BorderSegment* other = opposite[i];
+                if (other->maxX < segment.minX)
                 {
-                    auto startSer = Serialize(circulator->source()->point());
-                    if (pointAToS.find(startSer) != pointAToS.end())
-                    {
-                        sMarksA.push_back(pointAToS.at(startSer));
-                        heLengthA.push_back(heLength);
-                    }
-                    if (pointBToS.find(startSer) != pointBToS.end())
-                    {
-                        sMarksB.push_back(pointBToS.at(startSer));
-                        heLengthB.push_back(heLength);
-                    }
+                    opposite[i] = opposite.back();
+                    opposite.pop_back();
+                    continue;
                 }
+                ++i;
 
-                if (vIt != circulator->target())
+                if (other->maxY < segment.minY || segment.maxY < other->minY)
                 {
-                    auto endSer = Serialize(circulator->target()->point());
-                    if (pointAToS.find(endSer) != pointAToS.end())
-                    {
-                        sMarksA.push_back(pointAToS.at(endSer));
-                        heLengthA.push_back(heLength);
-                    }
-                    if (pointBToS.find(endSer) != pointBToS.end())
-                    {
-                        sMarksB.push_back(pointBToS.at(endSer));
-                        heLengthB.push_back(heLength);
-                    }
+                    continue;
+                }
+                const BorderSegment& a = segment.onA ? segment : *other;
+                const BorderSegment& b = segment.onA ? *other : segment;
+                double tA, tB;
+                if (!segmentsIntersect(a, b, tA, tB))
+                {
+                    continue;
                 }
-                ++circulator;
-            } while (circulator != start);
-            if (sMarksA.size() != 2)
-            {
-                spdlog::trace("Road {} has self-intersection: {}", roadA.id, sMarksA.size());
-                continue;
-            }
-            if (sMarksB.size() != 2)
-            {
-                spdlog::trace("Road {} has self-intersection: {}", roadB.id, sMarksB.size());
-                continue;
-            }
 
-            iFound = true;
-            auto candSA = (sMarksA[0] * heLengthA[1] + sMarksA[1] * heLengthA[0]) / (heLengthA[0] + heLengthA[1]);
-            auto candSB = (sMarksB[0] * heLengthB[1] + sMarksB[1] * heLengthB[0]) / (heLengthB[0] + heLengthB[1]);
-            outSA = searchBeginA == odr::RoadLink::ContactPoint_End ? std::max(outSA, candSA) : std::min(outSA, candSA);
-            outSB = searchBeginB == odr::RoadLink::ContactPoint_End ? std::max(outSB, candSB) : std::min(outSB, candSB);
+                iFound = true;
+                auto candSA = a.s1 + (a.s2 - a.s1) * tA;
+                auto candSB = b.s1 + (b.s2 - b.s1) * tB;
+                outSA = reverseA ? std::max(outSA, candSA) : std::min(outSA, candSA);
+                outSB = reverseB ? std::max(outSB, candSB) : std::min(outSB, candSB);
+            }
+            (segment.onA ? activeA : activeB).push_back(&segment);
         }
         return iFound;
     }
+
+    BorderBox borderBoundingBox(const odr::Road& road, const int side,
+        const odr::RoadLink::ContactPoint searchBegin, const double SearchLimit)
+    {
+        std::vector<BorderSegment> segments;
+        std::vector<BorderSample> samples;
+        sampleBorder(road, side, searchBegin, SearchLimit, true, segments, samples);
+
+        const double Inf = std::numeric_limits<double>::infinity();
+        BorderBox rtn{ Inf, Inf, -Inf, -Inf };
+        for (const auto& sample : samples)
+        {
+            rtn.minX = std::min(rtn.minX, sample.x);
+            rtn.minY = std::min(rtn.minY, sample.y);
+            rtn.maxX = std::max(rtn.maxX, sample.x);
+            rtn.maxY = std::max(rtn.maxY, sample.y);
+        }
+        return rtn;
+    }
 }
@@ -7,4 +7,19 @@ namespace LM
         const odr::RoadLink::ContactPoint searchBeginA = odr::RoadLink::ContactPoint_None,
         const odr::RoadLink::ContactPoint searchBeginB = odr::RoadLink::ContactPoint_None,
         const double SearchLimit = 200.0);
+
+    struct BorderBox
+    {
+        double minX, minY, maxX, maxY;
+
+        bool Overlaps(const BorderBox& other) const
+        {
+            return minX <= other.maxX && other.minX <= maxX && minY <= other.maxY && other.minY <= maxY;
+        }
+    };
+
+    // Encloses every border sample borderIntersect takes with the same arguments
+    BorderBox borderBoundingBox(const odr::Road& road, const int side,
+        const odr::RoadLink::ContactPoint searchBegin = odr::RoadLink::ContactPoint_None,
+        const double SearchLimit = 200.0);
 }
\ No newline at end of file
@@ -21,7 +21,7 @@ namespace LM
 {
     bool Road::ClearingMap = false;
 
-    Road::Road(const LaneProfile& p, std::unique_ptr<odr::RoadGeometry> l) :
+    Road::Road(const LaneProfile& p, std::unique_ptr<odr::RoadGeometry> l, bool generateNow) :
         generated(IDGenerator::ForType(IDType::Road)->GenerateID(this), 0, "-1")
     {
         if (std::stoi(ID()) >= MaxRoadID)
@@ -31,7 +31,10 @@ namespace LM
         generated.rr_profile = p;
         generated.ref_line.length = l->length;
         generated.ref_line.s0_to_geometry.emplace(0, std::move(l));
-        Generate();
+        if (generateNow)
+        {
+            Generate();
+        }
     }
 
     Road::Road(const LaneProfile& p, odr::RefLine& l) :
@@ -54,11 +57,7 @@ namespace LM
 
     void Road::Generate(bool notifyJunctions)
     {
-        generated.length = Length();
-        generated.rr_profile.Apply(Length(), &generated);
-
-        generated.PlaceMarkings();
-        generated.DeriveLaneBorders();
+        GenerateLanes();
 
         IDGenerator::ForType(IDType::Road)->NotifyChange(ID());
 
@@ -75,6 +74,16 @@ namespace LM
         }
     }
 
+    void Road::GenerateLanes()
+    {
+        refLineIndex.reset();
+        generated.length = Length();
+        generated.rr_profile.Apply(Length(), &generated);
+
+        generated.PlaceMarkings();
+        generated.DeriveLaneBorders();
+    }
+
     void Road::ReverseRefLine()
     {
         generated.ref_line.reverse();
@@ -166,6 +175,25 @@ namespace LM
         return to_odr_unit(modifiedKey_s);
     }
 
+    odr::Vec2D Road::ProjectToRefLine(const odr::Vec2D& xy, double sMin, double sMax) const
+    {
+        return RefLineIndex().project(xy, sMin, sMax);
+    }
+
+    std::vector<odr::Vec2D> Road::ProjectToRefLine(const std::vector<odr::Vec2D>& xy) const
+    {
+        return RefLineIndex().project(xy);
+    }
+
+    const odr::RefLineIndex& Road::RefLineIndex() const
+    {
+        if (refLineIndex == nullptr)
+        {
+            refLineIndex = std::make_unique<odr::RefLineIndex>(generated.ref_line);
+        }
+        return *refLineIndex;
+    }
+
     void Road::UpdateArrowGraphics(odr::RoadLink::ContactPoint c, std::map<int, uint8_t> laneToArrow, bool stopLine)
     {
 #ifndef G_TEST
@@ -239,8 +267,28 @@ namespace LM
         GenerateSectionGraphicsBetween(0, Length());
     }
 
+    std::map<double, SectionTessellation> Road::TessellateAllSections() const
+    {
+        return TessellateSectionsBetween(0, Length());
+    }
+
+    void Road::GenerateAllSectionGraphics(const std::map<double, SectionTessellation>& tessellation)
+    {
+        for (const auto& s_tessellation : tessellation)
+        {
+            s_to_section_graphics.emplace(s_tessellation.first,
+                std::make_unique<SectionGraphics>(ID(), s_tessellation.second));
+        }
+    }
+
     void Road::GenerateSectionGraphicsBetween(double s1, double s2)
     {
+        GenerateAllSectionGraphics(TessellateSectionsBetween(s1, s2));
+    }
+
+    std::map<double, SectionTessellation> Road::TessellateSectionsBetween(double s1, double s2) const
+    {
+        std::map<double, SectionTessellation> rtn;
         const double sBeginGlobal = generated.get_lanesection_s0(s1);
         auto sIt = generated.s_to_lanesection.find(sBeginGlobal);
         for (; sIt != generated.s_to_lanesection.end(); ++sIt)
@@ -263,10 +311,26 @@ namespace LM
             {
                 double segStartS = startS + segmentLength * segmentIndex;
                 double segEndS = segmentIndex == nDivision - 1 ? endS : segStartS + segmentLength;
-                auto sectionGraphics = std::make_unique<SectionGraphics>(
-                    shared_from_this(), sIt->second, segStartS, segEndS);
-                s_to_section_graphics.emplace(segStartS, std::move(sectionGraphics));
+                rtn.emplace(segStartS, SectionGraphics::Tessellate(*this, sIt->second, segStartS, segEndS));
+            }
+        }
+        return rtn;
+    }
+
+    void Road::ClearSectionGraphics()
+    {
+        s_to_section_graphics.clear();
+    }
+
+    void Road::UnIndexSectionGraphics()
+    {
+        for (auto& s_graphics : s_to_section_graphics)
+        {
+            for (auto index : s_graphics.second->allSpatialIndice)
+            {
+                SpatialIndexer::Instance()->UnIndex(index);
             }
+            s_graphics.second->allSpatialIndice.clear();
         }
     }
 
@@ -303,24 +367,24 @@ namespace LM
         if (sBegin >= sEnd) 
             return rtn;
         
-        std::set<FaceIndex_t> selfFaces;
-        for (auto& s_graphics : s_to_section_graphics)
-        {
-            selfFaces.insert(
-                s_graphics.second->allSpatialIndice.begin(),
-                s_graphics.second->allSpatialIndice.end());
-        }
-        
         std::map<std::shared_ptr<Road>, MultiSegment> rangeOnOther;
         std::map<std::shared_ptr<Road>, MultiSegment> rangeOnSelf;
         std::map<std::shared_ptr<Road>, std::vector<std::pair<double, double>>> linkPoints;
         const double RangeExtension = 0.5; // expands from single point to range
 
-        for (auto st: generated.sample_st(sBegin, sEnd, 1.0))
+        auto samples = generated.sample_st(sBegin, sEnd, 1.0);
+        std::vector<odr::Vec3D> samplePoints;
+        samplePoints.reserve(samples.size());
+        for (const auto& st : samples)
         {
-            auto pt = generated.get_xyz(st.first, st.second, 0);
+            samplePoints.push_back(generated.get_xyz(st.first, st.second, 0));
+        }
+        auto overlapsAtSamples = SpatialIndexer::Instance()->AllOverlaps(samplePoints, zThreshold);
 
-            for (auto overlap : SpatialIndexer::Instance()->AllOverlaps(pt, zThreshold))
+        for (int sampleIndex = 0; sampleIndex != samples.size(); ++sampleIndex)
+        {
+            const auto& st = samples[sampleIndex];
+            for (const auto& overlap : overlapsAtSamples[sampleIndex])
             {
                 if (overlap.roadID == ID())
                 {
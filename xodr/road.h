@@ -1,5 +1,6 @@
 #pragma once
 
+#include <limits>
 #include <map>
 #include <optional>
 
@@ -14,12 +15,14 @@ namespace LM
     class AbstractJunction;
 
     class SectionGraphics;
+    struct SectionTessellation;
 
     class Road: public std::enable_shared_from_this<Road>
     {
         friend class LTest::Validation;
     public:
-        Road(const LaneProfile& p, std::unique_ptr<odr::RoadGeometry> l);
+        // generateNow = false leaves lanes empty until GenerateLanes
+        Road(const LaneProfile& p, std::unique_ptr<odr::RoadGeometry> l, bool generateNow = true);
 
         Road(const LaneProfile& p, odr::RefLine& l);
 
@@ -32,6 +35,9 @@ namespace LM
 
         void Generate(bool notifyJunctions=true);
 
+        // Part of Generate that only writes this road, so it can run on a worker thread
+        void GenerateLanes();
+
         /*Without visible change to shape
         * Caller is responsible for re-generate junction
         */
@@ -63,6 +69,14 @@ namespace LM
 
         double SnapToSegmentBoundary(double key, double limit, bool* outSuccess = nullptr);
 
+        /*{s, t} of the ref line point nearest to xy, s within [sMin, sMax]
+        * Index of ref line is built on first call after Generate. Not thread-safe.
+        */
+        odr::Vec2D ProjectToRefLine(const odr::Vec2D& xy,
+            double sMin = -std::numeric_limits<double>::infinity(),
+            double sMax = std::numeric_limits<double>::infinity()) const;
+        std::vector<odr::Vec2D> ProjectToRefLine(const std::vector<odr::Vec2D>& xy) const;
+
         // Special markings for normal junction
         void UpdateArrowGraphics(odr::RoadLink::ContactPoint c, std::map<int, uint8_t> laneToArrow, bool stopLine);
 
@@ -70,6 +84,10 @@ namespace LM
         // Expensive, but safe
         void GenerateAllSectionGraphics();
 
+        // GenerateAllSectionGraphics in two steps: Tessellate is thread-safe, then commit on GUI thread
+        std::map<double, SectionTessellation> TessellateAllSections() const;
+        void GenerateAllSectionGraphics(const std::map<double, SectionTessellation>& tessellation);
+
         // Preferred
         // Sections containing s1/s2 will be updated
         void GenerateOrUpdateSectionGraphicsBetween(double s1, double s2);
@@ -77,6 +95,12 @@ namespace LM
         // Special markings for direct junction
         void ApplyBoundaryHideToGraphics();
 
+        // Removes graphics along with their spatial index faces
+        void ClearSectionGraphics();
+
+        // Graphics stay visible, but can't be hit by ray cast or overlap query
+        void UnIndexSectionGraphics();
+
         struct RoadsOverlap
         {
             RoadsOverlap(double aSBegin1, double aSEnd1,
@@ -113,6 +137,8 @@ namespace LM
 #ifndef G_TEST
         void GenerateSectionGraphicsBetween(double s1, double s2);
 
+        std::map<double, SectionTessellation> TessellateSectionsBetween(double s1, double s2) const;
+
         const double NeglectableLength = 0.01f;
 
         // When updates road, remove RoadSectionGraphics then add new
@@ -121,6 +147,10 @@ namespace LM
 #endif
 
         std::map<std::pair<odr::RoadLink::ContactPoint, int>, double> graphicsBoundaryHide;
+
+        const odr::RefLineIndex& RefLineIndex() const;
+
+        mutable std::unique_ptr<odr::RefLineIndex> refLineIndex;
     };
 
     enum RoadJoinError
@@ -184,6 +184,7 @@ namespace LM
         if (s1 == 0 && predecessorJunction != nullptr)
         {
             predecessorJunction->NotifyPotentialChange();
+            predecessorJunction->RegenerateIfPending();
             if (predecessorJunction->generationError != Junction_NoError)
             {
                 return false;
@@ -192,6 +193,7 @@ namespace LM
         if (s2 == Length() && successorJunction != nullptr)
         {
             successorJunction->NotifyPotentialChange();
+            successorJunction->RegenerateIfPending();
             if (successorJunction->generationError != Junction_NoError)
             {
                 return false;
@@ -0,0 +1,445 @@
+#pragma once
+
+#include "curve_fitting.h"
+
+#include <limits>
+
+namespace LM
+{
+    /*FitUnitSpiral solutions sampled offline on the posAngleCombo grid, at the precision of TestSpiralFitting.
+    * Entries[i][j]: end pos angle PosAngleBegin + i * AngleStep, turn angle TurnAngleBegin + j * AngleStep (degrees).
+    * Cells outside posAngleCombo are NaN. TestSpiralFitting checks the table against the solver.
+    * Generated by GenerateSpiralFitTable; to regenerate, run from this directory:
+    *   LaneMakerTest --gtest_also_run_disabled_tests --gtest_filter=RoadGeometry.DISABLED_GenerateSpiralFitTable
+    */
+    namespace SpiralFitTable
+    {
+        const int AngleStep = 5;
+        const int PosAngleBegin = 5;
+        const int TurnAngleBegin = 5;
+        const int NPosAngle = 32;
+        const int NTurnAngle = 29;
+
+        constexpr double NA = std::numeric_limits<double>::quiet_NaN();
+
+        const FitResult Entries[NPosAngle][NTurnAngle] =
+        {
+            // pos angle 5
+            {
+                { 0.01743114855, 0.01743114855, 10.01270368 }, { 3.07122424e-05, 0.05216986459, 10.03051704 }, { -0.01724211851, 0.08664888424, 10.058554 },
+                { -0.03431188587, 0.1207411425, 10.09686604 }, { -0.05110649259, 0.1543242276, 10.14551958 }, { -0.06755573556, 0.1872792985, 10.20459504 },
+                { -0.08359228172, 0.2194924412, 10.27418516 }, { -0.09915221894, 0.2508556111, 10.35439158 }, { -0.1141752879, 0.2812665772, 10.44536348 },
+                { -0.1286060009, 0.3106319066, 10.54719201 }, { -0.1423933146, 0.3388651575, 10.66002675 }, { -0.1554913839, 0.3658888193, 10.78400991 },
+                { NA, NA, NA }, { NA, NA, NA }, { NA, NA, NA },
+                { NA, NA, NA }, { NA, NA, NA }, { NA, NA, NA },
+                { NA, NA, NA }, { NA, NA, NA }, { NA, NA, NA },
+                { NA, NA, NA }, { NA, NA, NA }, { NA, NA, NA },
+                { NA, NA, NA }, { NA, NA, NA }, { NA, NA, NA },
+                { NA, NA, NA }, { NA, NA, NA },
+            },
+            // pos angle 10
+            {
+                { 0.05217013599, 3.044084801e-05, 10.03051704 }, { 0.03472963553, 0.03472963553, 10.05095058 }, { 0.01739488903, 0.06916465531, 10.08166844 },
+                { 0.0002405431119, 0.1032095072, 10.12273602 }, { -0.01666050805, 0.1367413386, 10.17423406 }, { -0.03323756999, 0.1696412651, 10.2362579 },
+                { -0.04942271402, 0.2017953127, 10.30891604 }, { -0.06515132465, 0.2330953531, 10.39232694 }, { -0.08036245853, 0.2634392256, 10.48665108 },
+                { -0.09499964669, 0.2927332374, 10.5920046 }, { -0.109010938, 0.320890917, 10.7085532 }, { -0.1223494628, 0.347834649, 10.8364589 },
+                { -0.1349736998, 0.3734959731, 10.9758885 }, { -0.1468477021, 0.3978159819, 11.12701097 }, { NA, NA, NA },
+                { NA, NA, NA }, { NA, NA, NA }, { NA, NA, NA },
+                { NA, NA, NA }, { NA, NA, NA }, { NA, NA, NA },
+                { NA, NA, NA }, { NA, NA, NA }, { NA, NA, NA },
+                { NA, NA, NA }, { NA, NA, NA }, { NA, NA, NA },
+                { NA, NA, NA }, { NA, NA, NA },
+            },
+            // pos angle 15
+            {
+                { 0.08664888424, -0.01724211851, 10.058554 }, { 0.06916462561, 0.01739491975, 10.08166832 }, { 0.05176380902, 0.05176380902, 10.1151516 },
+                { 0.03452113883, 0.08573877461, 10.15908328 }, { 0.01750992979, 0.1191969098, 10.21355922 }, { 0.0008013704831, 0.152019295, 10.27869053 },
+                { -0.01553601401, 0.1840919036, 10.3546026 }, { -0.03143690634, 0.2153065247, 10.44143233 }, { -0.04683965534, 0.2455611194, 10.5393502 },
+                { -0.06168684474, 0.2747617046, 10.64850179 }, { -0.07592560795, 0.3028218093, 10.76906946 }, { -0.08950805654, 0.3296637297, 10.90123687 },
+                { -0.1023915851, 0.3552189105, 11.04519379 }, { -0.1145391109, 0.3794283484, 11.20113357 }, { -0.1259191786, 0.4022428246, 11.36925015 },
+                { -0.1365073241, 0.4236243445, 11.54973528 }, { -0.1462831165, 0.4435432504, 11.74277378 }, { -0.1552335603, 0.4619816022, 11.94854059 },
+                { -0.163351243, 0.4789313037, 12.16719569 }, { -0.1706346133, 0.4943943041, 12.39887915 }, { -0.1770876516, 0.5083820987, 12.64370786 },
+                { -0.1827200503, 0.5209158739, 12.90176527 }, { NA, NA, NA }, { NA, NA, NA },
+                { NA, NA, NA }, { NA, NA, NA }, { NA, NA, NA },
+                { NA, NA, NA }, { NA, NA, NA },
+            },
+            // pos angle 20
+            {
+                { 0.1207411425, -0.03431188586, 10.09686604 }, { 0.1032095072, 0.0002405431106, 10.12273603 }, { 0.08573936175, 0.0345205571, 10.15908283 },
+                { 0.06840402867, 0.06840402867, 10.20600269 }, { 0.05127894953, 0.1017663212, 10.26360579 }, { 0.03443522259, 0.134489071, 10.33202043 },
+                { 0.01794196923, 0.1664582098, 10.41138998 }, { 0.001865203605, 0.1975654549, 10.50187127 }, { -0.01373267815, 0.2277088813, 10.60364655 },
+                { -0.02879336103, 0.2567942593, 10.71689178 }, { -0.04326305053, 0.2847351221, 10.84180817 }, { -0.057092846, 0.3114536949, 10.9786031 },
+                { -0.07023906674, 0.3368813465, 11.1274916 }, { -0.08266350601, 0.3609590003, 11.28869392 }, { -0.09433356705, 0.3836373893, 11.46243265 },
+                { -0.1052232931, 0.4048781585, 11.64892984 }, { -0.1153112967, 0.4246518468, 11.84840277 }, { -0.1245831753, 0.4429402829, 12.06106056 },
+                { -0.1330302015, 0.4597352394, 12.28709942 }, { -0.1406494936, 0.4750385165, 12.5266977 }, { -0.1474437377, 0.4888615013, 12.78001204 },
+                { -0.1534212609, 0.5012251593, 13.04716847 }, { -0.1585954058, 0.5121591112, 13.32825997 }, { -0.1629843775, 0.5217012898, 13.62333845 },
+                { -0.1666107812, 0.5298971932, 13.93240888 }, { -0.169501216, 0.53679924, 14.25542043 }, { NA, NA, NA },
+                { NA, NA, NA }, { NA, NA, NA },
+            },
+            // pos angle 25
+            {
+                { 0.1543242273, -0.05110649253, 10.1455196 }, { 0.1367413381, -0.01666050803, 10.1742341 }, { 0.1191969097, 0.01750992977, 10.21355923 },
+                { 0.1017663212, 0.05127894953, 10.26360579 }, { 0.08452365235, 0.08452365235, 10.3245021 }, { 0.06754108843, 0.1171250766, 10.39639382 },
+                { 0.05088834774, 0.1489691263, 10.47944348 }, { 0.03463213619, 0.1799474647, 10.5738291 }, { 0.01883563367, 0.2099584028, 10.67974057 },
+                { 0.003557984493, 0.2389070564, 10.79740761 }, { -0.01114604751, 0.2667074447, 10.92702902 }, { -0.02522656769, 0.2932815762, 11.06884644 },
+                { -0.03863882864, 0.3185607639, 11.22310279 }, { -0.05134350976, 0.3424858783, 11.39004809 }, { -0.06330688451, 0.3650076264, 11.56993676 },
+                { -0.07450154635, 0.3860873449, 11.76302465 }, { -0.08490513646, 0.4056957641, 11.96956527 }, { -0.09450188025, 0.4238145246, 12.1898061 },
+                { -0.103281761, 0.4404353002, 12.42398409 }, { -0.1112405947, 0.4555597775, 12.67232076 }, { -0.1183797975, 0.4691992616, 12.93501792 },
+                { -0.1247063703, 0.4813745417, 13.21224981 }, { -0.1302323892, 0.4921151046, 13.50415949 }, { -0.1349747997, 0.5014587144, 13.81085125 },
+                { -0.1389549784, 0.5094506829, 14.13238451 }, { -0.1421983509, 0.5161432483, 14.46876456 }, { NA, NA, NA },
+                { NA, NA, NA }, { NA, NA, NA },
+            },
+            // pos angle 30
+            {
+                { 0.1872792974, -0.06755573529, 10.20459511 }, { 0.1696412612, -0.03323756963, 10.23625817 }, { 0.1520192927, 0.0008013703649, 10.27869069 },
+                { 0.1344890704, 0.0344352225, 10.33202047 }, { 0.1171250766, 0.06754108842, 10.39639382 }, { 0.1, 0.1, 10.47197551 },
+                { 0.08318415787, 0.1316978469, 10.55894853 }, { 0.06674494545, 0.1625262611, 10.65751339 }, { 0.0507463207, 0.1923834735, 10.76788588 },
+                { 0.03524828827, 0.2211748422, 10.89030774 }, { 0.02030653611, 0.2488140509, 11.02501953 }, { 0.005971960426, 0.2752231823, 11.17228635 },
+                { -0.007709633304, 0.3003335132, 11.33238196 }, { -0.02069781972, 0.3240858823, 11.50558949 }, { -0.03295774891, 0.3464309879, 11.6921988 },
+                { -0.04446017529, 0.3673294814, 11.8925035 }, { -0.05518310766, 0.3867536258, 12.10679798 }, { -0.06510806117, 0.4046835523, 12.33537259 },
+                { -0.07422421834, 0.4211113297, 12.57851038 }, { -0.08252612325, 0.4360385683, 12.83648177 }, { -0.09001394673, 0.4494765189, 13.10954003 },
+                { -0.09669340646, 0.4614458425, 13.39791437 }, { -0.1025753459, 0.471975927, 13.70180528 }, { -0.1076754921, 0.4811044063, 14.02137745 },
+                { -0.1120140368, 0.4888764459, 14.35675342 }, { -0.1156152659, 0.4953441197, 14.70800428 }, { NA, NA, NA },
+                { NA, NA, NA }, { NA, NA, NA },
+            },
+            // pos angle 35
+            {
+                { 0.2194924396, -0.08359228132, 10.27418525 }, { 0.2017952916, -0.04942271125, 10.30891728 }, { 0.1840918859, -0.0155360139, 10.35460368 },
+                { 0.1664582017, 0.01794196838, 10.41139049 }, { 0.1489691244, 0.05088834744, 10.47944359 }, { 0.1316978468, 0.08318415786, 10.55894853 },
+                { 0.1147152873, 0.1147152873, 10.65011042 }, { 0.09808953147, 0.1453733574, 10.75315376 }, { 0.08188530937, 0.1750565591, 10.86832138 },
+                { 0.06616351733, 0.2036704807, 10.99587061 }, { 0.05098068577, 0.2311282995, 11.13609568 }, { 0.03638877469, 0.2573524928, 11.28927374 },
+                { 0.02243461652, 0.2822742019, 11.45571868 }, { 0.009159732102, 0.3058342545, 11.63575047 }, { -0.00339990981, 0.3279833569, 11.82969861 },
+                { -0.01521398281, 0.3486822389, 12.03789928 }, { -0.0262587765, 0.3679026352, 12.26069223 }, { -0.0365151811, 0.3856252478, 12.49841682 },
+                { -0.04597092792, 0.4018419036, 12.75140814 }, { -0.0546193211, 0.4165541758, 13.01999219 }, { -0.06245934684, 0.4297733329, 13.30448088 },
+                { -0.0694953825, 0.4415198348, 13.60516708 }, { -0.07573717744, 0.4518231308, 13.92231672 }, { -0.08119924899, 0.4607207253, 14.25616472 },
+                { -0.08590065054, 0.4682576787, 14.60690714 }, { -0.08986456505, 0.4744859208, 14.9746925 }, { -0.09311778673, 0.4794631679, 15.35962314 },
+                { NA, NA, NA }, { NA, NA, NA },
+            },
+            // pos angle 40
+            {
+                { 0.2508556192, -0.09915222109, 10.35439118 }, { 0.2330952661, -0.06515131078, 10.39233147 }, { 0.2153064333, -0.03143690182, 10.44143726 },
+                { 0.1975653979, 0.001865200449, 10.50187443 }, { 0.1799474419, 0.03463213301, 10.57383038 }, { 0.1625262562, 0.06674494466, 10.65751365 },
+                { 0.1453733571, 0.09808953147, 10.75315377 }, { 0.1285575219, 0.1285575219, 10.86100121 }, { 0.1121442533, 0.1580471024, 10.98132737 },
+                { 0.09619528939, 0.1864637997, 11.1144229 }, { 0.08076817361, 0.2137213015, 11.26059115 }, { 0.06591565394, 0.2397410765, 11.42019186 },
+                { 0.05168576833, 0.2644551054, 11.59353862 }, { 0.038121073, 0.2878039837, 11.78100387 }, { 0.02525864985, 0.3097384438, 11.98296151 },
+                { 0.01312991899, 0.3302192939, 12.19979557 }, { 0.001760097348, 0.3492179611, 12.43189717 }, { -0.008830876141, 0.3667155279, 12.67966098 },
+                { -0.01862939411, 0.3827037002, 12.94348132 }, { -0.02762755383, 0.3971840557, 13.2237476 }, { -0.03582314067, 0.4101678592, 13.52083943 },
+                { -0.0432193759, 0.421675589, 13.83512167 }, { -0.0498248154, 0.4317366283, 14.16693723 }, { -0.0556528586, 0.4403884526, 14.51660229 },
+                { -0.0607214689, 0.4476760607, 14.88439898 }, { -0.06505277039, 0.4536512687, 15.27056713 }, { -0.06867256572, 0.4583717188, 15.6753032 },
+                { -0.07160999735, 0.4619004688, 16.09874124 }, { NA, NA, NA },
+            },
+            // pos angle 45
+            {
+                { 0.2812665772, -0.1141752879, 10.44536348 }, { 0.2634392256, -0.08036245853, 10.48665108 }, { 0.2455613535, -0.04683969466, 10.53933987 },
+                { 0.2277089539, -0.01373268931, 10.6036435 }, { 0.2099582526, 0.01883561856, 10.67974828 }, { 0.192383418, 0.05074631176, 10.76788874 },
+                { 0.1750565477, 0.08188530762, 10.86832194 }, { 0.1580471017, 0.1121442534, 10.98132739 }, { 0.1414213562, 0.1414213562, 11.10720735 },
+                { 0.1252418935, 0.169622144, 11.24628696 }, { 0.109567151, 0.1966601979, 11.39891168 }, { 0.09445095128, 0.2224575367, 11.56545681 },
+                { 0.07994225389, 0.2469456063, 11.74630453 }, { 0.0660847268, 0.2700652361, 11.94186441 }, { 0.05291655645, 0.2917672069, 12.15256026 },
+                { 0.04047026486, 0.3120124102, 12.37883005 }, { 0.02877268957, 0.3307718631, 12.62112309 }, { 0.01784389215, 0.3480277463, 12.8798969 },
+                { 0.0076995801, 0.3637708949, 13.15561326 }, { -0.001651455694, 0.3780032184, 13.44873422 }, { -0.01020583727, 0.390736022, 13.75971727 },
+                { -0.01796566369, 0.4019898412, 14.08901053 }, { -0.02493835171, 0.4117940511, 14.4370462 }, { -0.03113622711, 0.4201861408, 14.80423547 },
+                { -0.03657621446, 0.4272110942, 15.1909616 }, { -0.04127943194, 0.4329206574, 15.59757243 }, { -0.04527075026, 0.4373724432, 16.02437689 },
+                { -0.04857838567, 0.4406293154, 16.47163096 }, { NA, NA, NA },
+            },
+            // pos angle 50
+            {
+                { 0.3106319066, -0.1286060009, 10.54719201 }, { 0.2927332374, -0.09499964672, 10.5920046 }, { 0.2747617047, -0.06168684477, 10.64850179 },
+                { 0.2567942593, -0.02879336104, 10.71689178 }, { 0.238907167, 0.003557964542, 10.79740357 }, { 0.221174859, 0.03524828189, 10.8903073 },
+                { 0.2036703587, 0.06616349609, 10.99587645 }, { 0.1864637754, 0.09619528594, 11.11442399 }, { 0.1696221427, 0.1252418936, 11.246287 },
+                { 0.1532088886, 0.1532088886, 11.39182764 }, { 0.1372833531, 0.1800098545, 11.55143363 }, { 0.1219003845, 0.2055670814, 11.72551399 },
+                { 0.107109858, 0.2298116663, 11.91451715 }, { 0.09295658538, 0.2526848198, 12.1188901 }, { 0.07947982229, 0.2741373064, 12.33911702 },
+                { 0.06671319261, 0.2941301157, 12.57569685 }, { 0.05468457807, 0.3126344424, 12.82914501 }, { 0.04341561888, 0.3296321265, 13.09999046 },
+                { 0.0329226789, 0.3451145839, 13.3887723 }, { 0.02321586011, 0.3590836444, 13.69603595 }, { 0.0142996636, 0.3715507017, 14.02232878 },
+                { 0.006173076955, 0.3825363896, 14.3681955 }, { -0.001170233778, 0.392070136, 14.73417235 }, { -0.007741568158, 0.4001894901, 15.12078196 },
+                { -0.01355686612, 0.4069394708, 15.52852696 }, { -0.01863630088, 0.4123718093, 15.95788333 }, { -0.02300386686, 0.4165441202, 16.40929531 },
+                { -0.02668692631, 0.4195191323, 16.88316553 }, { NA, NA, NA },
+            },
+            // pos angle 55
+            {
+                { 0.3388651574, -0.1423933144, 10.66002675 }, { 0.3208909172, -0.1090109383, 10.7085532 }, { 0.3028218096, -0.07592560819, 10.76906946 },
+                { 0.2847351222, -0.04326305067, 10.84180817 }, { 0.2667074447, -0.01114604756, 10.92702902 }, { 0.248814205, 0.02030650014, 11.0250147 },
+                { 0.2311283168, 0.05098067641, 11.13609537 }, { 0.2137210541, 0.08076812868, 11.26060233 }, { 0.1966601497, 0.1095671448, 11.39891371 },
+                { 0.1800098519, 0.1372833534, 11.55143372 }, { 0.1638304089, 0.1638304089, 11.7185948 }, { 0.1481776131, 0.1891305953, 11.90085856 },
+                { 0.1331024581, 0.2131155006, 12.09870863 }, { 0.1186506063, 0.2357256877, 12.31268345 }, { 0.1048625468, 0.2569125985, 12.54330519 },
+                { 0.09177295273, 0.276637181, 12.79114918 }, { 0.0794107738, 0.2948707999, 13.05680602 }, { 0.06779922453, 0.3115949707, 13.34088633 },
+                { 0.05695478565, 0.3268022438, 13.64401784 }, { 0.0468895174, 0.3404937338, 13.96684205 }, { 0.0376087421, 0.3526812343, 14.31001036 },
+                { 0.02911248341, 0.3633855361, 14.67417986 }, { 0.02139546655, 0.3726361437, 15.06000864 }, { 0.01444733432, 0.3804707562, 15.4681503 },
+                { 0.008253084879, 0.3869344683, 15.89924899 }, { 0.002793423155, 0.3920790584, 16.35393332 }, { -0.001955043164, 0.3959625812, 16.83280272 },
+                { -0.006018253495, 0.3986464765, 17.33646153 }, { NA, NA, NA },
+            },
+            // pos angle 60
+            {
+                { 0.3658888185, -0.1554913831, 10.78400991 }, { 0.3478346505, -0.1223494643, 10.8364589 }, { 0.3296637314, -0.08950805826, 10.90123687 },
+                { 0.311453696, -0.05709284714, 10.9786031 }, { 0.2932815768, -0.02522656825, 11.06884644 }, { 0.2752231825, 0.005971960219, 11.17228635 },
+                { 0.2573526899, 0.03638871341, 11.28926852 }, { 0.2397410886, 0.06591564496, 11.42019174 }, { 0.2224575303, 0.09445096737, 11.56545645 },
+                { 0.2055669913, 0.121900374, 11.7255176 }, { 0.1891305904, 0.1481776138, 11.90085871 }, { 0.1732050808, 0.1732050808, 12.09199576 },
+                { 0.1578424208, 0.196914329, 12.29947882 }, { 0.1430895084, 0.2192467658, 12.5238801 }, { 0.1289875349, 0.2401526726, 12.76585125 },
+                { 0.1155725319, 0.2595941464, 13.02600201 }, { 0.1028744415, 0.2775424527, 13.30502117 }, { 0.09091746322, 0.2939793871, 13.6036129 },
+                { 0.07971961296, 0.3088972317, 13.92250685 }, { 0.0692935111, 0.3222977964, 14.26245552 }, { 0.05964569604, 0.3341928914, 14.62423113 },
+                { 0.0507771989, 0.3446034989, 15.00862204 }, { 0.04268370197, 0.3535593159, 15.41642908 }, { 0.03535578133, 0.3610981954, 15.8484608 },
+                { 0.02877929704, 0.3672653834, 16.30552953 }, { 0.02293576183, 0.3721127714, 16.78844648 }, { 0.01780265332, 0.3756982685, 17.29801306 },
+                { 0.01335437098, 0.378083975, 17.83503604 }, { NA, NA, NA },
+            },
+            // pos angle 65
+            {
+                { 0.3916345422, -0.1678597771, 10.91928731 }, { 0.3734959815, -0.1349737082, 10.9758885 }, { 0.3552189207, -0.1023915954, 11.04519379 },
+                { 0.3368813542, -0.07023907442, 11.1274916 }, { 0.3185607683, -0.038638833, 11.22310279 }, { 0.3003335152, -0.007709635253, 11.33238196 },
+                { 0.2822742026, 0.02243461584, 11.45571868 }, { 0.2644553359, 0.05168567369, 11.59353364 }, { 0.2469456035, 0.07994225672, 11.74630453 },
+                { 0.2298116548, 0.1071098993, 11.9145161 }, { 0.2131153397, 0.1331024411, 12.09871485 }, { 0.1969143203, 0.1578424222, 12.29947907 },
+                { 0.1812615574, 0.1812615574, 12.51742543 }, { 0.1662049085, 0.2033011585, 12.75321138 }, { 0.1517868268, 0.2239124382, 13.00753651 },
+                { 0.1380441843, 0.2430568981, 13.28113475 }, { 0.1250080583, 0.260706279, 13.57478126 }, { 0.1127036674, 0.2768426403, 13.88928755 },
+                { 0.1011504312, 0.291458143, 14.22550085 }, { 0.09036125165, 0.304555586, 14.58430227 }, { 0.08034428907, 0.316146404, 14.96660467 },
+                { 0.07110134502, 0.3262520172, 15.37335018 }, { 0.06262900236, 0.3349023814, 15.8055076 }, { 0.05491872391, 0.342135552, 16.26406923 },
+                { 0.04795715077, 0.3479970068, 16.75004803 }, { 0.04172653712, 0.3525388119, 17.26447455 }, { 0.03620510167, 0.355818885, 17.80839246 },
+                { 0.03136765661, 0.3578997589, 18.38286393 }, { NA, NA, NA },
+            },
+            // pos angle 70
+            {
+                { 0.4160435369, -0.179463696, 11.06600575 }, { 0.3978160233, -0.1468477437, 11.12701098 }, { 0.3794284013, -0.1145391641, 11.20113358 },
+                { 0.3609590434, -0.08266354928, 11.28869392 }, { 0.3424859058, -0.05134353728, 11.39004809 }, { 0.3240858965, -0.020697834, 11.50558949 },
+                { 0.3058342605, 0.009159726074, 11.63575047 }, { 0.2878039857, 0.03812107099, 11.78100387 }, { 0.2700654767, 0.06608459905, 11.9418604 },
+                { 0.2526847877, 0.09295662703, 12.11888977 }, { 0.2357256697, 0.1186506988, 12.31268086 }, { 0.2192464894, 0.1430894818, 12.52389057 },
+                { 0.2033011436, 0.1662049112, 12.75321181 }, { 0.1879385242, 0.1879385242, 13.00138417 }, { 0.1732021406, 0.2082417904, 13.26919744 },
+                { 0.1591298661, 0.2270762989, 13.55749398 }, { 0.1457538491, 0.2444141396, 13.86715681 }, { 0.1331003205, 0.2602376261, 14.19912229 },
+                { 0.1211896206, 0.2745392997, 14.55437355 }, { 0.1100364201, 0.2873214783, 14.93394111 }, { 0.09964820228, 0.2985975358, 15.33890208 },
+                { 0.09002903949, 0.3083878433, 15.77037916 }, { 0.08117596195, 0.3167230786, 16.22953959 }, { 0.07308123032, 0.3236415936, 16.71759414 },
+                { 0.06573222267, 0.3291891445, 17.2357959 }, { 0.05911185229, 0.3334180489, 17.78544001 }, { 0.05319895787, 0.3363863715, 18.36786294 },
+                { 0.0479687855, 0.3381569416, 18.98444559 }, { NA, NA, NA },
+            },
+            // pos angle 75
+            {
+                { 0.4390667776, -0.1902740369, 11.22430982 }, { 0.420745719, -0.1579413625, 11.28999446 }, { 0.4022430645, -0.1259194208, 11.36925024 },
+                { 0.3836375976, -0.09433377692, 11.46243271 }, { 0.3650077717, -0.06330703057, 11.56993679 }, { 0.3464310728, -0.03295783411, 11.69219881 },
+                { 0.3279833987, -0.003399951658, 11.82969862 }, { 0.3097384609, 0.0252586328, 11.98296151 }, { 0.2917672125, 0.05291655088, 12.15256026 },
+                { 0.2741375151, 0.07947968238, 12.33911462 }, { 0.256912517, 0.1048626814, 12.54330334 }, { 0.2401526479, 0.1289877234, 12.76584559 },
+                { 0.2239124491, 0.1517869235, 13.00753278 }, { 0.2082417657, 0.1732021453, 13.26919813 }, { 0.1931851653, 0.1931851653, 13.55173351 },
+                { 0.178781583, 0.211697918, 13.85609402 }, { 0.1650641176, 0.2287125567, 14.18330229 }, { 0.1520600521, 0.244211878, 14.53442975 },
+                { 0.1397906654, 0.2581887485, 14.91061912 }, { 0.1282713785, 0.270646044, 15.31307493 }, { 0.1175113823, 0.2815967098, 15.74306668 },
+                { 0.1075147302, 0.291062375, 16.20192969 }, { 0.09827955565, 0.2990737944, 16.69106642 }, { 0.08979884807, 0.3056696992, 17.21194803 },
+                { 0.0820606545, 0.3108961907, 17.76611629 }, { 0.07504846809, 0.3148059168, 18.35518648 }, { 0.06874163799, 0.3174572047, 18.98085144 },
+                { 0.06311560257, 0.3189135075, 19.64487937 }, { NA, NA, NA },
+            },
+            // pos angle 80
+            {
+                { 0.4606669778, -0.2002692815, 11.39433939 }, { 0.4422469959, -0.1682311405, 11.46500318 }, { 0.423623772, -0.1365067477, 11.54973512 },
+                { 0.4048779, -0.1052230336, 11.64892981 }, { 0.3860872421, -0.07450144345, 11.76302465 }, { 0.3673299059, -0.04446060269, 11.89250361 },
+                { 0.3486824749, -0.01521421968, 12.03789931 }, { 0.3302194062, 0.01312980649, 12.19979557 }, { 0.312012455, 0.04047022003, 12.37883005 },
+                { 0.2941301301, 0.06671317815, 12.57569685 }, { 0.2766372913, 0.09177286176, 12.79114851 }, { 0.2595939894, 0.1155728578, 13.02599615 },
+                { 0.2430568688, 0.1380445423, 13.2811233 }, { 0.2270763212, 0.1591300357, 13.55748724 }, { 0.2116978783, 0.178781591, 13.85609515 },
+                { 0.1969615506, 0.1969615506, 14.17803015 }, { 0.1829014938, 0.2136425225, 14.52445705 }, { 0.1695458552, 0.2288073031, 14.89662962 },
+                { 0.1569169369, 0.2424494212, 15.2958612 }, { 0.1450309833, 0.2545721669, 15.723563 }, { 0.1338985001, 0.2651884734, 16.18123031 },
+                { 0.1235234362, 0.2743213285, 16.67044975 }, { 0.1139054103, 0.2820012017, 17.19290327 }, { 0.1050378527, 0.2882675029, 17.75037362 },
+                { 0.0969094101, 0.2931667563, 18.34475046 }, { 0.08950406689, 0.296752028, 18.97803803 }, { 0.08280158489, 0.2990820053, 19.65236521 },
+                { 0.07677786526, 0.3002201901, 20.36999555 }, { NA, NA, NA },
+            },
+            // pos angle 85
+            {
+                { 0.4808142478, -0.2094310484, 11.57622381 }, { 0.462290566, -0.1776981668, 11.65219306 }, { 0.4435432503, -0.1462831165, 11.74277378 },
+                { 0.4246518468, -0.1153112967, 11.84840277 }, { 0.4056952925, -0.08490466349, 11.96956522 }, { 0.3867534413, -0.05518292311, 12.10679798 },
+                { 0.367902574, -0.02625871526, 12.26069223 }, { 0.3492179448, 0.001760113759, 12.43189716 }, { 0.3307721439, 0.02877240818, 12.62112311 },
+                { 0.3126345532, 0.05468446723, 12.82914502 }, { 0.2948708354, 0.07941073828, 13.05680602 }, { 0.277542367, 0.1028745289, 13.30502111 },
+                { 0.2607062805, 0.1250080568, 13.57478126 }, { 0.2444141398, 0.145753849, 13.86715681 }, { 0.228712599, 0.165064404, 14.18329045 },
+                { 0.2136424599, 0.1829015069, 14.52445886 }, { 0.1992389396, 0.1992389396, 14.89196707 }, { 0.1855312291, 0.2140600886, 15.28725003 },
+                { 0.1725423634, 0.227358357, 15.71186294 }, { 0.160289574, 0.2391379392, 16.16743469 }, { 0.1487840121, 0.2494123035, 16.6557321 },
+                { 0.1380308747, 0.2582044713, 17.17863929 }, { 0.1280299316, 0.2655459774, 17.73817159 }, { 0.1187753933, 0.271476589, 18.3364858 },
+                { 0.1102564169, 0.2760433573, 18.97589216 }, { 0.1024573983, 0.2792998447, 19.6588694 }, { 0.09535841947, 0.2813051957, 20.3880821 },
+                { 0.08893563964, 0.2821232189, 21.1664038 }, { NA, NA, NA },
+            },
+            // pos angle 90
+            {
+                { 0.4994911686, -0.2177491925, 11.77007993 }, { 0.4808585553, -0.1863306784, 11.85170837 }, { 0.4619816018, -0.1552335601, 11.9485406 },
+                { 0.4429402826, -0.1245831752, 12.06106056 }, { 0.4238145244, -0.0945018802, 12.1898061 }, { 0.4046835522, -0.06510806115, 12.33537259 },
+                { 0.3856249285, -0.03651486181, 12.49841682 }, { 0.366715424, -0.008830772065, 12.67966098 }, { 0.3480277194, 0.01784391925, 12.87989689 },
+                { 0.3296321216, 0.04341562396, 13.09999046 }, { 0.3115952304, 0.06779896472, 13.34088633 }, { 0.2939794704, 0.09091737986, 13.6036129 },
+                { 0.2768422232, 0.1127041699, 13.8892845 }, { 0.2602376296, 0.1331003169, 14.19912229 }, { 0.2442118783, 0.1520600518, 14.53442975 },
+                { 0.2288073031, 0.1695458552, 14.89662962 }, { 0.2140599919, 0.1855312497, 15.28725294 }, { 0.2, 0.2, 15.70796327 },
+                { 0.1866514639, 0.2129467349, 16.16052888 }, { 0.1740321573, 0.2243753039, 16.646905 }, { 0.162154178, 0.2343004116, 17.16913932 },
+                { 0.1510235512, 0.2427453362, 17.72947846 }, { 0.1406403101, 0.249742588, 18.33033662 }, { 0.1309994815, 0.2553322804, 18.97432099 },
+                { 0.1220905645, 0.2595621737, 19.66425243 }, { 0.1138983001, 0.262486414, 20.40318966 }, { 0.1064029696, 0.264164715, 21.1944591 },
+                { 0.09958084636, 0.2646613597, 22.04169211 }, { NA, NA, NA },
+            },
+            // pos angle 95
+            {
+                { 0.5166899919, -0.2252189981, 11.97600646 }, { 0.4979430249, -0.1941225985, 12.0636768 }, { 0.4789312992, -0.1633512405, 12.16719577 },
+                { 0.4597352362, -0.1330302, 12.28709948 }, { 0.4404352983, -0.1032817602, 12.42398412 }, { 0.4211113287, -0.074224218, 12.5785104 },
+                { 0.4018419032, -0.0459709278, 12.75140815 }, { 0.3827031628, -0.01862885674, 12.94348132 }, { 0.3637707231, 0.007699752597, 13.15561323 },
+                { 0.3451145409, 0.03292272257, 13.38877227 }, { 0.3268022364, 0.0569547934, 13.64401783 }, { 0.3088972311, 0.07971961369, 13.92250684 },
+                { 0.2914583308, 0.1011502434, 14.22550085 }, { 0.2745393462, 0.1211895739, 14.55437356 }, { 0.2581887565, 0.1397906573, 14.91061912 },
+                { 0.242449422, 0.1569169361, 15.2958612 }, { 0.227358357, 0.1725423634, 15.71186294 }, { 0.2129465879, 0.1866514952, 16.16053356 },
+                { 0.1992389396, 0.1992389396, 16.6439632 }, { 0.186254325, 0.210310257, 17.16437724 }, { 0.1740051132, 0.2198794482, 17.72427176 },
+                { 0.1624982336, 0.22797149, 18.32626066 }, { 0.1517345827, 0.2346189656, 18.97325103 }, { 0.141708896, 0.2398634555, 19.66839514 },
+                { 0.1324116312, 0.2437528481, 20.41513521 }, { 0.1238275916, 0.2463421697, 21.21724262 }, { 0.1159371692, 0.2476917976, 22.07886415 },
+                { 0.1087166265, 0.247866626, 23.00457866 }, { NA, NA, NA },
+            },
+            // pos angle 100
+            {
+                { 0.5324130374, -0.2318416372, 12.1940791 }, { 0.5135460806, -0.2010737152, 12.28820459 }, { 0.4943942701, -0.1706345908, 12.39887959 },
+                { 0.4750384917, -0.140649478, 12.52669804 }, { 0.4555597618, -0.1112405854, 12.672321 }, { 0.4360385595, -0.08252611853, 12.83648192 },
+                { 0.4165541714, -0.05461931909, 13.01999227 }, { 0.3971840538, -0.02762755314, 13.22374765 }, { 0.3780032177, -0.001651455526, 13.44873424 },
+                { 0.3590833662, 0.02321614076, 13.69603586 }, { 0.3404936666, 0.04688958653, 13.96684198 }, { 0.3222977856, 0.06929352264, 14.2624555 },
+                { 0.3045555852, 0.09036125256, 14.58430226 }, { 0.2873218857, 0.1100360127, 14.93394112 }, { 0.2706461464, 0.1282712756, 15.31307495 },
+                { 0.2545721847, 0.1450309653, 15.72356301 }, { 0.239137941, 0.1602895722, 16.16743469 }, { 0.2243753039, 0.1740321573, 16.646905 },
+                { 0.2103100365, 0.1862543712, 17.16438478 }, { 0.1969615506, 0.1969615506, 17.72253769 }, { 0.1843433, 0.2061696997, 18.32422977 },
+                { 0.1724625078, 0.21390368, 18.97263034 }, { 0.1613205265, 0.2201972762, 19.67120729 }, { 0.1509129338, 0.2250924556, 20.42377297 },
+                { 0.1412299967, 0.2286383996, 21.2345302 }, { 0.1322568205, 0.2308908023, 22.10812919 }, { 0.1239738217, 0.2319108217, 23.04973714 },
+                { 0.1163571188, 0.2317640919, 24.06512488 }, { NA, NA, NA },
+            },
+            // pos angle 105
+            {
+                { 0.5466724508, -0.2376240175, 12.42434499 }, { 0.5276796112, -0.2071895198, 12.52537095 }, { 0.5083821915, -0.1770877266, 12.64370718 },
+                { 0.4888615594, -0.1474437875, 12.78001173 }, { 0.4691993002, -0.1183798326, 12.93501779 }, { 0.4494765457, -0.09001397227, 13.10953999 },
+                { 0.4297733107, -0.06245933159, 13.30448113 }, { 0.4101678464, -0.03582313268, 13.5208396 }, { 0.3907360157, -0.01020583398, 13.75971738 },
+                { 0.3715506991, 0.01429966458, 14.02232884 }, { 0.3526807904, 0.03760919309, 14.3100101 }, { 0.3341927878, 0.05964580424, 14.62423096 },
+                { 0.3161463887, 0.08034430603, 14.9666046 }, { 0.298597535, 0.09964820338, 15.33890207 }, { 0.2815969384, 0.1175112205, 15.74306405 },
+                { 0.265188693, 0.1338982796, 16.18123035 }, { 0.2494123423, 0.1487839728, 16.65573212 }, { 0.2343004155, 0.162154174, 17.16913932 },
+                { 0.2198794483, 0.1740051131, 17.72427176 }, { 0.2061697568, 0.1843435011, 18.32421765 }, { 0.1931851653, 0.1931851653, 18.97242692 },
+                { 0.1809336595, 0.2005565796, 19.67262858 }, { 0.1694169649, 0.2064922579, 20.42899786 }, { 0.1586310796, 0.2110350184, 21.24615072 },
+                { 0.1485662956, 0.2142351611, 22.1292236 }, { 0.1392079153, 0.216149193, 23.08395497 }, { 0.1305362254, 0.2168392308, 24.11678851 },
+                { 0.122527097, 0.2163717722, 25.23500109 }, { NA, NA, NA },
+            },
+            // pos angle 110
+            {
+                { 0.5594897085, -0.2425784588, 12.66681849 }, { 0.5403649386, -0.2124810072, 12.77522258 }, { 0.5209161499, -0.1827202534, 12.90176248 },
+                { 0.5012253142, -0.1534213738, 13.04716689 }, { 0.4813746282, -0.1247064356, 13.21224903 }, { 0.4614458937, -0.09669344825, 13.39791403 },
+                { 0.4415198676, -0.06949541177, 13.60516695 }, { 0.4216756115, -0.04321939728, 13.83512163 }, { 0.4019898571, -0.01796567931, 14.08901052 },
+                { 0.3825364008, 0.006173065794, 14.36819549 }, { 0.3633855311, 0.02911248651, 14.67417993 }, { 0.3446034964, 0.0507771999, 15.0086221 },
+                { 0.3262518593, 0.07110151366, 15.37334976 }, { 0.3083878219, 0.09002906427, 15.77037903 }, { 0.2910623741, 0.1075147315, 16.20192967 },
+                { 0.2743213285, 0.1235234362, 16.67044975 }, { 0.2582044716, 0.1380308745, 17.17863929 }, { 0.2427454193, 0.151023467, 17.72947851 },
+                { 0.2279714985, 0.1624982248, 18.32626067 }, { 0.2139036804, 0.1724625075, 18.97263034 }, { 0.2005566678, 0.1809339585, 19.67260862 },
+                { 0.1879385242, 0.1879385242, 20.43074655 }, { 0.1760516911, 0.1935128375, 21.25198991 }, { 0.1648923083, 0.1977005096, 22.14195694 },
+                { 0.1544509913, 0.2005527275, 23.10693395 }, { 0.1447126449, 0.2021274328, 24.15401491 }, { 0.1356576599, 0.202487521, 25.29124713 },
+                { 0.1272614616, 0.2017005844, 26.52782097 }, { NA, NA, NA },
+            },
+            // pos angle 115
+            {
+                { 0.5708941355, -0.2467216608, 12.92148635 }, { 0.551631318, -0.2169635066, 13.03777352 }, { 0.5320259929, -0.1875468705, 13.17309456 },
+                { 0.5121595527, -0.1585957154, 13.328255 }, { 0.4921153567, -0.1302325529, 13.50415619 }, { 0.4719760554, -0.102575425, 13.70180345 },
+                { 0.4518231958, -0.07573721916, 13.92231586 }, { 0.4317366643, -0.04982484204, 14.16693689 }, { 0.4117940738, -0.0249383713, 14.43704609 },
+                { 0.3920701519, -0.001170248828, 14.73417232 }, { 0.3726361553, 0.02139545513, 15.06000864 }, { 0.3535593243, 0.04268369359, 15.41642907 },
+                { 0.334902381, 0.06262900259, 15.80550761 }, { 0.3167228391, 0.08117622582, 16.2295386 }, { 0.2990737646, 0.09827959209, 16.69106614 },
+                { 0.2820012008, 0.1139054117, 17.19290324 }, { 0.2655459775, 0.1280299316, 17.73817159 }, { 0.2497425889, 0.1406403096, 18.3303366 },
+                { 0.2346191405, 0.1517344053, 18.97325115 }, { 0.2201972947, 0.1613205075, 19.67120732 }, { 0.2064922587, 0.1694169641, 20.42899786 },
+                { 0.1935128375, 0.1760516911, 21.25198991 }, { 0.1812615574, 0.1812615574, 22.14621422 }, { 0.1697348536, 0.1850916545, 23.11847423 },
+                { 0.1589233207, 0.1875944545, 24.176481 }, { 0.1488121775, 0.1888287173, 25.32902106 }, { 0.1393807407, 0.1888593045, 26.58617188 },
+                { 0.1306045859, 0.1877543863, 27.95956754 }, { NA, NA, NA },
+            },
+            // pos angle 120
+            {
+                { 0.5809256517, -0.2500767118, 13.1882639 }, { 0.5615180374, -0.2206588647, 13.31299381 }, { 0.541748926, -0.191586421, 13.45772009 },
+                { 0.5217013367, -0.1629842988, 13.62333368 }, { 0.5014592967, -0.1349751923, 13.8108441 }, { 0.4811048194, -0.1076757393, 14.02137122 },
+                { 0.4607209359, -0.08119935194, 14.25616068 }, { 0.440388546, -0.05565289602, 14.51660018 }, { 0.4201861814, -0.03113624394, 14.80423456 },
+                { 0.4001895102, -0.007741580022, 15.12078164 }, { 0.3804707688, 0.014447324, 15.46815022 }, { 0.3610982048, 0.03535577236, 15.84846078 },
+                { 0.3421355595, 0.05491871649, 16.26406923 }, { 0.3236415994, 0.07308122455, 16.71759414 }, { 0.3056697026, 0.08979884414, 17.21194805 },
+                { 0.2882674619, 0.1050379075, 17.750373 }, { 0.271476588, 0.1187753949, 18.33648578 }, { 0.2553322807, 0.1309994815, 18.97432098 },
+                { 0.2398634581, 0.1417088947, 19.66839507 }, { 0.2250924583, 0.150912932, 20.42377292 }, { 0.2110350579, 0.1586310388, 21.2461508 },
+                { 0.1977005112, 0.1648923066, 22.14195694 }, { 0.1850916545, 0.1697348536, 23.11847423 }, { 0.1732050808, 0.1732050808, 24.18399152 },
+                { 0.1620313749, 0.1753568161, 25.3479925 }, { 0.1515554085, 0.176250352, 26.62139387 }, { 0.1417566337, 0.1759514358, 28.01684955 },
+                { 0.1326095275, 0.1745300814, 29.54914262 }, { 0.1240839028, 0.172059462, 31.23569911 },
+            },
+            // pos angle 125
+            {
+                { 0.5896300171, -0.2526697817, 13.46703729 }, { 0.5700708912, -0.2235917254, 13.60078598 }, { 0.5501319628, -0.1948636594, 13.75558095 },
+                { 0.529897198, -0.1666107861, 13.93240888 }, { 0.5094506846, -0.1389549803, 14.13238452 }, { 0.488876823, -0.1120142298, 14.35674641 },
+                { 0.4682583495, -0.08590104859, 14.60689673 }, { 0.4476764609, -0.06072164655, 14.88439042 }, { 0.4272112737, -0.03657626212, 15.19095647 },
+                { 0.4069395394, -0.01355687353, 15.52852454 }, { 0.3869344922, 0.008253083428, 15.89924809 }, { 0.3672653925, 0.02877929432, 16.30552927 },
+                { 0.3479970121, 0.04795714674, 16.75004798 }, { 0.3291891492, 0.06573221815, 17.2357959 }, { 0.310896195, 0.08206065015, 17.76611629 },
+                { 0.29316676, 0.09690940637, 18.34475046 }, { 0.2760433053, 0.1102564949, 18.97589089 }, { 0.2595621727, 0.1220905666, 19.66425237 },
+                { 0.2437528491, 0.1324116312, 20.41513517 }, { 0.2286384058, 0.1412299938, 21.23453002 }, { 0.2142351674, 0.1485662916, 22.12922346 },
+                { 0.2005528117, 0.1544509041, 23.10693415 }, { 0.187594458, 0.158923317, 24.17648102 }, { 0.1753568161, 0.1620313749, 25.3479925 },
+                { 0.1638304089, 0.1638304089, 26.63317 }, { 0.1529998486, 0.1643822569, 28.04562396 }, { 0.1428441712, 0.16375418, 29.60130762 },
+                { 0.1333371009, 0.162017793, 31.31908503 }, { 0.1244475922, 0.1592477003, 33.22148168 },
+            },
+            // pos angle 130
+            {
+                { 0.5970604606, -0.2545313125, 13.75762911 }, { 0.5773424127, -0.2257911575, 13.90102249 }, { 0.5572272279, -0.1974061081, 14.06658629 },
+                { 0.5367993571, -0.1695012856, 14.25541859 }, { 0.5161431854, -0.1421983308, 14.46876622 }, { 0.4953440418, -0.1156152379, 14.70800621 },
+                { 0.474485854, -0.08986454015, 14.97469413 }, { 0.4536512216, -0.06505275283, 15.27056829 }, { 0.4329206307, -0.04127942237, 15.59757312 },
+                { 0.412372191, -0.01863639426, 15.95787165 }, { 0.392079216, 0.002793415505, 16.35392711 }, { 0.3721128271, 0.02293576663, 16.78844391 },
+                { 0.3525388283, 0.04172653953, 17.26447372 }, { 0.3334180529, 0.05911185254, 17.78543981 }, { 0.3148059184, 0.07504846708, 18.35518645 },
+                { 0.2967520299, 0.089504065, 18.97803803 }, { 0.279299847, 0.102457396, 19.6588694 }, { 0.2624863368, 0.1138984335, 20.40318662 },
+                { 0.2463421711, 0.12382759, 21.21724262 }, { 0.2308908053, 0.1322568205, 22.10812901 }, { 0.2161492071, 0.139207909, 23.08395446 },
+                { 0.2021274465, 0.1447126367, 24.15401453 }, { 0.1888288961, 0.1488119924, 25.32902154 }, { 0.1762503597, 0.1515554002, 26.62139391 },
+                { 0.164382257, 0.1529998486, 28.04562396 }, { 0.1532088886, 0.1532088886, 29.61875186 }, { 0.142708745, 0.1522515342, 31.36098549 },
+                { 0.1328548777, 0.1502010501, 33.29652212 }, { 0.1236150516, 0.1471338893, 35.4546572 },
+            },
+            // pos angle 135
+            {
+                { NA, NA, NA }, { 0.5833916092, -0.2272894865, 14.21349244 }, { 0.5630935175, -0.1992451413, 14.39057613 },
+                { 0.5424657924, -0.1716858405, 14.59226869 }, { 0.5215944834, -0.1447338936, 14.81994604 }, { 0.5005654494, -0.1185071102, 15.07514937 },
+                { 0.4794631765, -0.09311778999, 15.35962293 }, { 0.4583717189, -0.06867256575, 15.6753032 }, { 0.4373730338, -0.04527103794, 16.02436451 },
+                { 0.4165441202, -0.02300386686, 16.40929531 }, { 0.3959621732, -0.001954826708, 16.8328109 }, { 0.3756984587, 0.01780274481, 17.29800067 },
+                { 0.3558189589, 0.03620515461, 17.8083867 }, { 0.3363863987, 0.05319897433, 18.36786088 }, { 0.3174572137, 0.06874164062, 18.98085087 },
+                { 0.2990820074, 0.08280158503, 19.6523651 }, { 0.281305196, 0.09535841937, 20.38808208 }, { 0.2641647156, 0.106402969, 21.1944591 },
+                { 0.2476916796, 0.1159374029, 22.07885712 }, { 0.2319108232, 0.123973824, 23.0497369 }, { 0.2168392393, 0.1305362247, 24.11678797 },
+                { 0.2024875517, 0.1356576478, 25.29124573 }, { 0.1888593338, 0.1393807242, 26.58617085 }, { 0.1759514474, 0.141756626, 28.01684921 },
+                { 0.1637541973, 0.1428441528, 29.60130773 }, { 0.1522515343, 0.1427087449, 31.36098549 }, { 0.1414213562, 0.1414213562, 33.32162204 },
+                { 0.1312358379, 0.1390572344, 35.51445402 }, { 0.1216618479, 0.1356945629, 37.97785251 },
+            },
+            // pos angle 140
+            {
+                { NA, NA, NA }, { NA, NA, NA }, { NA, NA, NA },
+                { 0.5469608434, -0.173197969, 14.94277252 }, { 0.5258681308, -0.1465937962, 15.18580617 }, { 0.5046034694, -0.1207204884, 15.45814676 },
+                { 0.4832527108, -0.09569044388, 15.76173148 }, { 0.4619005722, -0.07161004381, 16.09873889 }, { 0.4406293188, -0.04857838709, 16.47163088 },
+                { 0.4195191325, -0.02668692658, 16.88316553 }, { 0.3986464766, -0.006018253598, 17.33646153 }, { 0.3780839751, 0.01335437094, 17.83503604 },
+                { 0.3578997589, 0.0313676566, 18.38286393 }, { 0.338157311, 0.04796884046, 18.98442473 }, { 0.3189132732, 0.06311583162, 19.64487964 },
+                { 0.3002201191, 0.07677793028, 20.36999587 }, { 0.2821232054, 0.08893565143, 21.1664039 }, { 0.2646613588, 0.09958084716, 22.04169211 },
+                { 0.2478666261, 0.1087166265, 23.00457866 }, { 0.231764092, 0.1163571187, 24.06512488 }, { 0.2163717734, 0.122527104, 25.23500048 },
+                { 0.2017006023, 0.127261463, 26.5278194 }, { 0.1877544502, 0.1306045651, 27.95956375 }, { 0.1745301424, 0.1326094959, 29.5491398 },
+                { 0.1620178177, 0.1333370854, 31.31908405 }, { 0.1502010892, 0.1328548358, 33.29652245 }, { 0.1390572346, 0.1312358377, 35.51445402 },
+                { 0.1285575219, 0.1285575219, 38.01350424 }, { 0.1186675483, 0.1249003214, 40.84437224 },
+            },
+            // pos angle 145
+            {
+                { NA, NA, NA }, { NA, NA, NA }, { NA, NA, NA },
+                { NA, NA, NA }, { NA, NA, NA }, { NA, NA, NA },
+                { 0.485921884, -0.09761525254, 16.18098893 }, { 0.4643046704, -0.07389689892, 16.54095718 }, { 0.4427582575, -0.05123332834, 16.93953734 },
+                { 0.4213637335, -0.02971570772, 17.37985036 }, { 0.4001987214, -0.009426367032, 17.86543221 }, { 0.3793371607, 0.009561728979, 18.40028378 },
+                { 0.3588483472, 0.02718574047, 18.98895225 }, { 0.3387965841, 0.04339339045, 19.6366108 }, { 0.3192406568, 0.05814338718, 20.3491611 },
+                { 0.3002337554, 0.0714057914, 21.13333121 }, { 0.2818214029, 0.08316183975, 21.99694019 }, { 0.2640442208, 0.09340464288, 22.94886994 },
+                { 0.2469350375, 0.1021385195, 23.99947014 }, { 0.2305196425, 0.1093789875, 25.16077613 }, { 0.214816643, 0.1151523857, 26.4468647 },
+                { 0.1998373976, 0.1194953724, 27.87430549 }, { 0.1855860444, 0.1224541622, 29.46275167 }, { 0.1720595864, 0.1240838723, 31.23568921 },
+                { 0.1592478239, 0.1244475352, 33.22147387 }, { 0.1471339415, 0.1236150211, 35.45465436 }, { 0.135694654, 0.1216617503, 37.97785347 },
+                { 0.1249003219, 0.1186675478, 40.84437224 }, { 0.1147152873, 0.1147152873, 44.12188603 },
+            },
+            // pos angle 150
+            {
+                { NA, NA, NA }, { NA, NA, NA }, { NA, NA, NA },
+                { NA, NA, NA }, { NA, NA, NA }, { NA, NA, NA },
+                { NA, NA, NA }, { 0.4656546408, -0.07556701383, 17.00195212 }, { 0.4438296077, -0.05326887709, 17.42823471 },
+                { 0.4221479369, -0.03212275004, 17.89965685 }, { 0.4006892091, -0.01221126342, 18.42022182 }, { 0.3795274557, 0.006393443541, 18.9945216 },
+                { 0.3587343087, 0.02362846804, 19.62773638 }, { 0.338374984, 0.03944221566, 20.32583142 }, { 0.3185094807, 0.05379405108, 21.09564096 },
+                { 0.2991918036, 0.06665475567, 21.9450323 }, { 0.2804695586, 0.07800671501, 22.8830974 }, { 0.2623839542, 0.08784403101, 23.92036263 },
+                { 0.2449679069, 0.09617217894, 25.06921259 }, { 0.2282488339, 0.1030083047, 26.34402476 }, { 0.2122458757, 0.1083803703, 27.76185449 },
+                { 0.1969708237, 0.1123268557, 29.34296865 }, { 0.1824280857, 0.1148961518, 31.11164133 }, { 0.1686147054, 0.1161453528, 33.09726096 },
+                { 0.1555206232, 0.1161399977, 35.33567307 }, { 0.1431280485, 0.1149524851, 37.87129418 }, { 0.1314136621, 0.112660748, 40.75960578 },
+                { 0.1203463265, 0.1093475129, 44.07131549 }, { 0.1098894332, 0.1050982061, 47.89783552 },
+            },
+            // pos angle 155
+            {
+                { NA, NA, NA }, { NA, NA, NA }, { NA, NA, NA },
+                { NA, NA, NA }, { NA, NA, NA }, { NA, NA, NA },
+                { NA, NA, NA }, { NA, NA, NA }, { NA, NA, NA },
+                { 0.4219442615, -0.03394241426, 18.44282439 }, { 0.4001891113, -0.01440633414, 19.00132223 }, { 0.3787268427, 0.003816145261, 19.61849 },
+                { 0.3576295259, 0.02066282743, 20.30030119 }, { 0.3369638203, 0.03608254685, 21.05363388 }, { 0.3167912217, 0.05003523396, 21.88641096 },
+                { 0.2971669102, 0.06249248407, 22.80782211 }, { 0.2781396707, 0.07343763732, 23.82855838 }, { 0.2597514653, 0.0828658757, 24.96112225 },
+                { 0.2420371376, 0.09078415893, 26.22021593 }, { 0.2250244852, 0.09721103778, 27.62320896 }, { 0.2087326287, 0.1021761942, 29.19091206 },
+                { 0.1931746879, 0.105720147, 30.94815953 }, { 0.1783552542, 0.1078933594, 32.92514798 }, { 0.1642714448, 0.1087555401, 35.15883564 },
+                { 0.1509129727, 0.1083746677, 37.69498537 }, { 0.1382621116, 0.1068257702, 40.59105926 }, { 0.1262942525, 0.1041898907, 43.92019998 },
+                { 0.1149778012, 0.100552519, 47.77723421 }, { 0.1042746413, 0.09600222495, 52.28749434 },
+            },
+            // pos angle 160
+            {
+                { NA, NA, NA }, { NA, NA, NA }, { NA, NA, NA },
+                { NA, NA, NA }, { NA, NA, NA }, { NA, NA, NA },
+                { NA, NA, NA }, { NA, NA, NA }, { NA, NA, NA },
+                { NA, NA, NA }, { NA, NA, NA }, { 0.3770086013, 0.001794992539, 20.27290351 },
+                { 0.3556067677, 0.01825434033, 21.00775252 }, { 0.3346362872, 0.03327981703, 21.82159049 }, { 0.3141583802, 0.04683262383, 22.72368949 },
+                { 0.2942310644, 0.05888449544, 23.72475575 }, { 0.2749039061, 0.06941992375, 24.83741349 }, { 0.2562200445, 0.07843523484, 26.07652351 },
+                { 0.238215391, 0.08593874889, 27.45971157 }, { NA, NA, NA }, { NA, NA, NA },
+                { NA, NA, NA }, { NA, NA, NA }, { NA, NA, NA },
+                { NA, NA, NA }, { NA, NA, NA }, { NA, NA, NA },
+                { NA, NA, NA }, { NA, NA, NA },
+            },
+        };
+    }
+}